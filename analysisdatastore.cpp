@@ -0,0 +1,361 @@
+#include "binaryninjaapi.h"
+#include <array>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+using namespace BinaryNinja;
+using namespace std;
+
+
+namespace
+{
+	struct AnalysisDataEntry
+	{
+		const type_info* type;
+		shared_ptr<void> value;
+		AnalysisDataLifetime lifetime;
+	};
+
+	using AnalysisDataEntries = unordered_map<string, AnalysisDataEntry>;
+
+	struct FunctionAnalysisData
+	{
+		BNBinaryView* view;
+		AnalysisDataEntries entries;
+	};
+
+	struct FunctionAnalysisDataShard
+	{
+		mutex functionsMutex;
+		unordered_map<BNFunction*, FunctionAnalysisData> functions;
+	};
+
+	// Drops function entries when their function goes away or is about to be analyzed again
+	class AnalysisDataNotification : public BinaryDataNotification
+	{
+	  public:
+		AnalysisDataNotification() : BinaryDataNotification(FunctionRemoved | FunctionUpdateRequested) {}
+
+		virtual void OnAnalysisFunctionRemoved(BinaryView*, Function* func) override { AnalysisDataStore::Clear(func); }
+
+		virtual void OnAnalysisFunctionUpdateRequested(BinaryView*, Function* func) override
+		{
+			AnalysisDataStore::Invalidate(func);
+		}
+	};
+
+	struct ViewAnalysisData
+	{
+		mutex viewMutex;  // Guards everything below
+		AnalysisDataEntries entries;
+		unordered_set<BNFunction*> functions;
+		unique_ptr<AnalysisDataNotification> notification;
+	};
+
+	constexpr size_t FunctionShardCount = 64;
+}  // namespace
+
+
+// Only guards the map itself, the data of each view has its own lock
+static mutex g_viewDataMutex;
+static unordered_map<BNBinaryView*, shared_ptr<ViewAnalysisData>> g_viewData;
+static array<FunctionAnalysisDataShard, FunctionShardCount> g_functionData;
+
+
+static FunctionAnalysisDataShard& GetShard(BNFunction* func)
+{
+	return g_functionData[hash<BNFunction*>()(func) % FunctionShardCount];
+}
+
+
+static shared_ptr<ViewAnalysisData> FindViewData(BNBinaryView* view)
+{
+	unique_lock<mutex> lock(g_viewDataMutex);
+	auto i = g_viewData.find(view);
+	if (i == g_viewData.end())
+		return nullptr;
+	return i->second;
+}
+
+
+static void ForgetFunction(BNFunction* func)
+{
+	// Values are destroyed after the locks are released so their destructors can use the store
+	FunctionAnalysisData removed;
+	{
+		auto& shard = GetShard(func);
+		unique_lock<mutex> lock(shard.functionsMutex);
+		auto i = shard.functions.find(func);
+		if (i == shard.functions.end())
+			return;
+		removed = std::move(i->second);
+		shard.functions.erase(i);
+	}
+
+	if (shared_ptr<ViewAnalysisData> viewData = FindViewData(removed.view))
+	{
+		unique_lock<mutex> lock(viewData->viewMutex);
+		viewData->functions.erase(func);
+	}
+}
+
+
+static void DestructBinaryView(void*, BNBinaryView* view)
+{
+	shared_ptr<ViewAnalysisData> viewData;
+	{
+		unique_lock<mutex> lock(g_viewDataMutex);
+		auto i = g_viewData.find(view);
+		if (i == g_viewData.end())
+			return;
+		viewData = std::move(i->second);
+		g_viewData.erase(i);
+	}
+
+	AnalysisDataEntries entries;
+	unordered_set<BNFunction*> functions;
+	unique_ptr<AnalysisDataNotification> notification;
+	{
+		unique_lock<mutex> lock(viewData->viewMutex);
+		entries = std::move(viewData->entries);
+		functions = std::move(viewData->functions);
+		notification = std::move(viewData->notification);
+	}
+
+	if (notification)
+		BNUnregisterDataNotification(view, notification->GetCallbacks());
+	for (auto func : functions)
+		ForgetFunction(func);
+}
+
+
+static void DestructFunction(void*, BNFunction* func)
+{
+	ForgetFunction(func);
+}
+
+
+static shared_ptr<ViewAnalysisData> GetViewData(BNBinaryView* view)
+{
+	// The core keeps the pointer it is given, so register the static itself once it is filled in
+	static BNObjectDestructionCallbacks callbacks = []() {
+		BNObjectDestructionCallbacks result = {};
+		result.destructBinaryView = DestructBinaryView;
+		result.destructFunction = DestructFunction;
+		return result;
+	}();
+	static once_flag registered;
+	call_once(registered, []() { BNRegisterObjectDestructionCallbacks(&callbacks); });
+
+	unique_lock<mutex> lock(g_viewDataMutex);
+	shared_ptr<ViewAnalysisData>& viewData = g_viewData[view];
+	if (!viewData)
+		viewData = make_shared<ViewAnalysisData>();
+	return viewData;
+}
+
+
+// Makes sure the view of a function that is getting its first entry is tracked, so function entries can follow
+// the function's analysis and be found from the view
+static BNBinaryView* TrackFunction(BNFunction* func)
+{
+	BNBinaryView* view = BNGetFunctionData(func);
+	if (!view)
+		return nullptr;
+
+	shared_ptr<ViewAnalysisData> viewData = GetViewData(view);
+	AnalysisDataNotification* notification = nullptr;
+	{
+		unique_lock<mutex> lock(viewData->viewMutex);
+		viewData->functions.insert(func);
+		if (!viewData->notification)
+		{
+			viewData->notification = make_unique<AnalysisDataNotification>();
+			notification = viewData->notification.get();
+		}
+	}
+
+	// Registered without holding any of our locks, since the core calls the notification with its own lock held
+	// and the notification takes ours. The reference from BNGetFunctionData keeps the view alive until then.
+	if (notification)
+		BNRegisterDataNotification(view, notification->GetCallbacks());
+
+	// The view outlives its functions, and entries are keyed by the raw pointer
+	BNFreeBinaryView(view);
+	return view;
+}
+
+
+static shared_ptr<void> FindEntry(const AnalysisDataEntries& entries, const string& key, const type_info& type)
+{
+	auto i = entries.find(key);
+	if ((i == entries.end()) || (*i->second.type != type))
+		return nullptr;
+	return i->second.value;
+}
+
+
+shared_ptr<void> AnalysisDataStore::Find(BNBinaryView* view, BNFunction* func, const string& key, const type_info& type)
+{
+	if (func)
+	{
+		auto& shard = GetShard(func);
+		unique_lock<mutex> lock(shard.functionsMutex);
+		auto i = shard.functions.find(func);
+		if (i == shard.functions.end())
+			return nullptr;
+		return FindEntry(i->second.entries, key, type);
+	}
+
+	shared_ptr<ViewAnalysisData> viewData = FindViewData(view);
+	if (!viewData)
+		return nullptr;
+	unique_lock<mutex> lock(viewData->viewMutex);
+	return FindEntry(viewData->entries, key, type);
+}
+
+
+shared_ptr<void> AnalysisDataStore::FindOrAdd(BNBinaryView* view, BNFunction* func, const string& key,
+    const type_info& type, const function<shared_ptr<void>()>& create, AnalysisDataLifetime lifetime)
+{
+	if (shared_ptr<void> existing = Find(view, func, key, type))
+		return existing;
+
+	// Build the value without holding any lock, and keep whichever value made it in first
+	shared_ptr<void> value = create();
+	if (func)
+	{
+		BNBinaryView* funcView = TrackFunction(func);
+		auto& shard = GetShard(func);
+		unique_lock<mutex> lock(shard.functionsMutex);
+		FunctionAnalysisData& data = shard.functions[func];
+		data.view = funcView;
+		auto result = data.entries.emplace(key, AnalysisDataEntry {&type, value, lifetime});
+		if (*result.first->second.type != type)
+			return nullptr;
+		return result.first->second.value;
+	}
+
+	shared_ptr<ViewAnalysisData> viewData = GetViewData(view);
+	unique_lock<mutex> lock(viewData->viewMutex);
+	auto result = viewData->entries.emplace(key, AnalysisDataEntry {&type, value, lifetime});
+	if (*result.first->second.type != type)
+		return nullptr;
+	return result.first->second.value;
+}
+
+
+void AnalysisDataStore::Store(BNBinaryView* view, BNFunction* func, const string& key, const type_info& type,
+    shared_ptr<void> value, AnalysisDataLifetime lifetime)
+{
+	AnalysisDataEntry entry {&type, std::move(value), lifetime};
+	if (func)
+	{
+		BNBinaryView* funcView = TrackFunction(func);
+		auto& shard = GetShard(func);
+		unique_lock<mutex> lock(shard.functionsMutex);
+		FunctionAnalysisData& data = shard.functions[func];
+		data.view = funcView;
+		swap(data.entries[key], entry);
+		return;
+	}
+
+	shared_ptr<ViewAnalysisData> viewData = GetViewData(view);
+	unique_lock<mutex> lock(viewData->viewMutex);
+	swap(viewData->entries[key], entry);
+}
+
+
+bool AnalysisDataStore::Erase(BNBinaryView* view, BNFunction* func, const string& key)
+{
+	shared_ptr<void> removed;
+	if (func)
+	{
+		auto& shard = GetShard(func);
+		unique_lock<mutex> lock(shard.functionsMutex);
+		auto i = shard.functions.find(func);
+		if (i == shard.functions.end())
+			return false;
+		auto entry = i->second.entries.find(key);
+		if (entry == i->second.entries.end())
+			return false;
+		removed = std::move(entry->second.value);
+		i->second.entries.erase(entry);
+		return true;
+	}
+
+	shared_ptr<ViewAnalysisData> viewData = FindViewData(view);
+	if (!viewData)
+		return false;
+	unique_lock<mutex> lock(viewData->viewMutex);
+	auto entry = viewData->entries.find(key);
+	if (entry == viewData->entries.end())
+		return false;
+	removed = std::move(entry->second.value);
+	viewData->entries.erase(entry);
+	return true;
+}
+
+
+bool AnalysisDataStore::Remove(BinaryView* view, const string& key)
+{
+	return Erase(view->GetObject(), nullptr, key);
+}
+
+
+bool AnalysisDataStore::Remove(Function* func, const string& key)
+{
+	return Erase(nullptr, func->GetObject(), key);
+}
+
+
+void AnalysisDataStore::Invalidate(Function* func)
+{
+	vector<shared_ptr<void>> removed;
+	auto& shard = GetShard(func->GetObject());
+	unique_lock<mutex> lock(shard.functionsMutex);
+	auto i = shard.functions.find(func->GetObject());
+	if (i == shard.functions.end())
+		return;
+	auto& entries = i->second.entries;
+	for (auto entry = entries.begin(); entry != entries.end();)
+	{
+		if (entry->second.lifetime == DiscardAnalysisDataOnUpdate)
+		{
+			removed.push_back(std::move(entry->second.value));
+			entry = entries.erase(entry);
+		}
+		else
+		{
+			++entry;
+		}
+	}
+}
+
+
+void AnalysisDataStore::Clear(Function* func)
+{
+	ForgetFunction(func->GetObject());
+}
+
+
+void AnalysisDataStore::Clear(BinaryView* view)
+{
+	shared_ptr<ViewAnalysisData> viewData = FindViewData(view->GetObject());
+	if (!viewData)
+		return;
+
+	AnalysisDataEntries removed;
+	unordered_set<BNFunction*> functions;
+	{
+		unique_lock<mutex> lock(viewData->viewMutex);
+		removed = std::move(viewData->entries);
+		viewData->entries.clear();
+		functions = viewData->functions;
+	}
+
+	for (auto func : functions)
+		ForgetFunction(func);
+}
@@ -5,6 +5,7 @@
 #include <inttypes.h>
 #include <map>
 #include <array>
+#include <atomic>
 #include <stdio.h>
 #include <string.h>
 
@@ -261,6 +262,63 @@ static const char* GetRelocationString(ElfArm64RelocationType rel)
 }
 
 
+// Analysis asks for the info, text and IL of each instruction separately, and rendering asks for the text again, so
+// every thread keeps its most recent decodes around. Entries are direct mapped on the address and only used if both
+// the address and instruction word match, since decoding depends on both.
+static constexpr size_t DECODE_CACHE_SIZE = 256;
+static constexpr uint64_t DECODE_CACHE_STATS_INTERVAL = 0x1000;
+static constexpr uint64_t DECODE_CACHE_LOG_INTERVAL = 0x100000;
+
+static std::atomic<uint64_t> g_decodeCacheHits = 0;
+static std::atomic<uint64_t> g_decodeCacheMisses = 0;
+
+struct DecodeCacheEntry
+{
+	uint64_t addr;
+	uint32_t insword;
+	bool valid;
+	Instruction instr;
+};
+
+struct DecodeCache
+{
+	std::array<DecodeCacheEntry, DECODE_CACHE_SIZE> entries {};
+	// Counted locally and flushed to the globals every so often, so lookups don't contend on them
+	uint64_t hits = 0;
+	uint64_t misses = 0;
+
+	void CountLookup(bool hit)
+	{
+		if (hit)
+			hits++;
+		else
+			misses++;
+		if (hits + misses >= DECODE_CACHE_STATS_INTERVAL)
+			FlushStats();
+	}
+
+	void FlushStats(bool report = true)
+	{
+		uint64_t totalHits = g_decodeCacheHits.fetch_add(hits, std::memory_order_relaxed) + hits;
+		uint64_t totalMisses = g_decodeCacheMisses.fetch_add(misses, std::memory_order_relaxed) + misses;
+		uint64_t total = totalHits + totalMisses;
+		// Whichever flush crosses the interval reports the hit rate across all threads so far
+		if (report && total / DECODE_CACHE_LOG_INTERVAL != (total - hits - misses) / DECODE_CACHE_LOG_INTERVAL)
+		{
+			LogDebug("arm64 decode cache: %" PRIu64 " hits, %" PRIu64 " misses (%.1f%% hit rate)", totalHits,
+				totalMisses, 100.0 * totalHits / total);
+		}
+		hits = 0;
+		misses = 0;
+	}
+
+	// Threads can exit during shutdown, when the core may no longer accept log messages
+	~DecodeCache() { FlushStats(false); }
+};
+
+static thread_local DecodeCache g_decodeCache;
+
+
 class Arm64Architecture : public Architecture
 {
  protected:
@@ -277,8 +335,23 @@ class Arm64Architecture : public Architecture
 		if (m_onlyDisassembleOnAlignedAddresses && (addr % 4 != 0))
 			return false;
 
-		if (aarch64_decompose(*(uint32_t*)data, &result, addr) != 0)
+		uint32_t insword = *(uint32_t*)data;
+		DecodeCacheEntry& entry = g_decodeCache.entries[(addr >> 2) & (DECODE_CACHE_SIZE - 1)];
+		if (entry.valid && entry.addr == addr && entry.insword == insword)
+		{
+			g_decodeCache.CountLookup(true);
+			result = entry.instr;
+			return true;
+		}
+		g_decodeCache.CountLookup(false);
+
+		if (aarch64_decompose(insword, &result, addr) != 0)
 			return false;
+
+		entry.addr = addr;
+		entry.insword = insword;
+		entry.valid = true;
+		entry.instr = result;
 		return true;
 	}
 
@@ -783,6 +856,25 @@ class Arm64Architecture : public Architecture
 	}
 
 
+	virtual bool GetInstructionInfoBatch(
+	    const uint8_t* data, uint64_t addr, size_t len, vector<InstructionInfo>& result) override
+	{
+		// Fixed width instructions, so there's nothing to discover between one instruction and the next
+		result.clear();
+		result.reserve(len / 4);
+		for (size_t offset = 0; offset + 4 <= len; offset += 4)
+		{
+			Instruction instr;
+			if (!Disassemble(data + offset, addr + offset, len - offset, instr))
+				return false;
+
+			result.emplace_back();
+			SetInstructionInfoForInstruction(addr + offset, instr, result.back());
+		}
+		return (len % 4) == 0;
+	}
+
+
 	virtual bool GetInstructionText(const uint8_t* data, uint64_t addr, size_t& len,
 	    vector<InstructionTextToken>& result) override
 	{
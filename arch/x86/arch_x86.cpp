@@ -3,6 +3,8 @@
 #include <stdio.h>
 #include <string.h>
 #include <sstream>
+#include <algorithm>
+#include <array>
 #include "binaryninjaapi.h"
 #include "il.h"
 extern "C" {
@@ -411,23 +413,62 @@ static const char* GetRelocationString(Machox64RelocationType relocType)
 }
 
 
+// Info, text and lifting each decode the same instruction, and rendering decodes it again, so every thread keeps its
+// most recent decodes around. XED's output only depends on the machine mode and the instruction bytes, so entries are
+// keyed on those, not the address.
+static constexpr size_t DECODE_CACHE_SIZE = 256;
+
+struct DecodeCacheEntry
+{
+	size_t bits;
+	uint8_t length;
+	uint8_t bytes[XED_MAX_INSTRUCTION_BYTES];
+	xed_decoded_inst_t xedd;
+};
+
+static thread_local std::array<DecodeCacheEntry, DECODE_CACHE_SIZE> g_decodeCache {};
+
+
+static size_t DecodeCacheIndex(const uint8_t* data, size_t len)
+{
+	uint64_t key = 0;
+	memcpy(&key, data, std::min<size_t>(len, sizeof(key)));
+	return (size_t)((key * 0x9e3779b97f4a7c15ull) >> 56) & (DECODE_CACHE_SIZE - 1);
+}
+
+
 bool X86CommonArchitecture::Decode(const uint8_t* data, size_t len, xed_decoded_inst_t* xedd)
 {
-	// Zero out structure data, and keep the current destructuring mode (32/64/etc)
-	xed_decoded_inst_zero_keep_mode(xedd);
+	if (len == 0)
+		return false;
 
-	xed3_operand_set_cet(xedd, 1);
-	xed3_operand_set_mpxmode(xedd, 1);
+	DecodeCacheEntry& entry = g_decodeCache[DecodeCacheIndex(data, len)];
+	if (entry.length != 0 && entry.bits == m_bits && entry.length <= len && memcmp(entry.bytes, data, entry.length) == 0)
+	{
+		*xedd = entry.xedd;
+		// The decoded instruction points back at the bytes it was decoded from
+		xedd->_byte_array._dec = data;
+		return true;
+	}
+
+	// Start from the prepared state for our mode rather than zeroing and setting it up again
+	*xedd = m_decodeTemplate;
 
 	// Decode the data and check for errors
 	xed_error_enum_t xed_error = xed_decode(xedd, data, (unsigned)len);
 	switch(xed_error)
 	{
 	case XED_ERROR_NONE:
-		return true;
+		break;
 	default:
 		return false;
 	}
+
+	entry.bits = m_bits;
+	entry.length = (uint8_t)xed_decoded_inst_get_length(xedd);
+	memcpy(entry.bytes, data, entry.length);
+	entry.xedd = *xedd;
+	return true;
 }
 
 size_t X86CommonArchitecture::GetAddressSizeBits()  const
@@ -1914,6 +1955,26 @@ void X86CommonArchitecture::GetOperandText(const xed_decoded_inst_t* const xedd,
 
 X86CommonArchitecture::X86CommonArchitecture(const string& name, size_t bits): Architecture(name), m_bits(bits)
 {
+	// Prepared decoder state for this mode, copied for every decode
+	xed_decoded_inst_zero(&m_decodeTemplate);
+	switch (m_bits)
+	{
+	case 64:
+		xed_decoded_inst_set_mode(&m_decodeTemplate, XED_MACHINE_MODE_LONG_64, XED_ADDRESS_WIDTH_64b);
+		break;
+	case 32:
+		xed_decoded_inst_set_mode(&m_decodeTemplate, XED_MACHINE_MODE_LEGACY_32, XED_ADDRESS_WIDTH_32b);
+		break;
+	case 16:
+		xed_decoded_inst_set_mode(&m_decodeTemplate, XED_MACHINE_MODE_LEGACY_16, XED_ADDRESS_WIDTH_16b);
+		break;
+	default:
+		LogError("Invalid Processor Mode");
+		break;
+	}
+	xed3_operand_set_cet(&m_decodeTemplate, 1);
+	xed3_operand_set_mpxmode(&m_decodeTemplate, 1);
+
 	Ref<Settings> settings = Settings::Instance();
 	const bool lowercase = settings->Get<bool>("arch.x86.disassembly.lowercase");
 	const string flavor = settings->Get<string>("arch.x86.disassembly.syntax");
@@ -2005,21 +2066,6 @@ vector<uint32_t> X86CommonArchitecture::GetSystemRegisters()
 bool X86CommonArchitecture::GetInstructionInfo(const uint8_t* data, uint64_t addr, size_t maxLen, InstructionInfo& result)
 {
 	xed_decoded_inst_t xedd;
-	switch (m_bits)
-	{
-	case 64:
-		xed_decoded_inst_set_mode(&xedd, XED_MACHINE_MODE_LONG_64, XED_ADDRESS_WIDTH_64b);
-		break;
-	case 32:
-		xed_decoded_inst_set_mode(&xedd, XED_MACHINE_MODE_LEGACY_32, XED_ADDRESS_WIDTH_32b);
-		break;
-	case 16:
-		xed_decoded_inst_set_mode(&xedd, XED_MACHINE_MODE_LEGACY_16, XED_ADDRESS_WIDTH_16b);
-		break;
-	default:
-		LogError("Invalid Processor Mode");
-		return false;
-	}
 	if (!Decode(data, maxLen, &xedd))
 		return false;
 
@@ -2028,25 +2074,28 @@ bool X86CommonArchitecture::GetInstructionInfo(const uint8_t* data, uint64_t add
 }
 
 
-bool X86CommonArchitecture::GetInstructionText(const uint8_t* data, uint64_t addr, size_t& len, vector<InstructionTextToken>& result)
+bool X86CommonArchitecture::GetInstructionInfoBatch(const uint8_t* data, uint64_t addr, size_t len, vector<InstructionInfo>& result)
 {
+	result.clear();
+
 	xed_decoded_inst_t xedd;
-	switch (m_bits)
+	size_t offset = 0;
+	while (offset < len)
 	{
-	case 64:
-		xed_decoded_inst_set_mode(&xedd, XED_MACHINE_MODE_LONG_64, XED_ADDRESS_WIDTH_64b);
-		break;
-	case 32:
-		xed_decoded_inst_set_mode(&xedd, XED_MACHINE_MODE_LEGACY_32, XED_ADDRESS_WIDTH_32b);
-		break;
-	case 16:
-		xed_decoded_inst_set_mode(&xedd, XED_MACHINE_MODE_LEGACY_16, XED_ADDRESS_WIDTH_16b);
-		break;
-	default:
-		LogError("Invalid Processor Mode");
-		return false;
+		if (!Decode(data + offset, len - offset, &xedd))
+			return false;
+
+		result.emplace_back();
+		SetInstructionInfoForInstruction(addr + offset, result.back(), &xedd);
+		offset += result.back().length;
 	}
+	return true;
+}
 
+
+bool X86CommonArchitecture::GetInstructionText(const uint8_t* data, uint64_t addr, size_t& len, vector<InstructionTextToken>& result)
+{
+	xed_decoded_inst_t xedd;
 	if (Decode(data, len, &xedd))
 	{
 		len = xed_decoded_inst_get_length(&xedd);
@@ -2075,21 +2124,6 @@ bool X86CommonArchitecture::GetInstructionText(const uint8_t* data, uint64_t add
 bool X86CommonArchitecture::GetInstructionLowLevelIL(const uint8_t* data, uint64_t addr, size_t& len, LowLevelILFunction& il)
 {
 	xed_decoded_inst_t xedd;
-	switch (m_bits)
-	{
-	case 64:
-		xed_decoded_inst_set_mode(&xedd, XED_MACHINE_MODE_LONG_64, XED_ADDRESS_WIDTH_64b);
-		break;
-	case 32:
-		xed_decoded_inst_set_mode(&xedd, XED_MACHINE_MODE_LEGACY_32, XED_ADDRESS_WIDTH_32b);
-		break;
-	case 16:
-		xed_decoded_inst_set_mode(&xedd, XED_MACHINE_MODE_LEGACY_16, XED_ADDRESS_WIDTH_16b);
-		break;
-	default:
-		LogError("Invalid Processor Mode");
-		return false;
-	}
 	if (!Decode(data, len, &xedd))
 	{
 		il.AddInstruction(il.Undefined());
@@ -2662,22 +2696,6 @@ bool X86CommonArchitecture::Assemble(const string& code, uint64_t addr, DataBuff
 bool X86CommonArchitecture::IsNeverBranchPatchAvailable(const uint8_t* data, uint64_t, size_t len)
 {
 	xed_decoded_inst_t xedd;
-	switch (m_bits)
-	{
-	case 64:
-		xed_decoded_inst_set_mode(&xedd, XED_MACHINE_MODE_LONG_64, XED_ADDRESS_WIDTH_64b);
-		break;
-	case 32:
-		xed_decoded_inst_set_mode(&xedd, XED_MACHINE_MODE_LEGACY_32, XED_ADDRESS_WIDTH_32b);
-		break;
-	case 16:
-		xed_decoded_inst_set_mode(&xedd, XED_MACHINE_MODE_LEGACY_16, XED_ADDRESS_WIDTH_16b);
-		break;
-	default:
-		LogError("Invalid Processor Mode");
-		return false;
-	}
-
 	if (!Decode(data, len, &xedd))
 		return false;
 	return IsConditionalJump(&xedd);
@@ -2686,21 +2704,6 @@ bool X86CommonArchitecture::IsNeverBranchPatchAvailable(const uint8_t* data, uin
 bool X86CommonArchitecture::IsAlwaysBranchPatchAvailable(const uint8_t* data, uint64_t, size_t len)
 {
 	xed_decoded_inst_t xedd;
-	switch (m_bits)
-	{
-	case 64:
-		xed_decoded_inst_set_mode(&xedd, XED_MACHINE_MODE_LONG_64, XED_ADDRESS_WIDTH_64b);
-		break;
-	case 32:
-		xed_decoded_inst_set_mode(&xedd, XED_MACHINE_MODE_LEGACY_32, XED_ADDRESS_WIDTH_32b);
-		break;
-	case 16:
-		xed_decoded_inst_set_mode(&xedd, XED_MACHINE_MODE_LEGACY_16, XED_ADDRESS_WIDTH_16b);
-		break;
-	default:
-		LogError("Invalid Processor Mode");
-		return false;
-	}
 	if (!Decode(data, len, &xedd))
 		return false;
 	return IsConditionalJump(&xedd);
@@ -2709,21 +2712,6 @@ bool X86CommonArchitecture::IsAlwaysBranchPatchAvailable(const uint8_t* data, ui
 bool X86CommonArchitecture::IsInvertBranchPatchAvailable(const uint8_t* data, uint64_t, size_t len)
 {
 	xed_decoded_inst_t xedd;
-	switch (m_bits)
-	{
-	case 64:
-		xed_decoded_inst_set_mode(&xedd, XED_MACHINE_MODE_LONG_64, XED_ADDRESS_WIDTH_64b);
-		break;
-	case 32:
-		xed_decoded_inst_set_mode(&xedd, XED_MACHINE_MODE_LEGACY_32, XED_ADDRESS_WIDTH_32b);
-		break;
-	case 16:
-		xed_decoded_inst_set_mode(&xedd, XED_MACHINE_MODE_LEGACY_16, XED_ADDRESS_WIDTH_16b);
-		break;
-	default:
-		LogError("Invalid Processor Mode");
-		return false;
-	}
 	if (!Decode(data, len, &xedd))
 		return false;
 	return IsConditionalJump(&xedd);
@@ -2732,21 +2720,6 @@ bool X86CommonArchitecture::IsInvertBranchPatchAvailable(const uint8_t* data, ui
 bool X86CommonArchitecture::IsSkipAndReturnZeroPatchAvailable(const uint8_t* data, uint64_t, size_t len)
 {
 	xed_decoded_inst_t xedd;
-	switch (m_bits)
-	{
-	case 64:
-		xed_decoded_inst_set_mode(&xedd, XED_MACHINE_MODE_LONG_64, XED_ADDRESS_WIDTH_64b);
-		break;
-	case 32:
-		xed_decoded_inst_set_mode(&xedd, XED_MACHINE_MODE_LEGACY_32, XED_ADDRESS_WIDTH_32b);
-		break;
-	case 16:
-		xed_decoded_inst_set_mode(&xedd, XED_MACHINE_MODE_LEGACY_16, XED_ADDRESS_WIDTH_16b);
-		break;
-	default:
-		LogError("Invalid Processor Mode");
-		return false;
-	}
 	if (!Decode(data, len, &xedd))
 		return false;
 	return xed_decoded_inst_get_category(&xedd) == XED_CATEGORY_CALL;
@@ -2755,21 +2728,6 @@ bool X86CommonArchitecture::IsSkipAndReturnZeroPatchAvailable(const uint8_t* dat
 bool X86CommonArchitecture::IsSkipAndReturnValuePatchAvailable(const uint8_t* data, uint64_t, size_t len)
 {
 	xed_decoded_inst_t xedd;
-	switch (m_bits)
-	{
-	case 64:
-		xed_decoded_inst_set_mode(&xedd, XED_MACHINE_MODE_LONG_64, XED_ADDRESS_WIDTH_64b);
-		break;
-	case 32:
-		xed_decoded_inst_set_mode(&xedd, XED_MACHINE_MODE_LEGACY_32, XED_ADDRESS_WIDTH_32b);
-		break;
-	case 16:
-		xed_decoded_inst_set_mode(&xedd, XED_MACHINE_MODE_LEGACY_16, XED_ADDRESS_WIDTH_16b);
-		break;
-	default:
-		LogError("Invalid Processor Mode");
-		return false;
-	}
 	if (!Decode(data, len, &xedd))
 		return false;
 	return (xed_decoded_inst_get_category(&xedd) == XED_CATEGORY_CALL) && (xed_decoded_inst_get_length(&xedd) >= 5);
@@ -23,6 +23,8 @@ class X86CommonArchitecture: public Architecture
 protected:
 	const size_t m_bits;
 	DISASSEMBLY_OPTIONS m_disassembly_options;
+	// Decoder state with the machine mode and options for this architecture already set up
+	xed_decoded_inst_t m_decodeTemplate;
 
 	bool Decode(const uint8_t* data, size_t len, xed_decoded_inst_t* xedd);
 
@@ -56,6 +58,7 @@ public:
 	virtual vector<uint32_t> GetGlobalRegisters() override;
 	virtual vector<uint32_t> GetSystemRegisters() override;
 	virtual bool GetInstructionInfo(const uint8_t* data, uint64_t addr, size_t maxLen, InstructionInfo& result) override;
+	virtual bool GetInstructionInfoBatch(const uint8_t* data, uint64_t addr, size_t len, vector<InstructionInfo>& result) override;
 	virtual bool GetInstructionText(const uint8_t* data, uint64_t addr, size_t& len, vector<InstructionTextToken>& result) override;
 
     virtual bool GetInstructionLowLevelIL(const uint8_t* data, uint64_t addr, size_t& len, LowLevelILFunction& il) override;
@@ -917,6 +917,23 @@ Ref<Architecture> Architecture::GetAssociatedArchitectureByAddress(uint64_t&)
 }
 
 
+bool Architecture::GetInstructionInfoBatch(
+    const uint8_t* data, uint64_t addr, size_t len, vector<InstructionInfo>& result)
+{
+	result.clear();
+	size_t offset = 0;
+	while (offset < len)
+	{
+		InstructionInfo info;
+		if (!GetInstructionInfo(data + offset, addr + offset, len - offset, info) || info.length == 0)
+			return false;
+		offset += info.length;
+		result.push_back(info);
+	}
+	return true;
+}
+
+
 bool Architecture::GetInstructionLowLevelIL(const uint8_t*, uint64_t, size_t&, LowLevelILFunction& il)
 {
 	il.AddInstruction(il.Undefined());
@@ -1465,6 +1482,23 @@ bool CoreArchitecture::GetInstructionInfo(const uint8_t* data, uint64_t addr, si
 }
 
 
+bool CoreArchitecture::GetInstructionInfoBatch(
+    const uint8_t* data, uint64_t addr, size_t len, vector<InstructionInfo>& result)
+{
+	result.clear();
+	size_t offset = 0;
+	while (offset < len)
+	{
+		InstructionInfo info;
+		if (!BNGetInstructionInfo(m_object, data + offset, addr + offset, len - offset, &info) || info.length == 0)
+			return false;
+		offset += info.length;
+		result.push_back(info);
+	}
+	return true;
+}
+
+
 bool CoreArchitecture::GetInstructionText(
     const uint8_t* data, uint64_t addr, size_t& len, std::vector<InstructionTextToken>& result)
 {
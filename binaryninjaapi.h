@@ -27,6 +27,7 @@
 #endif
 #include <cstddef>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
 #include <unordered_map>
@@ -44,6 +45,7 @@
 #include <optional>
 #include <memory>
 #include <any>
+#include <algorithm>
 #include "binaryninjacore.h"
 #include "exceptions.h"
 #include "json/json.h"
@@ -1634,6 +1636,20 @@ namespace BinaryNinja {
 	bool DemangleMS(Architecture* arch, const std::string& mangledName, Ref<Type>& outType, QualifiedName& outVarName,
 		BinaryView* view);
 
+	/*! Demangles a Microsoft Visual Studio C++ name using a platform's architecture and calling conventions
+
+	    \param[in] platform Platform for the symbol. Required for pointer and integer sizes and calling conventions.
+	    \param[in] mangledName a mangled Microsoft Visual Studio C++ name
+	    \param[out] outType Reference to Type to output
+	    \param[out] outVarName QualifiedName reference to write the output name to.
+	    \param[in] simplify Whether to simplify demangled names.
+	    \return True if the name was demangled and written to the out* parameters
+
+	    \ingroup demangle
+	*/
+	bool DemangleMSPlatform(Ref<Platform> platform, const std::string& mangledName, Ref<Type>& outType,
+		QualifiedName& outVarName, const bool simplify = false);
+
 	/*! Demangles a GNU3 name
 
 	    \param[in] arch Architecture for the symbol. Required for pointer and integer sizes.
@@ -3723,6 +3739,111 @@ namespace BinaryNinja {
 		}
 	};
 
+	/*! Changes accumulated by a BatchedBinaryDataNotification since its previous batch
+
+		Repeated events for the same function, data variable, symbol or type are coalesced into one: an object that
+		was added and then updated is only reported as added, one that was added and then removed is not reported at
+		all, and one that was removed and added again is reported as updated. Data changes keep the order they
+		happened in, since the offsets of each one refer to the view as left by the ones before it; only
+		consecutive adjacent writes are merged.
+
+		\ingroup binaryview
+	*/
+	struct BinaryDataNotificationBatch
+	{
+		enum DataChangeType
+		{
+			DataWritten,
+			DataInserted,
+			DataRemoved
+		};
+
+		struct DataChange
+		{
+			DataChangeType type;
+			uint64_t offset;
+			uint64_t length;
+		};
+
+		std::vector<DataChange> dataChanges;
+		std::vector<Ref<Function>> functionsAdded;
+		std::vector<Ref<Function>> functionsRemoved;
+		std::vector<Ref<Function>> functionsUpdated;
+		std::vector<DataVariable> dataVariablesAdded;
+		std::vector<DataVariable> dataVariablesRemoved;
+		std::vector<DataVariable> dataVariablesUpdated;
+		std::vector<Ref<Symbol>> symbolsAdded;
+		std::vector<Ref<Symbol>> symbolsRemoved;
+		std::vector<Ref<Symbol>> symbolsUpdated;
+		std::vector<QualifiedName> typesDefined;
+		std::vector<QualifiedName> typesUndefined;
+		std::vector<QualifiedName> typesUpdated;
+
+		bool IsEmpty() const;
+	};
+
+	/*! A BinaryDataNotification that delivers data, function, data variable, symbol and type changes in batches
+
+		The selected notifications of those kinds are queued as they arrive, without creating API objects for
+		repeated events, and handed to OnBatch from the NotificationBarrier that follows. While changes keep
+		arriving the core raises that barrier every `intervalMs` milliseconds; once a barrier finds nothing queued
+		the next change is delivered right away. All other selected notifications keep going to their usual
+		per-event callbacks, and OnNotificationBarrier is still called if NotificationBarrier was selected.
+
+		\ingroup binaryview
+	*/
+	class BatchedBinaryDataNotification : public BinaryDataNotification
+	{
+		struct PendingChanges;
+
+		std::mutex m_mutex;
+		std::unique_ptr<PendingChanges> m_pending;
+		uint64_t m_intervalMs;
+		bool m_userBarrier;
+
+		static uint64_t BatchNotificationBarrierCallback(void* ctxt, BNBinaryView* object);
+		static void BatchDataWrittenCallback(void* ctxt, BNBinaryView* data, uint64_t offset, size_t len);
+		static void BatchDataInsertedCallback(void* ctxt, BNBinaryView* data, uint64_t offset, size_t len);
+		static void BatchDataRemovedCallback(void* ctxt, BNBinaryView* data, uint64_t offset, uint64_t len);
+		static void BatchFunctionAddedCallback(void* ctxt, BNBinaryView* data, BNFunction* func);
+		static void BatchFunctionRemovedCallback(void* ctxt, BNBinaryView* data, BNFunction* func);
+		static void BatchFunctionUpdatedCallback(void* ctxt, BNBinaryView* data, BNFunction* func);
+		static void BatchDataVariableAddedCallback(void* ctxt, BNBinaryView* data, BNDataVariable* var);
+		static void BatchDataVariableRemovedCallback(void* ctxt, BNBinaryView* data, BNDataVariable* var);
+		static void BatchDataVariableUpdatedCallback(void* ctxt, BNBinaryView* data, BNDataVariable* var);
+		static void BatchSymbolAddedCallback(void* ctxt, BNBinaryView* data, BNSymbol* sym);
+		static void BatchSymbolRemovedCallback(void* ctxt, BNBinaryView* data, BNSymbol* sym);
+		static void BatchSymbolUpdatedCallback(void* ctxt, BNBinaryView* data, BNSymbol* sym);
+		static void BatchTypeDefinedCallback(void* ctxt, BNBinaryView* data, BNQualifiedName* name, BNType* type);
+		static void BatchTypeUndefinedCallback(
+		    void* ctxt, BNBinaryView* data, BNQualifiedName* name, BNType* type);
+		static void BatchTypeReferenceChangedCallback(
+		    void* ctxt, BNBinaryView* data, BNQualifiedName* name, BNType* type);
+
+		BinaryDataNotificationBatch TakeBatch();
+
+	  public:
+		BatchedBinaryDataNotification(NotificationTypes notifications, uint64_t intervalMs = 250);
+		virtual ~BatchedBinaryDataNotification();
+
+		/*! Deliver everything queued so far to OnBatch without waiting for the next NotificationBarrier
+
+			\param view BinaryView the notification is registered with
+		*/
+		void Flush(BinaryView* view);
+
+		/*! Called with the changes queued since the previous batch. Never called with an empty batch.
+
+			\param view BinaryView the changes were made in
+			\param batch The coalesced changes
+		*/
+		virtual void OnBatch(BinaryView* view, const BinaryDataNotificationBatch& batch)
+		{
+			(void)view;
+			(void)batch;
+		}
+	};
+
 	/*!
 		\ingroup fileaccessor
 	*/
@@ -7294,6 +7415,67 @@ namespace BinaryNinja {
 		template <typename T>
 		std::vector<T> ReadVector(size_t count);
 
+		/*! Read a structure from the current cursor position with a single read, decoding each field with the
+			reader's endianness.
+
+			The structure is described by pointers to its members, in the order they appear in the data, e.g.
+			`reader.ReadStruct<Header>(&Header::magic, &Header::size)`. Fields are packed back to back in the data
+			regardless of the layout of `T`, and must be integers or enums.
+
+		    \throws ReadException
+			\param fields Members of `T` to fill, in the order they appear in the data
+			\return The read structure, with any members not listed value-initialized
+		*/
+		template <typename T, typename... Fields>
+		T ReadStruct(Fields T::*... fields)
+		{
+			constexpr size_t recordSize = (sizeof(Fields) + ... + 0);
+			static_assert(recordSize != 0, "ReadStruct needs at least one field");
+			uint8_t buffer[recordSize];
+			Read(buffer, recordSize);
+			T result {};
+			DecodeFields(buffer, GetEndianness(), result, fields...);
+			return result;
+		}
+
+		/*! Read `count` integers from the current cursor position with a single read, decoding each with the
+			reader's endianness.
+
+		    \throws ReadException
+			\param count Number of values to read
+			\return The values that were read
+		*/
+		template <typename T>
+		std::vector<T> ReadArray(size_t count)
+		{
+			static_assert(std::is_integral_v<T> || std::is_enum_v<T>, "ReadArray needs integers, or a field list");
+			std::vector<T> result;
+			ReadRecords(count, sizeof(T), [&](const uint8_t* record, BNEndianness endian) {
+				result.push_back(DecodeValue<T>(record, endian));
+			});
+			return result;
+		}
+
+		/*! Read `count` consecutive structures from the current cursor position, as described for ReadStruct.
+
+		    \throws ReadException
+			\param count Number of structures to read
+			\param fields Members of `T` to fill, in the order they appear in the data
+			\return The structures that were read
+		*/
+		template <typename T, typename... Fields>
+		std::vector<T> ReadArray(size_t count, Fields T::*... fields)
+		{
+			constexpr size_t recordSize = (sizeof(Fields) + ... + 0);
+			static_assert(recordSize != 0, "ReadArray needs at least one field");
+			std::vector<T> result;
+			ReadRecords(count, recordSize, [&](const uint8_t* record, BNEndianness endian) {
+				T& item = result.emplace_back();
+				DecodeFields(record, endian, item, fields...);
+			});
+			return result;
+		}
+
 		/*! Read a string of fixed length from the current cursor position
 
 		    \throws ReadException
@@ -7410,6 +7592,56 @@ namespace BinaryNinja {
 		*/
 		uint64_t ReadBEPointer();
 
+	  private:
+		template <typename T>
+		static T DecodeValue(const uint8_t* data, BNEndianness endian)
+		{
+			static_assert(std::is_integral_v<T> || std::is_enum_v<T>, "Only integer and enum fields can be decoded");
+			// Assembled byte by byte so it doesn't matter what the host byte order is
+			uint64_t value = 0;
+			if (endian == LittleEndian)
+			{
+				for (size_t i = sizeof(T); i > 0; i--)
+					value = (value << 8) | data[i - 1];
+			}
+			else
+			{
+				for (size_t i = 0; i < sizeof(T); i++)
+					value = (value << 8) | data[i];
+			}
+			return (T)value;
+		}
+
+		template <typename T, typename... Fields>
+		static void DecodeFields(const uint8_t* data, BNEndianness endian, T& result, Fields T::*... fields)
+		{
+			size_t offset = 0;
+			((result.*fields = DecodeValue<Fields>(data + offset, endian), offset += sizeof(Fields)), ...);
+		}
+
+		// Reads count * recordSize bytes in large blocks and hands each record to decode, so huge (or bogus) counts
+		// don't allocate everything up front.
+		template <typename Func>
+		void ReadRecords(size_t count, size_t recordSize, Func&& decode)
+		{
+			if (count == 0)
+				return;
+			if (count > SIZE_MAX / recordSize)
+				throw ReadException();
+			BNEndianness endian = GetEndianness();
+			size_t recordsPerBlock = std::max<size_t>(1, 0x10000 / recordSize);
+			std::vector<uint8_t> buffer(std::min(count, recordsPerBlock) * recordSize);
+			for (size_t done = 0; done < count;)
+			{
+				size_t records = std::min(count - done, recordsPerBlock);
+				Read(buffer.data(), records * recordSize);
+				for (size_t i = 0; i < records; i++)
+					decode(buffer.data() + i * recordSize, endian);
+				done += records;
+			}
+		}
+
+	  public:
 		/*! Try reading a value, returning false whenever that read fails
 
 			\param dest Address to write the bytes to
@@ -8061,6 +8293,23 @@ namespace BinaryNinja {
 		*/
 		virtual bool GetInstructionInfo(const uint8_t* data, uint64_t addr, size_t maxLen, InstructionInfo& result) = 0;
 
+		/*! Retrieves InstructionInfo structs for consecutive instructions starting at the given virtual address
+
+			Decoding stops at the end of the data or at the first instruction that can't be decoded. The i-th entry
+			of `result` describes the instruction at `addr` plus the lengths of all entries before it.
+
+		 	\note The default implementation calls GetInstructionInfo for each instruction. Architecture subclasses
+					may override this with a faster implementation for linear sweeps.
+
+			\param[in] data pointer to the instruction data to retrieve info for
+		    \param[in] addr address of the first instruction
+			\param[in] len Length of the instruction data
+			\param[out] result Retrieved instruction info, one per instruction
+			\return Whether all of the instruction data was decoded
+		*/
+		virtual bool GetInstructionInfoBatch(
+		    const uint8_t* data, uint64_t addr, size_t len, std::vector<InstructionInfo>& result);
+
 		/*! Retrieves a list of InstructionTextTokens
 
 			\param[in] data pointer to the instruction data to retrieve text for
@@ -8473,6 +8722,8 @@ namespace BinaryNinja {
 		virtual Ref<Architecture> GetAssociatedArchitectureByAddress(uint64_t& addr) override;
 		virtual bool GetInstructionInfo(
 		    const uint8_t* data, uint64_t addr, size_t maxLen, InstructionInfo& result) override;
+		virtual bool GetInstructionInfoBatch(
+		    const uint8_t* data, uint64_t addr, size_t len, std::vector<InstructionInfo>& result) override;
 		virtual bool GetInstructionText(
 		    const uint8_t* data, uint64_t addr, size_t& len, std::vector<InstructionTextToken>& result) override;
 		virtual bool GetInstructionLowLevelIL(
@@ -9839,6 +10090,16 @@ namespace BinaryNinja {
 	overload(Ts...) -> overload<Ts...>;
 #endif
 
+	/*! How long an entry in the AnalysisDataStore stays around
+
+		\ingroup workflow
+	*/
+	enum AnalysisDataLifetime
+	{
+		KeepAnalysisData,            // Kept until it is removed or its function or view is destroyed
+		DiscardAnalysisDataOnUpdate  // Function entries are also dropped when an update of the function is requested
+	};
+
 	/*!
 		\ingroup workflow
 	*/
@@ -9846,7 +10107,6 @@ namespace BinaryNinja {
 	    public CoreRefCountObject<BNAnalysisContext, BNNewAnalysisContextReference, BNFreeAnalysisContext>
 	{
 		std::unique_ptr<Json::CharReader> m_reader;
-		Json::StreamWriterBuilder m_builder;
 
 	  public:
 		AnalysisContext(BNAnalysisContext* analysisContext);
@@ -9912,25 +10172,46 @@ namespace BinaryNinja {
 		*/
 		void SetHighLevelILFunction(Ref<HighLevelILFunction> highLevelIL);
 
+		/*! Get the AnalysisDataStore entry named `key` of the current function, creating it if needed
+
+			\param key Entry name, usually prefixed with the activity name
+			\param lifetime Whether the entry is dropped when an update of the function is requested
+			\return The entry, or nullptr if there is no current function
+		*/
+		template <typename T>
+		std::shared_ptr<T> GetFunctionData(const std::string& key, AnalysisDataLifetime lifetime = KeepAnalysisData);
+
+		/*! Get the AnalysisDataStore entry named `key` of the current view, creating it if needed
+
+			\param key Entry name, usually prefixed with the activity name
+			\return The entry, or nullptr if there is no current view
+		*/
+		template <typename T>
+		std::shared_ptr<T> GetBinaryViewData(const std::string& key);
+
 		bool Inform(const std::string& request);
 
 #if ((__cplusplus >= 201403L) || (_MSVC_LANG >= 201703L))
+		/*! One argument of an Inform request. Architectures are sent by name.
+		*/
+		using InformArgument = std::variant<std::string_view, uint64_t, Ref<Architecture>>;
+
+		/*! Send a request made of `count` typed arguments to the core
+
+			The request is encoded straight into a reused per-thread buffer, without building a Json::Value, so this
+			is cheap enough to call once per instruction.
+
+			\param args The request arguments, e.g. "directRefs", "insert", target, architecture, address
+			\param count Number of arguments
+			\return Whether the core accepted the request
+		*/
+		bool Inform(const InformArgument* args, size_t count);
+
 		template <typename... Args>
 		bool Inform(Args... args)
 		{
-			// using T = std::variant<Args...>; // FIXME: remove type duplicates
-			using T = std::variant<std::string, const char*, uint64_t, Ref<Architecture>>;
-			std::vector<T> unpackedArgs {args...};
-			Json::Value request(Json::arrayValue);
-			for (auto& arg : unpackedArgs)
-				std::visit(overload {[&](Ref<Architecture> arch) { request.append(Json::Value(arch->GetName())); },
-				               [&](uint64_t val) { request.append(Json::Value(val)); },
-				               [&](auto& val) {
-					               request.append(Json::Value(std::forward<decltype(val)>(val)));
-				               }},
-				    arg);
-
-			return Inform(Json::writeString(m_builder, request));
+			const InformArgument unpackedArgs[] {InformArgument(args)...};
+			return Inform(unpackedArgs, sizeof...(Args));
 		}
 #endif
 	};
@@ -11189,6 +11470,116 @@ namespace BinaryNinja {
 		void SetFunction(Function* func);
 	};
 
+	/*! Typed C++ objects attached to a BinaryView or Function by workflow activities, keyed by name
+
+		Entries are released when the object they are attached to is destroyed, and function entries are also released
+		when the function is removed from its view. Function entries are spread over independently locked shards, so
+		activities running on different functions don't contend with each other. An entry is only returned when
+		it is requested with the same type it was stored with.
+
+		\code{.cpp}
+		struct CallSites
+		{
+			std::mutex mutex;
+			std::set<uint64_t> addrs;
+		};
+		auto sites = AnalysisDataStore::GetOrCreate<CallSites>(func, "extension.functionInliner.callSites");
+		\endcode
+
+		\ingroup workflow
+	*/
+	class AnalysisDataStore
+	{
+		static std::shared_ptr<void> Find(
+		    BNBinaryView* view, BNFunction* func, const std::string& key, const std::type_info& type);
+		static std::shared_ptr<void> FindOrAdd(BNBinaryView* view, BNFunction* func, const std::string& key,
+		    const std::type_info& type, const std::function<std::shared_ptr<void>()>& create,
+		    AnalysisDataLifetime lifetime);
+		static void Store(BNBinaryView* view, BNFunction* func, const std::string& key, const std::type_info& type,
+		    std::shared_ptr<void> value, AnalysisDataLifetime lifetime);
+		static bool Erase(BNBinaryView* view, BNFunction* func, const std::string& key);
+
+	  public:
+		template <typename T>
+		static std::shared_ptr<T> Get(BinaryView* view, const std::string& key)
+		{
+			return std::static_pointer_cast<T>(Find(view->GetObject(), nullptr, key, typeid(T)));
+		}
+
+		template <typename T>
+		static std::shared_ptr<T> Get(Function* func, const std::string& key)
+		{
+			return std::static_pointer_cast<T>(Find(nullptr, func->GetObject(), key, typeid(T)));
+		}
+
+		/*! Get the entry named `key`, default constructing it first if there isn't one
+
+			Concurrent callers asking for the same missing entry all get the same object.
+		*/
+		template <typename T>
+		static std::shared_ptr<T> GetOrCreate(BinaryView* view, const std::string& key)
+		{
+			return std::static_pointer_cast<T>(FindOrAdd(view->GetObject(), nullptr, key, typeid(T),
+			    []() -> std::shared_ptr<void> { return std::make_shared<T>(); }, KeepAnalysisData));
+		}
+
+		template <typename T>
+		static std::shared_ptr<T> GetOrCreate(
+		    Function* func, const std::string& key, AnalysisDataLifetime lifetime = KeepAnalysisData)
+		{
+			return std::static_pointer_cast<T>(FindOrAdd(nullptr, func->GetObject(), key, typeid(T),
+			    []() -> std::shared_ptr<void> { return std::make_shared<T>(); }, lifetime));
+		}
+
+		template <typename T>
+		static void Set(BinaryView* view, const std::string& key, std::shared_ptr<T> value)
+		{
+			Store(view->GetObject(), nullptr, key, typeid(T), std::move(value), KeepAnalysisData);
+		}
+
+		template <typename T>
+		static void Set(Function* func, const std::string& key, std::shared_ptr<T> value,
+		    AnalysisDataLifetime lifetime = KeepAnalysisData)
+		{
+			Store(nullptr, func->GetObject(), key, typeid(T), std::move(value), lifetime);
+		}
+
+		static bool Remove(BinaryView* view, const std::string& key);
+		static bool Remove(Function* func, const std::string& key);
+
+		/*! Drop the entries of `func` stored with DiscardAnalysisDataOnUpdate
+
+			This happens automatically when an update of the function is requested.
+		*/
+		static void Invalidate(Function* func);
+
+		/*! Drop every entry of `func`
+		*/
+		static void Clear(Function* func);
+
+		/*! Drop every entry of `view`, including the entries of its functions
+		*/
+		static void Clear(BinaryView* view);
+	};
+
+	template <typename T>
+	std::shared_ptr<T> AnalysisContext::GetFunctionData(const std::string& key, AnalysisDataLifetime lifetime)
+	{
+		Ref<Function> func = GetFunction();
+		if (!func)
+			return nullptr;
+		return AnalysisDataStore::GetOrCreate<T>(func, key, lifetime);
+	}
+
+	template <typename T>
+	std::shared_ptr<T> AnalysisContext::GetBinaryViewData(const std::string& key)
+	{
+		Ref<BinaryView> view = GetBinaryView();
+		if (!view)
+			return nullptr;
+		return AnalysisDataStore::GetOrCreate<T>(view, key);
+	}
+
 	class FlowGraphNode;
 
 	/*!
@@ -11608,6 +11999,7 @@ namespace BinaryNinja {
 	};
 
 	struct LowLevelILInstruction;
+	class LowLevelILFunctionSnapshot;
 	struct RegisterOrFlag;
 	struct SSARegister;
 	struct SSARegisterStack;
@@ -12913,6 +13305,15 @@ namespace BinaryNinja {
 		size_t GetInstructionCount() const;
 		size_t GetExprCount() const;
 
+		/*! Copy every expression, operand list and SSA definition/use of this function out of the core at once
+
+			Use this for analyses that scan the whole function repeatedly; reading the snapshot never calls into the
+			core. The snapshot does not observe later changes to the function.
+
+			\return The snapshot, see LowLevelILFunctionSnapshot
+		*/
+		LowLevelILFunctionSnapshot Snapshot();
+
 		void UpdateInstructionOperand(size_t i, size_t operandIndex, ExprId value);
 		void ReplaceExpr(size_t expr, size_t newExpr);
 		void SetExprAttributes(size_t expr, uint32_t attributes);
@@ -13033,6 +13434,7 @@ namespace BinaryNinja {
 	};
 
 	struct MediumLevelILInstruction;
+	class MediumLevelILFunctionSnapshot;
 
 	/*!
 		\ingroup mediumlevelil
@@ -13288,6 +13690,12 @@ namespace BinaryNinja {
 		size_t GetInstructionCount() const;
 		size_t GetExprCount() const;
 
+		/*! Copy every expression, operand list and SSA definition/use of this function out of the core at once
+
+			\see LowLevelILFunction::Snapshot
+		*/
+		MediumLevelILFunctionSnapshot Snapshot();
+
 		void UpdateInstructionOperand(size_t i, size_t operandIndex, ExprId value);
 		void MarkInstructionForRemoval(size_t i);
 		void ReplaceInstruction(size_t i, ExprId expr);
@@ -13406,6 +13814,7 @@ namespace BinaryNinja {
 	};
 
 	struct HighLevelILInstruction;
+	class HighLevelILFunctionSnapshot;
 	class HighLevelILTokenEmitter;
 
 	/*!
@@ -13622,6 +14031,13 @@ namespace BinaryNinja {
 		size_t GetInstructionCount() const;
 		size_t GetExprCount() const;
 
+		/*! Copy every expression, operand list and SSA definition/use of this function out of the core at once
+
+			\see LowLevelILFunction::Snapshot
+			\param asFullAst Whether expressions are copied in their full AST form, as GetExpr does by default
+		*/
+		HighLevelILFunctionSnapshot Snapshot(bool asFullAst = true);
+
 		std::vector<Ref<BasicBlock>> GetBasicBlocks() const;
 		Ref<BasicBlock> GetBasicBlockForInstruction(size_t i) const;
 
@@ -18487,6 +18903,87 @@ namespace BinaryNinja {
 	};
 
 
+	/*! Result of demangling one name with DemangleBatch
+
+		\ingroup demangle
+	*/
+	struct DemangledName
+	{
+		bool success = false;
+		Ref<Type> type;
+		QualifiedName name;
+	};
+
+	/*! Demangle many names at once, with the same result as calling DemangleGeneric on each of them
+
+		Each distinct name is demangled once. Finding the demangler that claims each name, and demangling the names
+		claimed by the built-in GNU3 and MS demanglers, is spread over several threads, since those demanglers are
+		thread safe. Names claimed by any other demangler, such as one registered by a plugin, are demangled one at
+		a time on the calling thread.
+
+		\param[in] arch Architecture for the symbols. Required for pointer and integer sizes.
+		\param[in] mangledNames Names to demangle
+		\param[in] view (Optional) view of the binary containing the mangled names
+		\param[in] simplify (Optional) Whether to simplify demangled names.
+		\return One result per name, in the same order as mangledNames
+
+		\ingroup demangle
+	*/
+	std::vector<DemangledName> DemangleBatch(Ref<Architecture> arch, const std::vector<std::string>& mangledNames,
+		Ref<BinaryView> view = nullptr, const bool simplify = false);
+
+	/*! Remembers the results of DemangleGeneric for the names a loader demangles while it initializes a view
+
+		Loaders see the same mangled names in symbol tables, relocations and imports, so each distinct name is only
+		demangled once per architecture and simplify setting. Every result is kept until Clear is called, so keep
+		the cache for the duration of the loader's Init only. Safe to use from the symbol queue's worker threads.
+
+		\ingroup demangle
+	*/
+	class DemangleCache
+	{
+		// Names are split over independently locked shards so worker threads rarely wait on each other
+		struct Shard
+		{
+			std::mutex shardMutex;
+			std::map<std::pair<BNArchitecture*, bool>, std::unordered_map<std::string, DemangledName>> results;
+		};
+
+		static constexpr size_t ShardCount = 16;
+		Shard m_shards[ShardCount];
+
+	  public:
+		/*! Same as DemangleGeneric, but returns the remembered result for names that were seen before
+
+			\param[in] arch Architecture for the symbol. Required for pointer and integer sizes.
+			\param[in] mangledName a mangled name
+			\param[out] outType Pointer to Type to output
+			\param[out] outVarName QualifiedName reference to write the output name to.
+			\param[in] view (Optional) view of the mangled name
+			\param[in] simplify (Optional) Whether to simplify demangled names.
+			\return True if the name was demangled and written to the out* parameters
+		*/
+		bool Demangle(Ref<Architecture> arch, const std::string& mangledName, Ref<Type>& outType,
+			QualifiedName& outVarName, Ref<BinaryView> view = nullptr, bool simplify = false);
+
+		/*! Same as DemangleBatch, but only demangles the names that weren't seen before and remembers the results
+
+			Loaders call this with the names they have collected before processing their symbol queue, so the
+			queue's later calls to Demangle find every result already remembered.
+
+			\param[in] arch Architecture for the symbols. Required for pointer and integer sizes.
+			\param[in] mangledNames Names to demangle
+			\param[in] view (Optional) view of the binary containing the mangled names
+			\param[in] simplify (Optional) Whether to simplify demangled names.
+			\return One result per name, in the same order as mangledNames
+		*/
+		std::vector<DemangledName> DemangleBatch(Ref<Architecture> arch, const std::vector<std::string>& mangledNames,
+			Ref<BinaryView> view = nullptr, bool simplify = false);
+
+		//! Drops every remembered result
+		void Clear();
+	};
+
 	/*!
 		\ingroup demangler
 	*/
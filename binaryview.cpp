@@ -650,6 +650,346 @@ BinaryDataNotification::BinaryDataNotification(NotificationTypes notifications)
 }
 
 
+bool BinaryDataNotificationBatch::IsEmpty() const
+{
+	return dataChanges.empty() && functionsAdded.empty() && functionsRemoved.empty() && functionsUpdated.empty() && dataVariablesAdded.empty()
+	    && dataVariablesRemoved.empty() && dataVariablesUpdated.empty() && symbolsAdded.empty()
+	    && symbolsRemoved.empty() && symbolsUpdated.empty() && typesDefined.empty() && typesUndefined.empty()
+	    && typesUpdated.empty();
+}
+
+
+enum class BatchedChange
+{
+	Added,
+	Removed,
+	Updated
+};
+
+
+// Queued changes to one kind of object, keeping a single entry per object in the order objects were first seen
+template <typename Key, typename Value>
+class BatchedChangeSet
+{
+	struct Entry
+	{
+		Value value;
+		BatchedChange change;
+		bool live;
+	};
+
+	vector<Entry> m_entries;
+	map<Key, size_t> m_index;
+
+  public:
+	// makeValue is only called for objects that aren't queued yet, unless replace is set
+	template <typename MakeValue>
+	void Record(const Key& key, BatchedChange change, MakeValue&& makeValue, bool replace = false)
+	{
+		auto existing = m_index.find(key);
+		if (existing == m_index.end())
+		{
+			m_index.emplace(key, m_entries.size());
+			m_entries.push_back({makeValue(), change, true});
+			return;
+		}
+
+		Entry& entry = m_entries[existing->second];
+		if (replace)
+			entry.value = makeValue();
+		if (entry.change == BatchedChange::Added && change == BatchedChange::Removed)
+		{
+			// Never seen by the listener, so drop it altogether
+			entry.live = false;
+			m_index.erase(existing);
+		}
+		else if (entry.change == BatchedChange::Removed && change != BatchedChange::Removed)
+		{
+			entry.change = BatchedChange::Updated;
+		}
+		else if (entry.change == BatchedChange::Updated && change == BatchedChange::Removed)
+		{
+			entry.change = BatchedChange::Removed;
+		}
+	}
+
+	void Drain(vector<Value>& added, vector<Value>& removed, vector<Value>& updated)
+	{
+		for (auto& entry : m_entries)
+		{
+			if (!entry.live)
+				continue;
+			switch (entry.change)
+			{
+			case BatchedChange::Added:
+				added.push_back(std::move(entry.value));
+				break;
+			case BatchedChange::Removed:
+				removed.push_back(std::move(entry.value));
+				break;
+			default:
+				updated.push_back(std::move(entry.value));
+				break;
+			}
+		}
+		m_entries.clear();
+		m_index.clear();
+	}
+};
+
+
+struct BatchedBinaryDataNotification::PendingChanges
+{
+	vector<BinaryDataNotificationBatch::DataChange> dataChanges;
+	BatchedChangeSet<BNFunction*, Ref<Function>> functions;
+	BatchedChangeSet<uint64_t, DataVariable> dataVariables;
+	BatchedChangeSet<BNSymbol*, Ref<Symbol>> symbols;
+	BatchedChangeSet<QualifiedName, QualifiedName> types;
+};
+
+
+static BatchedBinaryDataNotification* GetBatchedNotification(void* ctxt)
+{
+	return static_cast<BatchedBinaryDataNotification*>((BinaryDataNotification*)ctxt);
+}
+
+
+static DataVariable GetDataVariable(BNDataVariable* var)
+{
+	return DataVariable(var->address,
+	    Confidence<Ref<Type>>(new Type(BNNewTypeReference(var->type)), var->typeConfidence), var->autoDiscovered);
+}
+
+
+uint64_t BatchedBinaryDataNotification::BatchNotificationBarrierCallback(void* ctxt, BNBinaryView* object)
+{
+	BatchedBinaryDataNotification* notify = GetBatchedNotification(ctxt);
+	Ref<BinaryView> view = new BinaryView(BNNewViewReference(object));
+	BinaryDataNotificationBatch batch = notify->TakeBatch();
+
+	// Keep the barrier coming while changes arrive, and let the next change after a quiet period wake it up again
+	uint64_t next = 0;
+	if (!batch.IsEmpty())
+	{
+		notify->OnBatch(view, batch);
+		next = notify->m_intervalMs;
+	}
+	if (notify->m_userBarrier)
+	{
+		uint64_t requested = notify->OnNotificationBarrier(view);
+		if (requested && (!next || requested < next))
+			next = requested;
+	}
+	return next;
+}
+
+
+void BatchedBinaryDataNotification::BatchDataWrittenCallback(void* ctxt, BNBinaryView*, uint64_t offset, size_t len)
+{
+	BatchedBinaryDataNotification* notify = GetBatchedNotification(ctxt);
+	lock_guard<mutex> lock(notify->m_mutex);
+	auto& changes = notify->m_pending->dataChanges;
+	if (!changes.empty() && changes.back().type == BinaryDataNotificationBatch::DataWritten
+	    && offset >= changes.back().offset && offset <= changes.back().offset + changes.back().length)
+	{
+		changes.back().length = max(changes.back().length, offset + len - changes.back().offset);
+		return;
+	}
+	changes.push_back({BinaryDataNotificationBatch::DataWritten, offset, len});
+}
+
+
+void BatchedBinaryDataNotification::BatchDataInsertedCallback(void* ctxt, BNBinaryView*, uint64_t offset, size_t len)
+{
+	BatchedBinaryDataNotification* notify = GetBatchedNotification(ctxt);
+	lock_guard<mutex> lock(notify->m_mutex);
+	notify->m_pending->dataChanges.push_back({BinaryDataNotificationBatch::DataInserted, offset, len});
+}
+
+
+void BatchedBinaryDataNotification::BatchDataRemovedCallback(void* ctxt, BNBinaryView*, uint64_t offset, uint64_t len)
+{
+	BatchedBinaryDataNotification* notify = GetBatchedNotification(ctxt);
+	lock_guard<mutex> lock(notify->m_mutex);
+	notify->m_pending->dataChanges.push_back({BinaryDataNotificationBatch::DataRemoved, offset, len});
+}
+
+
+void BatchedBinaryDataNotification::BatchFunctionAddedCallback(void* ctxt, BNBinaryView*, BNFunction* func)
+{
+	BatchedBinaryDataNotification* notify = GetBatchedNotification(ctxt);
+	lock_guard<mutex> lock(notify->m_mutex);
+	notify->m_pending->functions.Record(func, BatchedChange::Added,
+	    [&]() { return Ref<Function>(new Function(BNNewFunctionReference(func))); });
+}
+
+
+void BatchedBinaryDataNotification::BatchFunctionRemovedCallback(void* ctxt, BNBinaryView*, BNFunction* func)
+{
+	BatchedBinaryDataNotification* notify = GetBatchedNotification(ctxt);
+	lock_guard<mutex> lock(notify->m_mutex);
+	notify->m_pending->functions.Record(func, BatchedChange::Removed,
+	    [&]() { return Ref<Function>(new Function(BNNewFunctionReference(func))); });
+}
+
+
+void BatchedBinaryDataNotification::BatchFunctionUpdatedCallback(void* ctxt, BNBinaryView*, BNFunction* func)
+{
+	BatchedBinaryDataNotification* notify = GetBatchedNotification(ctxt);
+	lock_guard<mutex> lock(notify->m_mutex);
+	notify->m_pending->functions.Record(func, BatchedChange::Updated,
+	    [&]() { return Ref<Function>(new Function(BNNewFunctionReference(func))); });
+}
+
+
+void BatchedBinaryDataNotification::BatchDataVariableAddedCallback(void* ctxt, BNBinaryView*, BNDataVariable* var)
+{
+	BatchedBinaryDataNotification* notify = GetBatchedNotification(ctxt);
+	lock_guard<mutex> lock(notify->m_mutex);
+	notify->m_pending->dataVariables.Record(
+	    var->address, BatchedChange::Added, [&]() { return GetDataVariable(var); }, true);
+}
+
+
+void BatchedBinaryDataNotification::BatchDataVariableRemovedCallback(void* ctxt, BNBinaryView*, BNDataVariable* var)
+{
+	BatchedBinaryDataNotification* notify = GetBatchedNotification(ctxt);
+	lock_guard<mutex> lock(notify->m_mutex);
+	notify->m_pending->dataVariables.Record(
+	    var->address, BatchedChange::Removed, [&]() { return GetDataVariable(var); }, true);
+}
+
+
+void BatchedBinaryDataNotification::BatchDataVariableUpdatedCallback(void* ctxt, BNBinaryView*, BNDataVariable* var)
+{
+	BatchedBinaryDataNotification* notify = GetBatchedNotification(ctxt);
+	lock_guard<mutex> lock(notify->m_mutex);
+	notify->m_pending->dataVariables.Record(
+	    var->address, BatchedChange::Updated, [&]() { return GetDataVariable(var); }, true);
+}
+
+
+void BatchedBinaryDataNotification::BatchSymbolAddedCallback(void* ctxt, BNBinaryView*, BNSymbol* sym)
+{
+	BatchedBinaryDataNotification* notify = GetBatchedNotification(ctxt);
+	lock_guard<mutex> lock(notify->m_mutex);
+	notify->m_pending->symbols.Record(
+	    sym, BatchedChange::Added, [&]() { return Ref<Symbol>(new Symbol(BNNewSymbolReference(sym))); });
+}
+
+
+void BatchedBinaryDataNotification::BatchSymbolRemovedCallback(void* ctxt, BNBinaryView*, BNSymbol* sym)
+{
+	BatchedBinaryDataNotification* notify = GetBatchedNotification(ctxt);
+	lock_guard<mutex> lock(notify->m_mutex);
+	notify->m_pending->symbols.Record(
+	    sym, BatchedChange::Removed, [&]() { return Ref<Symbol>(new Symbol(BNNewSymbolReference(sym))); });
+}
+
+
+void BatchedBinaryDataNotification::BatchSymbolUpdatedCallback(void* ctxt, BNBinaryView*, BNSymbol* sym)
+{
+	BatchedBinaryDataNotification* notify = GetBatchedNotification(ctxt);
+	lock_guard<mutex> lock(notify->m_mutex);
+	notify->m_pending->symbols.Record(
+	    sym, BatchedChange::Updated, [&]() { return Ref<Symbol>(new Symbol(BNNewSymbolReference(sym))); });
+}
+
+
+void BatchedBinaryDataNotification::BatchTypeDefinedCallback(void* ctxt, BNBinaryView*, BNQualifiedName* name, BNType*)
+{
+	BatchedBinaryDataNotification* notify = GetBatchedNotification(ctxt);
+	lock_guard<mutex> lock(notify->m_mutex);
+	QualifiedName typeName = QualifiedName::FromAPIObject(name);
+	notify->m_pending->types.Record(typeName, BatchedChange::Added, [&]() { return typeName; });
+}
+
+
+void BatchedBinaryDataNotification::BatchTypeUndefinedCallback(
+    void* ctxt, BNBinaryView*, BNQualifiedName* name, BNType*)
+{
+	BatchedBinaryDataNotification* notify = GetBatchedNotification(ctxt);
+	lock_guard<mutex> lock(notify->m_mutex);
+	QualifiedName typeName = QualifiedName::FromAPIObject(name);
+	notify->m_pending->types.Record(typeName, BatchedChange::Removed, [&]() { return typeName; });
+}
+
+
+void BatchedBinaryDataNotification::BatchTypeReferenceChangedCallback(
+    void* ctxt, BNBinaryView*, BNQualifiedName* name, BNType*)
+{
+	BatchedBinaryDataNotification* notify = GetBatchedNotification(ctxt);
+	lock_guard<mutex> lock(notify->m_mutex);
+	QualifiedName typeName = QualifiedName::FromAPIObject(name);
+	notify->m_pending->types.Record(typeName, BatchedChange::Updated, [&]() { return typeName; });
+}
+
+
+BatchedBinaryDataNotification::BatchedBinaryDataNotification(NotificationTypes notifications, uint64_t intervalMs) :
+    BinaryDataNotification(notifications), m_pending(new PendingChanges), m_intervalMs(intervalMs),
+    m_userBarrier(notifications & NotificationBarrier)
+{
+	// Batching rides on the barrier, so it is always requested. Everything else keeps whatever the base class set up,
+	// with the batched kinds redirected into the pending changes.
+	BNBinaryDataNotification* callbacks = GetCallbacks();
+	callbacks->notificationBarrier = BatchNotificationBarrierCallback;
+	if (callbacks->dataWritten)
+		callbacks->dataWritten = BatchDataWrittenCallback;
+	if (callbacks->dataInserted)
+		callbacks->dataInserted = BatchDataInsertedCallback;
+	if (callbacks->dataRemoved)
+		callbacks->dataRemoved = BatchDataRemovedCallback;
+	if (callbacks->functionAdded)
+		callbacks->functionAdded = BatchFunctionAddedCallback;
+	if (callbacks->functionRemoved)
+		callbacks->functionRemoved = BatchFunctionRemovedCallback;
+	if (callbacks->functionUpdated)
+		callbacks->functionUpdated = BatchFunctionUpdatedCallback;
+	if (callbacks->dataVariableAdded)
+		callbacks->dataVariableAdded = BatchDataVariableAddedCallback;
+	if (callbacks->dataVariableRemoved)
+		callbacks->dataVariableRemoved = BatchDataVariableRemovedCallback;
+	if (callbacks->dataVariableUpdated)
+		callbacks->dataVariableUpdated = BatchDataVariableUpdatedCallback;
+	if (callbacks->symbolAdded)
+		callbacks->symbolAdded = BatchSymbolAddedCallback;
+	if (callbacks->symbolRemoved)
+		callbacks->symbolRemoved = BatchSymbolRemovedCallback;
+	if (callbacks->symbolUpdated)
+		callbacks->symbolUpdated = BatchSymbolUpdatedCallback;
+	if (callbacks->typeDefined)
+		callbacks->typeDefined = BatchTypeDefinedCallback;
+	if (callbacks->typeUndefined)
+		callbacks->typeUndefined = BatchTypeUndefinedCallback;
+	if (callbacks->typeReferenceChanged)
+		callbacks->typeReferenceChanged = BatchTypeReferenceChangedCallback;
+}
+
+
+BatchedBinaryDataNotification::~BatchedBinaryDataNotification() {}
+
+
+BinaryDataNotificationBatch BatchedBinaryDataNotification::TakeBatch()
+{
+	BinaryDataNotificationBatch batch;
+	lock_guard<mutex> lock(m_mutex);
+	batch.dataChanges.swap(m_pending->dataChanges);
+	m_pending->functions.Drain(batch.functionsAdded, batch.functionsRemoved, batch.functionsUpdated);
+	m_pending->dataVariables.Drain(batch.dataVariablesAdded, batch.dataVariablesRemoved, batch.dataVariablesUpdated);
+	m_pending->symbols.Drain(batch.symbolsAdded, batch.symbolsRemoved, batch.symbolsUpdated);
+	m_pending->types.Drain(batch.typesDefined, batch.typesUndefined, batch.typesUpdated);
+	return batch;
+}
+
+
+void BatchedBinaryDataNotification::Flush(BinaryView* view)
+{
+	BinaryDataNotificationBatch batch = TakeBatch();
+	if (!batch.IsEmpty())
+		OnBatch(view, batch);
+}
+
+
 Symbol::Symbol(BNSymbolType type, const string& shortName, const string& fullName, const string& rawName, uint64_t addr,
     BNSymbolBinding binding, const NameSpace& nameSpace, uint64_t ordinal)
 {
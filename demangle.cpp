@@ -1,4 +1,5 @@
 #include "binaryninjaapi.h"
+#include "parallel.h"
 #include <string>
 using namespace std;
 using namespace BinaryNinja;
@@ -22,6 +23,160 @@ namespace BinaryNinja {
 		return true;
 	}
 
+	vector<DemangledName> DemangleBatch(
+		Ref<Architecture> arch, const vector<string>& mangledNames, Ref<BinaryView> view, bool simplify)
+	{
+		vector<DemangledName> results(mangledNames.size());
+
+		// Only the first occurrence of each name gets demangled
+		unordered_map<string_view, size_t> uniqueIndex;
+		vector<size_t> unique;
+		vector<size_t> resultSource(mangledNames.size());
+		for (size_t i = 0; i < mangledNames.size(); i++)
+		{
+			auto entry = uniqueIndex.emplace(mangledNames[i], unique.size());
+			if (entry.second)
+				unique.push_back(i);
+			resultSource[i] = entry.first->second;
+		}
+
+		// DemangleGeneric goes with the highest priority demangler that claims a name. Only the built-in demanglers
+		// are known to be thread safe, so names claimed by any other demangler are left for this thread. Asking a
+		// demangler whether it claims a name is safe on any thread, the core's symbol queue workers do the same.
+		enum ClaimedBy : uint8_t { NoDemangler, GNU3Demangler, MSDemangler, OtherDemangler };
+		vector<Ref<Demangler>> demanglers = Demangler::GetList();
+		vector<ClaimedBy> demanglerKinds;
+		for (auto& demangler : demanglers)
+		{
+			string name = demangler->GetName();
+			demanglerKinds.push_back(name == "GNU3" ? GNU3Demangler : name == "MS" ? MSDemangler : OtherDemangler);
+		}
+
+		// Given a view, the MS demangler uses the view's default platform rather than arch
+		Ref<Platform> platform = view ? view->GetDefaultPlatform() : nullptr;
+
+		vector<DemangledName> demangled(unique.size());
+		vector<ClaimedBy> claimedBy(unique.size(), NoDemangler);
+		static constexpr size_t BatchChunkSize = 64;
+		ParallelForEach((unique.size() + BatchChunkSize - 1) / BatchChunkSize, [&](size_t chunk) {
+			size_t end = std::min(unique.size(), (chunk + 1) * BatchChunkSize);
+			for (size_t i = chunk * BatchChunkSize; i < end; i++)
+			{
+				const string& name = mangledNames[unique[i]];
+				for (size_t j = demanglers.size(); j > 0; j--)
+				{
+					if (demanglers[j - 1]->IsMangledString(name))
+					{
+						claimedBy[i] = demanglerKinds[j - 1];
+						break;
+					}
+				}
+
+				DemangledName& result = demangled[i];
+				if (claimedBy[i] == GNU3Demangler)
+					result.success = DemangleGNU3(arch, name, result.type, result.name, simplify);
+				else if (claimedBy[i] == MSDemangler && view)
+					result.success = platform && DemangleMSPlatform(platform, name, result.type, result.name, simplify);
+				else if (claimedBy[i] == MSDemangler)
+					result.success = DemangleMS(arch, name, result.type, result.name, simplify);
+			}
+		});
+
+		// Names claimed by other demanglers go through DemangleGeneric here. So do the names a built-in demangler
+		// couldn't handle, since a lower priority demangler may still take them.
+		for (size_t i = 0; i < unique.size(); i++)
+		{
+			if (claimedBy[i] == NoDemangler || demangled[i].success)
+				continue;
+			DemangledName& result = demangled[i];
+			result = DemangledName();
+			result.success = DemangleGeneric(arch, mangledNames[unique[i]], result.type, result.name, view, simplify);
+		}
+
+		for (size_t i = 0; i < mangledNames.size(); i++)
+			results[i] = demangled[resultSource[i]];
+		return results;
+	}
+
+	bool DemangleCache::Demangle(Ref<Architecture> arch, const std::string& mangledName, Ref<Type>& outType,
+		QualifiedName& outVarName, Ref<BinaryView> view, bool simplify)
+	{
+		Shard& shard = m_shards[std::hash<string>()(mangledName) % ShardCount];
+		DemangledName result;
+		bool found = false;
+		{
+			lock_guard<mutex> lock(shard.shardMutex);
+			auto results = shard.results.find({arch->GetObject(), simplify});
+			if (results != shard.results.end())
+			{
+				auto i = results->second.find(mangledName);
+				if (i != results->second.end())
+				{
+					result = i->second;
+					found = true;
+				}
+			}
+		}
+
+		// Demangle without holding the lock, a name demangled twice by racing threads gives the same result
+		if (!found)
+		{
+			result.success = DemangleGeneric(arch, mangledName, result.type, result.name, view, simplify);
+			lock_guard<mutex> lock(shard.shardMutex);
+			shard.results[{arch->GetObject(), simplify}].emplace(mangledName, result);
+		}
+
+		if (!result.success)
+			return false;
+		outType = result.type;
+		outVarName = result.name;
+		return true;
+	}
+
+	vector<DemangledName> DemangleCache::DemangleBatch(
+		Ref<Architecture> arch, const vector<string>& mangledNames, Ref<BinaryView> view, bool simplify)
+	{
+		vector<DemangledName> results(mangledNames.size());
+		vector<string> missing;
+		vector<size_t> missingIndex;
+		for (size_t i = 0; i < mangledNames.size(); i++)
+		{
+			Shard& shard = m_shards[std::hash<string>()(mangledNames[i]) % ShardCount];
+			lock_guard<mutex> lock(shard.shardMutex);
+			auto found = shard.results.find({arch->GetObject(), simplify});
+			if (found != shard.results.end())
+			{
+				auto j = found->second.find(mangledNames[i]);
+				if (j != found->second.end())
+				{
+					results[i] = j->second;
+					continue;
+				}
+			}
+			missing.push_back(mangledNames[i]);
+			missingIndex.push_back(i);
+		}
+
+		vector<DemangledName> demangled = BinaryNinja::DemangleBatch(arch, missing, view, simplify);
+		for (size_t i = 0; i < missing.size(); i++)
+		{
+			Shard& shard = m_shards[std::hash<string>()(missing[i]) % ShardCount];
+			lock_guard<mutex> lock(shard.shardMutex);
+			shard.results[{arch->GetObject(), simplify}].emplace(missing[i], demangled[i]);
+			results[missingIndex[i]] = std::move(demangled[i]);
+		}
+		return results;
+	}
+
+	void DemangleCache::Clear()
+	{
+		for (auto& shard : m_shards)
+		{
+			lock_guard<mutex> lock(shard.shardMutex);
+			shard.results.clear();
+		}
+	}
+
 	bool DemangleLLVM(const std::string& mangledName, QualifiedName& outVarName,
 		BinaryView* view)
 	{
@@ -68,6 +223,24 @@ namespace BinaryNinja {
 		return true;
 	}
 
+	bool DemangleMSPlatform(Ref<Platform> platform, const std::string& mangledName, Ref<Type>& outType,
+		QualifiedName& outVarName, const bool simplify)
+	{
+		BNType* localType = nullptr;
+		char** localVarName = nullptr;
+		size_t localSize = 0;
+		if (!BNDemangleMSPlatform(
+				platform->GetObject(), mangledName.c_str(), &localType, &localVarName, &localSize, simplify))
+			return false;
+		outType = localType ? new Type(localType) : nullptr;
+		for (size_t i = 0; i < localSize; i++)
+		{
+			outVarName.push_back(localVarName[i]);
+		}
+		BNFreeDemangledName(&localVarName, localSize);
+		return true;
+	}
+
 	bool DemangleGNU3(Ref<Architecture> arch, const std::string& mangledName, Ref<Type>& outType, QualifiedName& outVarName,
 	    BinaryView* view)
 	{
@@ -17,6 +17,7 @@
 
 #include "demangle_gnu3.h"
 #include <stdarg.h>
+#include <string.h>
 #include <algorithm>
 #include <memory>
 
@@ -49,8 +50,8 @@ void MyLogDebug(string fmt, ...)
 #else
 #define indent()
 #define dedent()
-void MyLogDebug(string fmt, ...)
-{ (void)fmt; }
+// Arguments aren't evaluated, most of them copy the rest of the input
+#define MyLogDebug(...) do {} while (0)
 #endif
 
 static inline void rtrim(string &s)
@@ -105,14 +106,48 @@ static TypeBuilder CreateUnknownType(const string& s)
 	return TypeBuilder::NamedType(NamedTypeReference::GenerateAutoDemangledTypeReference(UnknownNamedTypeClass, {s}));
 }
 
-DemangleGNU3::Reader::Reader(const string& data): m_data(data), m_offset(0)
+// <builtin-type> codes that are a single letter
+static const char builtinTypeCodes[] = "vwbcahstijlmxynofdegz";
+
+
+static TypeBuilder CreateBuiltinType(Architecture* arch, char elm)
+{
+	switch (elm)
+	{
+	case 'v': return TypeBuilder::VoidType();
+	case 'w': return TypeBuilder::IntegerType(4, false, "wchar_t"); //TODO: verify
+	case 'b': return TypeBuilder::BoolType();
+	case 'c': return TypeBuilder::IntegerType(1, true);
+	case 'a': return TypeBuilder::IntegerType(1, true);
+	case 'h': return TypeBuilder::IntegerType(1, false);
+	case 's': return TypeBuilder::IntegerType(2, true);
+	case 't': return TypeBuilder::IntegerType(2, false);
+	case 'i': return TypeBuilder::IntegerType(4, true);
+	case 'j': return TypeBuilder::IntegerType(4, false);
+	case 'l': return TypeBuilder::IntegerType(arch->GetAddressSize(), true); //long
+	case 'm': return TypeBuilder::IntegerType(arch->GetAddressSize(), false); //ulong
+	case 'x': return TypeBuilder::IntegerType(8, true);
+	case 'y': return TypeBuilder::IntegerType(8, false);
+	case 'n': return TypeBuilder::IntegerType(16, true);
+	case 'o': return TypeBuilder::IntegerType(16, false);
+	case 'f': return TypeBuilder::FloatType(4);
+	case 'd': return TypeBuilder::FloatType(8);
+	case 'e': return TypeBuilder::FloatType(10);
+	case 'g': return TypeBuilder::FloatType(16);
+	case 'z': return TypeBuilder::VarArgsType();
+	default: throw DemangleException();
+	}
+}
+
+
+DemangleGNU3::Reader::Reader(string_view data): m_data(data), m_offset(0)
 {}
 
 
-string DemangleGNU3::Reader::PeekString(size_t count)
+string_view DemangleGNU3::Reader::PeekString(size_t count)
 {
 	if (count > Length())
-		return "\0";
+		return "";
 	return m_data.substr(m_offset, count);
 }
 
@@ -125,21 +160,15 @@ char DemangleGNU3::Reader::Peek()
 }
 
 
-bool DemangleGNU3::Reader::NextIsOneOf(const string& list)
+bool DemangleGNU3::Reader::NextIsOneOf(string_view list)
 {
-	char elm = Peek();
-	for (auto a : list)
-	{
-		if (a == elm)
-			return true;
-	}
-	return false;
+	return list.find(Peek()) != string_view::npos;
 }
 
 
 string DemangleGNU3::Reader::GetRaw()
 {
-	return m_data.substr(m_offset);
+	return string(m_data.substr(m_offset));
 }
 
 
@@ -151,23 +180,23 @@ char DemangleGNU3::Reader::Read()
 }
 
 
-string DemangleGNU3::Reader::ReadString(size_t count)
+string_view DemangleGNU3::Reader::ReadString(size_t count)
 {
 	if (count > Length())
 		throw DemangleException();
 
-	const string out = m_data.substr(m_offset, count);
+	string_view out = m_data.substr(m_offset, count);
 	m_offset += count;
 	return out;
 }
 
 
-string DemangleGNU3::Reader::ReadUntil(char sentinal)
+string_view DemangleGNU3::Reader::ReadUntil(char sentinal)
 {
-	size_t pos = m_data.find_first_of(sentinal, m_offset);
-	if (pos == string::npos)
+	size_t pos = m_data.find(sentinal, m_offset);
+	if (pos == string_view::npos)
 		throw DemangleException();
-	return ReadString(pos);
+	return ReadString(pos - m_offset);
 }
 
 
@@ -192,7 +221,7 @@ size_t DemangleGNU3::Reader::Length() const
 }
 
 
-DemangleGNU3::DemangleGNU3(Architecture* arch, const string& mangledName) :
+DemangleGNU3::DemangleGNU3(Architecture* arch, string_view mangledName) :
 	m_reader(mangledName),
 	m_arch(arch),
 	m_isParameter(false),
@@ -299,13 +328,12 @@ TypeBuilder DemangleGNU3::DemangleFunction(bool cnst, bool vltl)
 	old_isparam = m_isParameter;
 	m_isParameter = true;
 	m_functionSubstitute.push_back({});
-	int i = 0;
 	while (m_reader.Peek() != 'E')
 	{
 		TypeBuilder param = DemangleType();
 		if (param.GetClass() == VoidTypeClass)
 			continue;
-		MyLogDebug("Var_%d - %s\n", i++, param.GetString().c_str());
+		MyLogDebug("Var_%zu - %s\n", params.size(), param.GetString().c_str());
 		m_functionSubstitute.back().push_back(param);
 		params.push_back({"", param.Finalize(), true, Variable()});
 	}
@@ -384,7 +412,8 @@ TypeBuilder DemangleGNU3::DemangleType()
 		return type;
 	}
 
-	switch(m_reader.Read())
+	char elm = m_reader.Read();
+	switch (elm)
 	{
 	case 'S':
 	{
@@ -491,27 +520,10 @@ TypeBuilder DemangleGNU3::DemangleType()
 	case 'G': //TODO:imaginary
 	case 'U': //TODO:vendor extended type
 		throw DemangleException();
-	case 'v': type = TypeBuilder::VoidType(); break;
-	case 'w': type = TypeBuilder::IntegerType(4, false, "wchar_t"); break; //TODO: verify
-	case 'b': type = TypeBuilder::BoolType(); break;
-	case 'c': type = TypeBuilder::IntegerType(1, true); break;
-	case 'a': type = TypeBuilder::IntegerType(1, true); break;
-	case 'h': type = TypeBuilder::IntegerType(1, false); break;
-	case 's': type = TypeBuilder::IntegerType(2, true); break;
-	case 't': type = TypeBuilder::IntegerType(2, false); break;
-	case 'i': type = TypeBuilder::IntegerType(4, true); break;
-	case 'j': type = TypeBuilder::IntegerType(4, false); break;
-	case 'l': type = TypeBuilder::IntegerType(m_arch->GetAddressSize(), true); break; //long
-	case 'm': type = TypeBuilder::IntegerType(m_arch->GetAddressSize(), false); break; //ulong
-	case 'x': type = TypeBuilder::IntegerType(8, true); break;
-	case 'y': type = TypeBuilder::IntegerType(8, false); break;
-	case 'n': type = TypeBuilder::IntegerType(16, true); break;
-	case 'o': type = TypeBuilder::IntegerType(16, false); break;
-	case 'f': type = TypeBuilder::FloatType(4); break;
-	case 'd': type = TypeBuilder::FloatType(8); break;
-	case 'e': type = TypeBuilder::FloatType(10); break;
-	case 'g': type = TypeBuilder::FloatType(16); break;
-	case 'z': type = TypeBuilder::VarArgsType(); break;
+	case 'v': case 'w': case 'b': case 'c': case 'a': case 'h': case 's': case 't': case 'i': case 'j': case 'l':
+	case 'm': case 'x': case 'y': case 'n': case 'o': case 'f': case 'd': case 'e': case 'g': case 'z':
+		type = CreateBuiltinType(m_arch, elm);
+		break;
 	case 'M': // TODO: Make into pointer to function member
 	{
 		TypeBuilder name = DemangleType();
@@ -698,7 +710,7 @@ string DemangleGNU3::DemangleNumberAsString()
 	string number;
 	while (isdigit(m_reader.Peek()))
 	{
-		number += m_reader.ReadString(1);
+		number += m_reader.Read();
 	}
 	return (negativeFactor?"-":"") + number;
 }
@@ -706,9 +718,25 @@ string DemangleGNU3::DemangleNumberAsString()
 // number ::= [n] <decimal>
 int64_t DemangleGNU3::DemangleNumber()
 {
-	return std::stol(DemangleNumberAsString().c_str());
-}
+	// Source name lengths make this one of the hottest paths, so parse in place rather than through a string
+	bool negativeFactor = false;
+	if (m_reader.Peek() == 'n')
+	{
+		negativeFactor = true;
+		m_reader.Consume();
+	}
 
+	if (!isdigit(m_reader.Peek()))
+		throw DemangleException();
+	int64_t number = 0;
+	while (isdigit(m_reader.Peek()))
+	{
+		if (number > (INT64_MAX - 9) / 10)
+			throw DemangleException();
+		number = number * 10 + (m_reader.Read() - '0');
+	}
+	return negativeFactor ? -number : number;
+}
 
 string DemangleGNU3::DemangleInitializer()
 {
@@ -1220,7 +1248,7 @@ QualifiedName DemangleGNU3::DemangleBaseUnresolvedName()
 	QualifiedName out;
 	if (m_reader.Length() > 1)
 	{
-		const string str = m_reader.PeekString(2);
+		string_view str = m_reader.PeekString(2);
 		if (str == "on")
 		{
 			out.push_back(GetOperator(m_reader.Read(), m_reader.Read()));
@@ -1936,9 +1964,7 @@ TypeBuilder DemangleGNU3::DemangleName()
 			m_reader.Consume();
 			//<tmplate-args>
 			DemangleTemplateArgs(args);
-			LogDebug("Typename: %s", type.GetTypeName()[0].c_str());
 			ExtendTypeName(type, GetTemplateString(args));
-			LogDebug("Typename: %s", type.GetTypeName()[0].c_str());
 			type.SetHasTemplateArguments(true);
 		}
 	}
@@ -2169,13 +2195,7 @@ TypeBuilder DemangleGNU3::DemangleSymbol(QualifiedName& varName)
 		if (m_reader.Peek() == '.')
 		{
 			// Extension, consume the rest
-			string ext = m_reader.ReadString(m_reader.Length());
-
-			if (ext == ".eh") ext = "exception handler";
-			else if (ext == ".eh_frame") ext = "exception handler frame";
-			else if (ext == ".eh_frame_hdr") ext = "exception handler frame header";
-			else if (ext == ".debug_frame") ext = "debug frame";
-			varName.back() += ext;
+			varName.back() += GetExtensionName(m_reader.ReadString(m_reader.Length()));
 			break;
 		}
 
@@ -2226,10 +2246,344 @@ TypeBuilder DemangleGNU3::DemangleSymbol(QualifiedName& varName)
 }
 
 
+TypeBuilder DemangleGNU3::DemangleSymbolName(QualifiedName& varName)
+{
+	// Special names are rare and build their names out of types, so they take the full path
+	if (m_reader.Peek() == 'G' || m_reader.Peek() == 'T')
+		return DemangleSymbol(varName);
+
+	TypeBuilder type = DemangleName();
+	if (m_reader.Length() == 0 || m_reader.Peek() == 'E')
+		return type;
+
+	// Nothing after the name changes it apart from a vendor suffix following the parameters, and '.' can't appear
+	// in the parameters themselves. Symbol versions ("@@GLIBC_2.2.5") are not suffixes.
+	varName = type.GetTypeName();
+	string_view rest = m_reader.PeekString(m_reader.Length());
+	rest = rest.substr(0, rest.find("@@"));
+	size_t ext = rest.find('.');
+	if (ext != string_view::npos && varName.size() > 0)
+		varName.back() += GetExtensionName(rest.substr(ext));
+	return type;
+}
+
+
+// Follows DemangleSymbol for the shapes SimpleSymbol covers and gives up on anything else, leaving it to the full
+// demangler. Substitutions are only supported as the leading std::, so no substitution table is needed.
+bool DemangleGNU3::ParseSimpleSymbol(string_view encoding, bool parseParameters, SimpleSymbol& out)
+{
+	struct Parser
+	{
+		string_view encoding;
+		SimpleSymbol& out;
+		size_t offset;
+		string_view lastName;
+
+		char Peek(size_t ahead = 0) const
+		{
+			return offset + ahead < encoding.size() ? encoding[offset + ahead] : '\0';
+		}
+
+		// <source-name> ::= <positive length number> <identifier>
+		bool ReadSourceName(vector<SimpleSymbol::Component>& names)
+		{
+			if (Peek() == 'L')
+				offset++;
+			if (!isdigit(Peek()))
+				return false;
+			size_t length = 0;
+			while (isdigit(Peek()))
+			{
+				length = length * 10 + (encoding[offset++] - '0');
+				if (length > MAX_DEMANGLE_LENGTH)
+					return false;
+			}
+			if (length == 0 || length > encoding.size() - offset)
+				return false;
+			lastName = encoding.substr(offset, length);
+			offset += length;
+			if (lastName.size() > 11 && lastName.substr(0, 11) == "_GLOBAL__N_")
+				names.push_back({"(anonymous namespace)", false});
+			else
+				names.push_back({lastName, false});
+			return true;
+		}
+
+		// <nested-name> ::= N [<CV-qualifiers>] [<ref-qualifier>] <prefix> <unqualified-name> E
+		// Qualifiers, constructors and destructors are only expected on the name of the symbol itself
+		bool ReadNestedName(vector<SimpleSymbol::Component>& names, bool symbolName)
+		{
+			if (symbolName)
+			{
+				for (; Peek() == 'K' || Peek() == 'V'; offset++)
+				{
+					if (Peek() == 'K')
+						out.cnst = true;
+					else
+						out.vltl = true;
+				}
+				if (Peek() == 'R' || Peek() == 'O')
+				{
+					out.ref = true;
+					out.rvalueRef = Peek() == 'O';
+					offset++;
+				}
+			}
+
+			size_t start = names.size();
+			bool structor = false;
+			while (Peek() != 'E')
+			{
+				char elm1 = Peek();
+				char elm2 = Peek(1);
+				if (isdigit(elm1) || elm1 == 'L')
+				{
+					if (!ReadSourceName(names))
+						return false;
+					structor = false;
+				}
+				else if (elm1 == 'S' && elm2 == 't' && names.size() == start)
+				{
+					lastName = "std";
+					names.push_back({lastName, false});
+					offset += 2;
+				}
+				else if (symbolName && !lastName.empty()
+					&& ((elm1 == 'C' && elm2 >= '1' && elm2 <= '5') || (elm1 == 'D' && elm2 >= '0' && elm2 <= '5')))
+				{
+					names.push_back({lastName, elm1 == 'D'});
+					offset += 2;
+					structor = true;
+				}
+				else
+				{
+					return false;
+				}
+			}
+			offset++;
+
+			size_t nameSize = 0;
+			for (size_t i = start; i < names.size(); i++)
+				nameSize += names[i].name.size() + (names[i].destructor ? 1 : 0) + 2;
+			if (names.size() == start || nameSize > MAX_DEMANGLE_LENGTH)
+				return false;
+			if (symbolName)
+				out.isConstructorOrDestructor = structor;
+			return true;
+		}
+
+		bool ReadType(size_t& index)
+		{
+			SimpleSymbol::TypeNode node {};
+			for (; Peek() == 'K' || Peek() == 'V' || Peek() == 'r'; offset++)
+			{
+				if (Peek() == 'r')
+					return false;
+				if (Peek() == 'K')
+					node.cnst = true;
+				else
+					node.vltl = true;
+			}
+
+			char elm = Peek();
+			switch (elm)
+			{
+			case 'P':
+			case 'R':
+			case 'O':
+				offset++;
+				if (!ReadType(node.pointee))
+					return false;
+				if (elm == 'P')
+					node.kind = SimpleSymbol::TypeNode::Pointer;
+				else if (elm == 'R')
+					node.kind = SimpleSymbol::TypeNode::Reference;
+				else
+					node.kind = SimpleSymbol::TypeNode::RValueReference;
+				break;
+			case 'N':
+				offset++;
+				node.kind = SimpleSymbol::TypeNode::Named;
+				node.nameStart = out.typeNames.size();
+				if (!ReadNestedName(out.typeNames, false))
+					return false;
+				node.nameCount = out.typeNames.size() - node.nameStart;
+				break;
+			default:
+				if (isdigit(elm) || elm == 'L')
+				{
+					node.kind = SimpleSymbol::TypeNode::Named;
+					node.nameStart = out.typeNames.size();
+					if (!ReadSourceName(out.typeNames) || Peek() == 'I')
+						return false;
+					node.nameCount = 1;
+				}
+				else if (elm != '\0' && strchr(builtinTypeCodes, elm))
+				{
+					node.kind = SimpleSymbol::TypeNode::Builtin;
+					node.builtin = elm;
+					offset++;
+				}
+				else
+				{
+					return false;
+				}
+			}
+
+			index = out.types.size();
+			out.types.push_back(node);
+			return true;
+		}
+	};
+
+	Parser parser {encoding, out, 0, {}};
+
+	//<function name> or <data name>
+	if (parser.Peek() == 'N')
+	{
+		parser.offset++;
+		if (!parser.ReadNestedName(out.name, true))
+			return false;
+	}
+	else
+	{
+		if (parser.Peek() == 'S' && parser.Peek(1) == 't')
+		{
+			out.name.push_back({"std", false});
+			parser.offset += 2;
+		}
+		if (!parser.ReadSourceName(out.name) || parser.Peek() == 'I')
+			return false;
+	}
+
+	if (parser.offset == encoding.size() || parser.Peek() == 'E')
+		return true;
+
+	out.isFunction = true;
+	if (!parseParameters)
+	{
+		// Same as DemangleSymbolName, the parameters can't contain the suffix
+		string_view rest = encoding.substr(parser.offset);
+		rest = rest.substr(0, rest.find("@@"));
+		size_t ext = rest.find('.');
+		if (ext != string_view::npos)
+			out.extension = rest.substr(ext);
+		return true;
+	}
+
+	if (parser.Peek() == 'J')
+		parser.offset++;
+	if (parser.Peek() == 'B')
+		return false;
+	while (parser.offset < encoding.size())
+	{
+		if (parser.Peek() == 'E' || (parser.Peek() == '@' && parser.Peek(1) == '@'))
+			break;
+		if (parser.Peek() == '.')
+		{
+			out.extension = encoding.substr(parser.offset);
+			break;
+		}
+
+		size_t param;
+		if (!parser.ReadType(param))
+			return false;
+		const SimpleSymbol::TypeNode& node = out.types[param];
+		if (node.kind == SimpleSymbol::TypeNode::Builtin && node.builtin == 'v')
+			break;
+		out.params.push_back(param);
+		if (node.kind == SimpleSymbol::TypeNode::Builtin && node.builtin == 'z')
+			break;
+	}
+	return true;
+}
+
+
+QualifiedName DemangleGNU3::SimpleSymbol::GetName() const
+{
+	QualifiedName result;
+	for (auto& i : name)
+		result.push_back(i.destructor ? "~" + string(i.name) : string(i.name));
+	if (!extension.empty())
+		result.back() += GetExtensionName(extension);
+	return result;
+}
+
+
+TypeBuilder DemangleGNU3::SimpleSymbol::CreateType(Architecture* arch, const TypeNode& node) const
+{
+	TypeBuilder type;
+	switch (node.kind)
+	{
+	case TypeNode::Builtin:
+		type = CreateBuiltinType(arch, node.builtin);
+		break;
+	case TypeNode::Named:
+	{
+		QualifiedName typeName;
+		for (size_t i = node.nameStart; i < node.nameStart + node.nameCount; i++)
+			typeName.push_back(string(typeNames[i].name));
+		type = CreateUnknownType(typeName);
+		break;
+	}
+	case TypeNode::Pointer:
+		type = TypeBuilder::PointerType(arch, CreateType(arch, types[node.pointee]).Finalize(), false, false,
+			PointerReferenceType);
+		break;
+	case TypeNode::Reference:
+		type = TypeBuilder::PointerType(arch, CreateType(arch, types[node.pointee]).Finalize(), false, false,
+			ReferenceReferenceType);
+		break;
+	case TypeNode::RValueReference:
+		type = TypeBuilder::PointerType(arch, CreateType(arch, types[node.pointee]).Finalize(), false, false,
+			RValueReferenceType);
+		break;
+	}
+	if (node.cnst)
+		type.SetConst(true);
+	if (node.vltl)
+		type.SetVolatile(true);
+	return type;
+}
+
+
+// The function type DemangleSymbol builds for the symbol; only called for functions
+TypeBuilder DemangleGNU3::SimpleSymbol::CreateType(Architecture* arch) const
+{
+	TypeBuilder returnType = isConstructorOrDestructor ? TypeBuilder::VoidType() :
+		TypeBuilder::IntegerType(arch->GetAddressSize(), true);
+	vector<FunctionParameter> functionParams;
+	functionParams.reserve(params.size());
+	for (size_t i : params)
+		functionParams.push_back({"", CreateType(arch, types[i]).Finalize(), true, Variable()});
+
+	TypeBuilder type = TypeBuilder::FunctionType(returnType.Finalize()->
+		WithConfidence(isConstructorOrDestructor ? BN_DEFAULT_CONFIDENCE : BN_MINIMUM_CONFIDENCE), nullptr,
+		functionParams);
+	set<BNPointerSuffix> suffix;
+	if (ref)
+		suffix.insert(rvalueRef ? LvalueSuffix : ReferenceSuffix);
+	type.SetPointerSuffix(suffix);
+	type.SetConst(cnst);
+	type.SetVolatile(vltl);
+	return type;
+}
+
+
+string_view DemangleGNU3::GetExtensionName(string_view ext)
+{
+	if (ext == ".eh") return "exception handler";
+	if (ext == ".eh_frame") return "exception handler frame";
+	if (ext == ".eh_frame_hdr") return "exception handler frame header";
+	if (ext == ".debug_frame") return "debug frame";
+	return ext;
+}
+
+
 bool DemangleGNU3::IsGNU3MangledString(const string& name)
 {
-	string headerless = name;
-	string header;
+	string_view headerless = name;
+	string_view header;
 	if (DemangleGlobalHeader(headerless, header))
 		return true;
 
@@ -2241,29 +2595,38 @@ bool DemangleGNU3::IsGNU3MangledString(const string& name)
 
 
 bool DemangleGNU3::DemangleGlobalHeader(string& name, string& header)
+{
+	string_view nameView = name;
+	string_view headerView;
+	if (!DemangleGlobalHeader(nameView, headerView))
+		return false;
+	name = string(nameView);
+	header = string(headerView);
+	return true;
+}
+
+
+bool DemangleGNU3::DemangleGlobalHeader(string_view& name, string_view& header)
 {
 	size_t strippedCount = 0;
-	string encoded = name;
-	while (encoded[0] == '_')
-	{
-		encoded.erase(0, 1);
+	while (strippedCount < name.size() && name[strippedCount] == '_')
 		strippedCount ++;
-	}
 
 	if (strippedCount == 0)
 		return false;
 
-	static const vector<pair<string, string>> headers = {
+	static const pair<string_view, string_view> headers[] = {
 		{"GLOBAL__sub_I_", "(static initializer)"},
 		{"GLOBAL__I_", "(global initializer)"},
 		{"GLOBAL__D_", "(global destructor)"},
 	};
 
+	string_view encoded = name.substr(strippedCount);
 	for (auto& i: headers)
 	{
 		if (encoded.size() > i.first.size() && encoded.substr(0, i.first.size()) == i.first)
 		{
-			name = name.substr(i.first.size() + strippedCount);
+			name = encoded.substr(i.first.size());
 			header = i.second;
 			return true;
 		}
@@ -2287,8 +2650,21 @@ bool DemangleGNU3::DemangleStringGNU3(Architecture* arch, const string& name, Re
 
 bool DemangleGNU3::DemangleStringGNU3(Architecture* arch, const string& name, Ref<Type>& outType, QualifiedName& outVarName)
 {
-	string encoding = name;
-	string header;
+	return DemangleString(arch, name, outType, outVarName, true);
+}
+
+
+bool DemangleGNU3::DemangleStringGNU3Full(Architecture* arch, const string& name, Ref<Type>& outType, QualifiedName& outVarName)
+{
+	return DemangleString(arch, name, outType, outVarName, false);
+}
+
+
+bool DemangleGNU3::DemangleString(Architecture* arch, const string& name, Ref<Type>& outType, QualifiedName& outVarName,
+	bool useSimpleSymbol)
+{
+	string_view encoding = name;
+	string_view header;
 	bool foundHeader = DemangleGlobalHeader(encoding, header);
 
 	if (!encoding.compare(0, 2, "_Z"))
@@ -2300,14 +2676,26 @@ bool DemangleGNU3::DemangleStringGNU3(Architecture* arch, const string& name, Re
 		// Some variable constructors/destructors are __GLOBAL__I_name
 		// And there are even __GLOBAL__sub_I_file_name.cpp
 		outVarName.clear();
-		outVarName.push_back(header);
-		outVarName.push_back(encoding);
+		outVarName.push_back(string(header));
+		outVarName.push_back(string(encoding));
 		outType = CreateUnknownType(outVarName).Finalize();
 		return true;
 	}
 	else
 		return false;
 
+	SimpleSymbol symbol;
+	if (useSimpleSymbol && ParseSimpleSymbol(encoding, true, symbol))
+	{
+		outVarName = symbol.GetName();
+		outType = nullptr;
+		if (symbol.isFunction)
+			outType = symbol.CreateType(arch).Finalize();
+		if (foundHeader && !header.empty())
+			outVarName.insert(outVarName.begin(), string(header));
+		return true;
+	}
+
 	DemangleGNU3 demangle(arch, encoding);
 	try
 	{
@@ -2330,7 +2718,69 @@ bool DemangleGNU3::DemangleStringGNU3(Architecture* arch, const string& name, Re
 
 		if (foundHeader && !header.empty())
 		{
-			outVarName.insert(outVarName.begin(), header);
+			outVarName.insert(outVarName.begin(), string(header));
+		}
+	}
+	catch (std::exception&)
+	{
+		return false;
+	}
+	return true;
+}
+
+
+bool DemangleGNU3::DemangleNameGNU3(Architecture* arch, string_view name, QualifiedName& outVarName)
+{
+	string_view encoding = name;
+	string_view header;
+	bool foundHeader = DemangleGlobalHeader(encoding, header);
+
+	if (!encoding.compare(0, 2, "_Z"))
+		encoding = encoding.substr(2);
+	else if (!encoding.compare(0, 3, "__Z"))
+		encoding = encoding.substr(3);
+	else if (foundHeader && !header.empty())
+	{
+		outVarName.clear();
+		outVarName.push_back(string(header));
+		outVarName.push_back(string(encoding));
+		return true;
+	}
+	else
+		return false;
+
+	SimpleSymbol symbol;
+	if (ParseSimpleSymbol(encoding, false, symbol))
+	{
+		outVarName = symbol.GetName();
+		if (foundHeader && !header.empty())
+			outVarName.insert(outVarName.begin(), string(header));
+		return true;
+	}
+
+	DemangleGNU3 demangle(arch, encoding);
+	try
+	{
+		TypeBuilder type = demangle.DemangleSymbolName(outVarName);
+
+		// Same fallbacks as DemangleStringGNU3, using the type of the name itself
+		if (outVarName.size() == 0 && type.GetClass() == NamedTypeReferenceClass)
+		{
+			if (type.GetNamedTypeReference()->GetTypeReferenceClass() == UnknownNamedTypeClass)
+			{
+				outVarName = type.GetTypeName();
+			}
+			else
+			{
+				auto typeName = type.GetTypeName();
+				if (typeName.size() > 0)
+					outVarName = "_" + typeName[typeName.size() - 1];
+			}
+		}
+
+		if (foundHeader && !header.empty())
+		{
+			outVarName.insert(outVarName.begin(), string(header));
 		}
 	}
 	catch (std::exception&)
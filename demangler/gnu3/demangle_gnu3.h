@@ -15,6 +15,7 @@
 #pragma once
 #include <stdexcept>
 #include <exception>
+#include <string_view>
 
 // XXX: Compiled directly into the core for performance reasons
 // Will still work fine compiled independently, just at about a
@@ -45,22 +46,23 @@ public:
 
 class DemangleGNU3
 {
+	// Reads from a view of the mangled name, which must outlive the reader
 	class Reader
 	{
 	public:
-		Reader(const _STD_STRING& data);
-		_STD_STRING PeekString(size_t count=1);
+		Reader(std::string_view data);
+		std::string_view PeekString(size_t count=1);
 		char Peek();
-		bool NextIsOneOf(const _STD_STRING& list);
+		bool NextIsOneOf(std::string_view list);
 		_STD_STRING GetRaw();
 		char Read();
-		_STD_STRING ReadString(size_t count=1);
-		_STD_STRING ReadUntil(char sentinal);
+		std::string_view ReadString(size_t count=1);
+		std::string_view ReadUntil(char sentinal);
 		void Consume(size_t count=1);
 		size_t Length() const;
 		void UnRead(size_t count=1);
 	private:
-		_STD_STRING m_data;
+		std::string_view m_data;
 		size_t m_offset;
 	};
 
@@ -124,16 +126,73 @@ class DemangleGNU3
 	void PushType(BN::TypeBuilder type);
 	const BN::TypeBuilder& GetType(size_t ref);
 	static bool DemangleGlobalHeader(_STD_STRING& name, _STD_STRING& header);
+	static bool DemangleGlobalHeader(std::string_view& name, std::string_view& header);
+	BN::TypeBuilder DemangleSymbolName(BN::QualifiedName& varName);
+
+	// Parse tree of the most common symbol shapes, built without touching the type system: a name made of source
+	// names, std::, constructors and destructors, and for functions parameters of builtin, pointer, reference and
+	// class types. Names are views into the mangled string. CreateType builds the same type the full demangler
+	// would, and is only called when the caller wants one. Anything else is left to the full demangler.
+	struct SimpleSymbol
+	{
+		struct Component
+		{
+			std::string_view name;
+			bool destructor;
+		};
+
+		struct TypeNode
+		{
+			enum Kind { Builtin, Named, Pointer, Reference, RValueReference };
+			Kind kind;
+			bool cnst;
+			bool vltl;
+			char builtin;  // Builtin: the <builtin-type> code
+			size_t nameStart, nameCount;  // Named: range of typeNames
+			size_t pointee;  // Pointer and references: index of the node pointed to
+		};
+
+		_STD_VECTOR<Component> name;
+		_STD_VECTOR<Component> typeNames;
+		_STD_VECTOR<TypeNode> types;
+		_STD_VECTOR<size_t> params;
+		std::string_view extension;
+		bool isFunction = false;
+		bool isConstructorOrDestructor = false;
+		bool cnst = false;
+		bool vltl = false;
+		bool ref = false;
+		bool rvalueRef = false;
+
+		BN::QualifiedName GetName() const;
+		BN::TypeBuilder CreateType(BN::Architecture* arch) const;
+
+	private:
+		BN::TypeBuilder CreateType(BN::Architecture* arch, const TypeNode& node) const;
+	};
+	static bool ParseSimpleSymbol(std::string_view encoding, bool parseParameters, SimpleSymbol& out);
+	static bool DemangleString(BN::Architecture* arch, const _STD_STRING& name, BN::Ref<BN::Type>& outType, BN::QualifiedName& outVarName, bool useSimpleSymbol);
 
 public:
-	DemangleGNU3(BN::Architecture* arch, const _STD_STRING& mangledName);
+	// The reader borrows mangledName rather than copying it, so the string it views must outlive the demangler
+	DemangleGNU3(BN::Architecture* arch, std::string_view mangledName);
 	BN::TypeBuilder DemangleSymbol(BN::QualifiedName& varName);
 	BN::QualifiedName GetVarName() const { return m_varName; }
 	static bool IsGNU3MangledString(const _STD_STRING& name);
+	static std::string_view GetExtensionName(std::string_view ext);
 
 	// Tread lightly on this landmine; a BinaryView* will be converted to a bool; use an explicit (BN::Ref<BN::BinaryView>)view cast
 	static bool DemangleStringGNU3(BN::Architecture* arch, const _STD_STRING& name, BN::Ref<BN::Type>& outType, BN::QualifiedName& outVarName, const BN::Ref<BN::BinaryView>& view);
 	static bool DemangleStringGNU3(BN::Architecture* arch, const _STD_STRING& name, BN::Ref<BN::Type>& outType, BN::QualifiedName& outVarName, BN::BinaryView* view);
 	static bool DemangleStringGNU3(BN::Architecture* arch, const _STD_STRING& name, BN::Ref<BN::Type>& outType, BN::QualifiedName& outVarName);
+	// Always uses the full parser and never the SimpleSymbol fast path, which must give the same result. Only meant
+	// for checking the two against each other (examples/demangle_gnu3_bench).
+	static bool DemangleStringGNU3Full(BN::Architecture* arch, const _STD_STRING& name, BN::Ref<BN::Type>& outType, BN::QualifiedName& outVarName);
+
+	// Only demangles the name of a symbol. Function parameters and return types are skipped rather than built, so
+	// this is the cheaper option when the type isn't needed (symbol lists, name lookups). The name is the one
+	// DemangleStringGNU3 produces, except that vendor suffixes such as ".cold" are always kept and the parameters
+	// aren't checked. Common names are read without creating any types at all.
+	static bool DemangleNameGNU3(BN::Architecture* arch, std::string_view name, BN::QualifiedName& outVarName);
 	void PrintTables();
 };
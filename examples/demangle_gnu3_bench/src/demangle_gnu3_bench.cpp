@@ -0,0 +1,166 @@
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include "binaryninjacore.h"
+#include "binaryninjaapi.h"
+#include "demangle_gnu3.h"
+
+using namespace BinaryNinja;
+using namespace std;
+
+// Checks the GNU3 demangler's SimpleSymbol fast path against its full parser over a corpus of mangled names, and
+// times both. The corpus is either the raw names of every GNU3 mangled symbol in a binary, or a text file with one
+// mangled name per line. Every name is demangled three ways:
+//   - DemangleStringGNU3, which tries the fast path first
+//   - DemangleStringGNU3Full, which only uses the full parser
+//   - DemangleNameGNU3, the name-only path
+// The first two must agree on success, name and type. The name-only path must return the same name whenever the
+// full parser succeeds.
+
+
+struct Result
+{
+	bool success;
+	Ref<Type> type;
+	QualifiedName name;
+};
+
+
+static string TypeString(const Ref<Type>& type, const QualifiedName& name)
+{
+	if (!type)
+		return name.GetString() + " (no type)";
+	return type->GetStringBeforeName() + name.GetString() + type->GetStringAfterName();
+}
+
+
+static bool SameType(const Ref<Type>& a, const Ref<Type>& b)
+{
+	if (!a || !b)
+		return !a && !b;
+	return *a == *b;
+}
+
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2 || argc > 4)
+	{
+		fprintf(stderr, "Usage: %s <file | name list> [architecture] [max mismatches shown]\n", argv[0]);
+		return 1;
+	}
+	size_t maxShown = (argc == 4) ? strtoul(argv[3], nullptr, 0) : 20;
+
+	// In order to initiate the bundled plugins properly, the location
+	// of where bundled plugins directory is must be set.
+	SetBundledPluginDirectory(GetBundledPluginDirectory());
+	InitPlugins();
+
+	vector<string> names;
+	Ref<Architecture> arch;
+	Ref<BinaryView> bv = BinaryNinja::Load(argv[1], false);
+	if (bv && bv->GetTypeName() != "Raw")
+	{
+		arch = bv->GetDefaultArchitecture();
+		for (auto& sym : bv->GetSymbols())
+		{
+			string rawName = sym->GetRawName();
+			if (DemangleGNU3::IsGNU3MangledString(rawName))
+				names.push_back(rawName);
+		}
+	}
+	else
+	{
+		ifstream list(argv[1]);
+		for (string line; getline(list, line);)
+		{
+			if (!line.empty() && line.back() == '\r')
+				line.pop_back();
+			if (!line.empty())
+				names.push_back(line);
+		}
+	}
+	if (argc >= 3)
+		arch = Architecture::GetByName(argv[2]);
+	else if (!arch)
+		arch = Architecture::GetByName("x86_64");
+	if (!arch)
+	{
+		fprintf(stderr, "Unknown architecture\n");
+		return -1;
+	}
+	if (names.empty())
+	{
+		fprintf(stderr, "No mangled names found\n");
+		return -1;
+	}
+
+	vector<Result> simple(names.size());
+	auto start = chrono::steady_clock::now();
+	for (size_t i = 0; i < names.size(); i++)
+		simple[i].success = DemangleGNU3::DemangleStringGNU3(arch, names[i], simple[i].type, simple[i].name);
+	double simpleSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	vector<Result> full(names.size());
+	start = chrono::steady_clock::now();
+	for (size_t i = 0; i < names.size(); i++)
+		full[i].success = DemangleGNU3::DemangleStringGNU3Full(arch, names[i], full[i].type, full[i].name);
+	double fullSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	vector<Result> nameOnly(names.size());
+	start = chrono::steady_clock::now();
+	for (size_t i = 0; i < names.size(); i++)
+		nameOnly[i].success = DemangleGNU3::DemangleNameGNU3(arch, names[i], nameOnly[i].name);
+	double nameOnlySeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	size_t demangled = 0;
+	size_t typeMismatches = 0;
+	size_t nameMismatches = 0;
+	size_t shown = 0;
+	for (size_t i = 0; i < names.size(); i++)
+	{
+		if (full[i].success)
+			demangled++;
+
+		if (simple[i].success != full[i].success
+			|| (full[i].success && (simple[i].name != full[i].name || !SameType(simple[i].type, full[i].type))))
+		{
+			typeMismatches++;
+			if (shown++ < maxShown)
+			{
+				printf("MISMATCH %s\n", names[i].c_str());
+				printf("    full:      %s\n", full[i].success ? TypeString(full[i].type, full[i].name).c_str() : "(failed)");
+				printf("    fast path: %s\n", simple[i].success ? TypeString(simple[i].type, simple[i].name).c_str() : "(failed)");
+			}
+		}
+
+		if (full[i].success && (!nameOnly[i].success || nameOnly[i].name != full[i].name))
+		{
+			nameMismatches++;
+			if (shown++ < maxShown)
+			{
+				printf("NAME MISMATCH %s\n", names[i].c_str());
+				printf("    full:      %s\n", full[i].name.GetString().c_str());
+				printf("    name only: %s\n", nameOnly[i].success ? nameOnly[i].name.GetString().c_str() : "(failed)");
+			}
+		}
+	}
+
+	printf("%" PRIuPTR " names, %" PRIuPTR " demangled by the full parser\n", names.size(), demangled);
+	printf("    full parser:              %8.3fs\n", fullSeconds);
+	printf("    DemangleStringGNU3:       %8.3fs (%.2fx), %" PRIuPTR " mismatches\n", simpleSeconds,
+		simpleSeconds > 0 ? fullSeconds / simpleSeconds : 0.0, typeMismatches);
+	printf("    DemangleNameGNU3:         %8.3fs (%.2fx), %" PRIuPTR " mismatches\n", nameOnlySeconds,
+		nameOnlySeconds > 0 ? fullSeconds / nameOnlySeconds : 0.0, nameMismatches);
+
+	// Close the file so that the resources can be freed
+	if (bv)
+		bv->GetFile()->Close();
+
+	// Shutting down is required to allow for clean exit of the core
+	BNShutdown();
+
+	return (typeMismatches || nameMismatches) ? 1 : 0;
+}
@@ -0,0 +1,799 @@
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <stack>
+#include "binaryninjacore.h"
+#include "binaryninjaapi.h"
+#include "lowlevelilinstruction.h"
+#include "mediumlevelilinstruction.h"
+#include "highlevelilinstruction.h"
+
+using namespace BinaryNinja;
+using namespace std;
+
+// Compares walking every IL expression in a binary with the template VisitExprs against the VisitExprs
+// implementations it replaced, copied below as they were: LLIL and MLIL recursing through a std::function, and HLIL
+// walking an explicit stack while fetching every subexpression from the core.
+
+
+static void LegacyVisitExprs(
+	const LowLevelILInstruction& instr, const function<bool(const LowLevelILInstruction& expr)>& func)
+{
+	if (!func(instr))
+		return;
+	switch (instr.operation)
+	{
+	case LLIL_SET_REG:
+		LegacyVisitExprs(instr.GetSourceExpr<LLIL_SET_REG>(), func);
+		break;
+	case LLIL_SET_REG_SPLIT:
+		LegacyVisitExprs(instr.GetSourceExpr<LLIL_SET_REG_SPLIT>(), func);
+		break;
+	case LLIL_SET_REG_SSA:
+		LegacyVisitExprs(instr.GetSourceExpr<LLIL_SET_REG_SSA>(), func);
+		break;
+	case LLIL_SET_REG_SSA_PARTIAL:
+		LegacyVisitExprs(instr.GetSourceExpr<LLIL_SET_REG_SSA_PARTIAL>(), func);
+		break;
+	case LLIL_SET_REG_SPLIT_SSA:
+		LegacyVisitExprs(instr.GetSourceExpr<LLIL_SET_REG_SPLIT_SSA>(), func);
+		break;
+	case LLIL_SET_REG_STACK_REL:
+		LegacyVisitExprs(instr.GetDestExpr<LLIL_SET_REG_STACK_REL>(), func);
+		LegacyVisitExprs(instr.GetSourceExpr<LLIL_SET_REG_STACK_REL>(), func);
+		break;
+	case LLIL_REG_STACK_PUSH:
+		LegacyVisitExprs(instr.GetSourceExpr<LLIL_REG_STACK_PUSH>(), func);
+		break;
+	case LLIL_SET_REG_STACK_REL_SSA:
+		LegacyVisitExprs(instr.GetDestExpr<LLIL_SET_REG_STACK_REL_SSA>(), func);
+		LegacyVisitExprs(instr.GetSourceExpr<LLIL_SET_REG_STACK_REL_SSA>(), func);
+		break;
+	case LLIL_SET_REG_STACK_ABS_SSA:
+		LegacyVisitExprs(instr.GetSourceExpr<LLIL_SET_REG_STACK_ABS_SSA>(), func);
+		break;
+	case LLIL_SET_FLAG:
+		LegacyVisitExprs(instr.GetSourceExpr<LLIL_SET_FLAG>(), func);
+		break;
+	case LLIL_SET_FLAG_SSA:
+		LegacyVisitExprs(instr.GetSourceExpr<LLIL_SET_FLAG_SSA>(), func);
+		break;
+	case LLIL_REG_STACK_REL:
+		LegacyVisitExprs(instr.GetSourceExpr<LLIL_REG_STACK_REL>(), func);
+		break;
+	case LLIL_REG_STACK_FREE_REL:
+		LegacyVisitExprs(instr.GetDestExpr<LLIL_REG_STACK_FREE_REL>(), func);
+		break;
+	case LLIL_REG_STACK_REL_SSA:
+		LegacyVisitExprs(instr.GetSourceExpr<LLIL_REG_STACK_REL_SSA>(), func);
+		break;
+	case LLIL_REG_STACK_FREE_REL_SSA:
+		LegacyVisitExprs(instr.GetDestExpr<LLIL_REG_STACK_FREE_REL_SSA>(), func);
+		break;
+	case LLIL_LOAD:
+		LegacyVisitExprs(instr.GetSourceExpr<LLIL_LOAD>(), func);
+		break;
+	case LLIL_LOAD_SSA:
+		LegacyVisitExprs(instr.GetSourceExpr<LLIL_LOAD_SSA>(), func);
+		break;
+	case LLIL_STORE:
+		LegacyVisitExprs(instr.GetDestExpr<LLIL_STORE>(), func);
+		LegacyVisitExprs(instr.GetSourceExpr<LLIL_STORE>(), func);
+		break;
+	case LLIL_STORE_SSA:
+		LegacyVisitExprs(instr.GetDestExpr<LLIL_STORE_SSA>(), func);
+		LegacyVisitExprs(instr.GetSourceExpr<LLIL_STORE_SSA>(), func);
+		break;
+	case LLIL_JUMP:
+		LegacyVisitExprs(instr.GetDestExpr<LLIL_JUMP>(), func);
+		break;
+	case LLIL_JUMP_TO:
+		LegacyVisitExprs(instr.GetDestExpr<LLIL_JUMP_TO>(), func);
+		break;
+	case LLIL_IF:
+		LegacyVisitExprs(instr.GetConditionExpr<LLIL_IF>(), func);
+		break;
+	case LLIL_CALL:
+		LegacyVisitExprs(instr.GetDestExpr<LLIL_CALL>(), func);
+		break;
+	case LLIL_CALL_STACK_ADJUST:
+		LegacyVisitExprs(instr.GetDestExpr<LLIL_CALL_STACK_ADJUST>(), func);
+		break;
+	case LLIL_TAILCALL:
+		LegacyVisitExprs(instr.GetDestExpr<LLIL_TAILCALL>(), func);
+		break;
+	case LLIL_CALL_SSA:
+		LegacyVisitExprs(instr.GetDestExpr<LLIL_CALL_SSA>(), func);
+		for (auto i : instr.GetParameterExprs<LLIL_CALL_SSA>())
+			LegacyVisitExprs(i, func);
+		break;
+	case LLIL_SYSCALL_SSA:
+		for (auto i : instr.GetParameterExprs<LLIL_SYSCALL_SSA>())
+			LegacyVisitExprs(i, func);
+		break;
+	case LLIL_TAILCALL_SSA:
+		LegacyVisitExprs(instr.GetDestExpr<LLIL_TAILCALL_SSA>(), func);
+		for (auto i : instr.GetParameterExprs<LLIL_TAILCALL_SSA>())
+			LegacyVisitExprs(i, func);
+		break;
+	case LLIL_RET:
+		LegacyVisitExprs(instr.GetDestExpr<LLIL_RET>(), func);
+		break;
+	case LLIL_PUSH:
+	case LLIL_NEG:
+	case LLIL_NOT:
+	case LLIL_SX:
+	case LLIL_ZX:
+	case LLIL_LOW_PART:
+	case LLIL_BOOL_TO_INT:
+	case LLIL_UNIMPL_MEM:
+	case LLIL_FSQRT:
+	case LLIL_FNEG:
+	case LLIL_FABS:
+	case LLIL_FLOAT_TO_INT:
+	case LLIL_INT_TO_FLOAT:
+	case LLIL_FLOAT_CONV:
+	case LLIL_ROUND_TO_INT:
+	case LLIL_FLOOR:
+	case LLIL_CEIL:
+	case LLIL_FTRUNC:
+		LegacyVisitExprs(instr.AsOneOperand().GetSourceExpr(), func);
+		break;
+	case LLIL_ADD:
+	case LLIL_SUB:
+	case LLIL_AND:
+	case LLIL_OR:
+	case LLIL_XOR:
+	case LLIL_LSL:
+	case LLIL_LSR:
+	case LLIL_ASR:
+	case LLIL_ROL:
+	case LLIL_ROR:
+	case LLIL_MUL:
+	case LLIL_MULU_DP:
+	case LLIL_MULS_DP:
+	case LLIL_DIVU:
+	case LLIL_DIVS:
+	case LLIL_MODU:
+	case LLIL_MODS:
+	case LLIL_DIVU_DP:
+	case LLIL_DIVS_DP:
+	case LLIL_MODU_DP:
+	case LLIL_MODS_DP:
+	case LLIL_CMP_E:
+	case LLIL_CMP_NE:
+	case LLIL_CMP_SLT:
+	case LLIL_CMP_ULT:
+	case LLIL_CMP_SLE:
+	case LLIL_CMP_ULE:
+	case LLIL_CMP_SGE:
+	case LLIL_CMP_UGE:
+	case LLIL_CMP_SGT:
+	case LLIL_CMP_UGT:
+	case LLIL_TEST_BIT:
+	case LLIL_ADD_OVERFLOW:
+	case LLIL_FADD:
+	case LLIL_FSUB:
+	case LLIL_FMUL:
+	case LLIL_FDIV:
+	case LLIL_FCMP_E:
+	case LLIL_FCMP_NE:
+	case LLIL_FCMP_LT:
+	case LLIL_FCMP_LE:
+	case LLIL_FCMP_GE:
+	case LLIL_FCMP_GT:
+	case LLIL_FCMP_O:
+	case LLIL_FCMP_UO:
+		LegacyVisitExprs(instr.AsTwoOperand().GetLeftExpr(), func);
+		LegacyVisitExprs(instr.AsTwoOperand().GetRightExpr(), func);
+		break;
+	case LLIL_ADC:
+	case LLIL_SBB:
+	case LLIL_RLC:
+	case LLIL_RRC:
+		LegacyVisitExprs(instr.AsTwoOperandWithCarry().GetLeftExpr(), func);
+		LegacyVisitExprs(instr.AsTwoOperandWithCarry().GetRightExpr(), func);
+		LegacyVisitExprs(instr.AsTwoOperandWithCarry().GetCarryExpr(), func);
+		break;
+	case LLIL_INTRINSIC:
+		for (auto i : instr.GetParameterExprs<LLIL_INTRINSIC>())
+			LegacyVisitExprs(i, func);
+		break;
+	case LLIL_INTRINSIC_SSA:
+		for (auto i : instr.GetParameterExprs<LLIL_INTRINSIC_SSA>())
+			LegacyVisitExprs(i, func);
+		break;
+	case LLIL_MEMORY_INTRINSIC_SSA:
+		for (auto i : instr.GetParameterExprs<LLIL_MEMORY_INTRINSIC_SSA>())
+			LegacyVisitExprs(i, func);
+		break;
+	case LLIL_SEPARATE_PARAM_LIST_SSA:
+		for (auto i : instr.GetParameterExprs<LLIL_SEPARATE_PARAM_LIST_SSA>())
+			LegacyVisitExprs(i, func);
+		break;
+	case LLIL_SHARED_PARAM_SLOT_SSA:
+		for (auto i : instr.GetParameterExprs<LLIL_SHARED_PARAM_SLOT_SSA>())
+			LegacyVisitExprs(i, func);
+		break;
+	default:
+		break;
+	}
+}
+
+
+static void LegacyVisitExprs(
+	const MediumLevelILInstruction& instr, const function<bool(const MediumLevelILInstruction& expr)>& func)
+{
+	if (!func(instr))
+		return;
+	switch (instr.operation)
+	{
+	case MLIL_SET_VAR:
+		LegacyVisitExprs(instr.GetSourceExpr<MLIL_SET_VAR>(), func);
+		break;
+	case MLIL_SET_VAR_SSA:
+		LegacyVisitExprs(instr.GetSourceExpr<MLIL_SET_VAR_SSA>(), func);
+		break;
+	case MLIL_SET_VAR_ALIASED:
+		LegacyVisitExprs(instr.GetSourceExpr<MLIL_SET_VAR_ALIASED>(), func);
+		break;
+	case MLIL_SET_VAR_SPLIT:
+		LegacyVisitExprs(instr.GetSourceExpr<MLIL_SET_VAR_SPLIT>(), func);
+		break;
+	case MLIL_SET_VAR_SPLIT_SSA:
+		LegacyVisitExprs(instr.GetSourceExpr<MLIL_SET_VAR_SPLIT_SSA>(), func);
+		break;
+	case MLIL_SET_VAR_FIELD:
+		LegacyVisitExprs(instr.GetSourceExpr<MLIL_SET_VAR_FIELD>(), func);
+		break;
+	case MLIL_SET_VAR_SSA_FIELD:
+		LegacyVisitExprs(instr.GetSourceExpr<MLIL_SET_VAR_SSA_FIELD>(), func);
+		break;
+	case MLIL_SET_VAR_ALIASED_FIELD:
+		LegacyVisitExprs(instr.GetSourceExpr<MLIL_SET_VAR_ALIASED_FIELD>(), func);
+		break;
+	case MLIL_CALL:
+		LegacyVisitExprs(instr.GetDestExpr<MLIL_CALL>(), func);
+		for (auto i : instr.GetParameterExprs<MLIL_CALL>())
+			LegacyVisitExprs(i, func);
+		break;
+	case MLIL_CALL_UNTYPED:
+		LegacyVisitExprs(instr.GetDestExpr<MLIL_CALL_UNTYPED>(), func);
+		for (auto i : instr.GetParameterExprs<MLIL_CALL_UNTYPED>())
+			LegacyVisitExprs(i, func);
+		break;
+	case MLIL_CALL_SSA:
+		LegacyVisitExprs(instr.GetDestExpr<MLIL_CALL_SSA>(), func);
+		for (auto i : instr.GetParameterExprs<MLIL_CALL_SSA>())
+			LegacyVisitExprs(i, func);
+		break;
+	case MLIL_CALL_UNTYPED_SSA:
+		LegacyVisitExprs(instr.GetDestExpr<MLIL_CALL_UNTYPED_SSA>(), func);
+		for (auto i : instr.GetParameterExprs<MLIL_CALL_UNTYPED_SSA>())
+			LegacyVisitExprs(i, func);
+		break;
+	case MLIL_SYSCALL:
+		for (auto i : instr.GetParameterExprs<MLIL_SYSCALL>())
+			LegacyVisitExprs(i, func);
+		break;
+	case MLIL_SYSCALL_UNTYPED:
+		for (auto i : instr.GetParameterExprs<MLIL_SYSCALL_UNTYPED>())
+			LegacyVisitExprs(i, func);
+		break;
+	case MLIL_SYSCALL_SSA:
+		for (auto i : instr.GetParameterExprs<MLIL_SYSCALL_SSA>())
+			LegacyVisitExprs(i, func);
+		break;
+	case MLIL_SYSCALL_UNTYPED_SSA:
+		for (auto i : instr.GetParameterExprs<MLIL_SYSCALL_UNTYPED_SSA>())
+			LegacyVisitExprs(i, func);
+		break;
+	case MLIL_TAILCALL:
+		LegacyVisitExprs(instr.GetDestExpr<MLIL_TAILCALL>(), func);
+		for (auto i : instr.GetParameterExprs<MLIL_TAILCALL>())
+			LegacyVisitExprs(i, func);
+		break;
+	case MLIL_TAILCALL_UNTYPED:
+		LegacyVisitExprs(instr.GetDestExpr<MLIL_TAILCALL_UNTYPED>(), func);
+		for (auto i : instr.GetParameterExprs<MLIL_TAILCALL_UNTYPED>())
+			LegacyVisitExprs(i, func);
+		break;
+	case MLIL_TAILCALL_SSA:
+		LegacyVisitExprs(instr.GetDestExpr<MLIL_TAILCALL_SSA>(), func);
+		for (auto i : instr.GetParameterExprs<MLIL_TAILCALL_SSA>())
+			LegacyVisitExprs(i, func);
+		break;
+	case MLIL_TAILCALL_UNTYPED_SSA:
+		LegacyVisitExprs(instr.GetDestExpr<MLIL_TAILCALL_UNTYPED_SSA>(), func);
+		for (auto i : instr.GetParameterExprs<MLIL_TAILCALL_UNTYPED_SSA>())
+			LegacyVisitExprs(i, func);
+		break;
+	case MLIL_SEPARATE_PARAM_LIST:
+		for (auto i : instr.GetParameterExprs<MLIL_SEPARATE_PARAM_LIST>())
+			LegacyVisitExprs(i, func);
+		break;
+	case MLIL_SHARED_PARAM_SLOT:
+		for (auto i : instr.GetParameterExprs<MLIL_SHARED_PARAM_SLOT>())
+			LegacyVisitExprs(i, func);
+		break;
+	case MLIL_RET:
+		for (auto i : instr.GetSourceExprs<MLIL_RET>())
+			LegacyVisitExprs(i, func);
+		break;
+	case MLIL_STORE:
+		LegacyVisitExprs(instr.GetDestExpr<MLIL_STORE>(), func);
+		LegacyVisitExprs(instr.GetSourceExpr<MLIL_STORE>(), func);
+		break;
+	case MLIL_STORE_STRUCT:
+		LegacyVisitExprs(instr.GetDestExpr<MLIL_STORE_STRUCT>(), func);
+		LegacyVisitExprs(instr.GetSourceExpr<MLIL_STORE_STRUCT>(), func);
+		break;
+	case MLIL_STORE_SSA:
+		LegacyVisitExprs(instr.GetDestExpr<MLIL_STORE_SSA>(), func);
+		LegacyVisitExprs(instr.GetSourceExpr<MLIL_STORE_SSA>(), func);
+		break;
+	case MLIL_STORE_STRUCT_SSA:
+		LegacyVisitExprs(instr.GetDestExpr<MLIL_STORE_STRUCT_SSA>(), func);
+		LegacyVisitExprs(instr.GetSourceExpr<MLIL_STORE_STRUCT_SSA>(), func);
+		break;
+	case MLIL_NEG:
+	case MLIL_NOT:
+	case MLIL_SX:
+	case MLIL_ZX:
+	case MLIL_LOW_PART:
+	case MLIL_BOOL_TO_INT:
+	case MLIL_JUMP:
+	case MLIL_JUMP_TO:
+	case MLIL_RET_HINT:
+	case MLIL_IF:
+	case MLIL_UNIMPL_MEM:
+	case MLIL_LOAD:
+	case MLIL_LOAD_STRUCT:
+	case MLIL_LOAD_SSA:
+	case MLIL_LOAD_STRUCT_SSA:
+	case MLIL_FSQRT:
+	case MLIL_FNEG:
+	case MLIL_FABS:
+	case MLIL_FLOAT_TO_INT:
+	case MLIL_INT_TO_FLOAT:
+	case MLIL_FLOAT_CONV:
+	case MLIL_ROUND_TO_INT:
+	case MLIL_FLOOR:
+	case MLIL_CEIL:
+	case MLIL_FTRUNC:
+		LegacyVisitExprs(instr.AsOneOperand().GetSourceExpr(), func);
+		break;
+	case MLIL_ADD:
+	case MLIL_SUB:
+	case MLIL_AND:
+	case MLIL_OR:
+	case MLIL_XOR:
+	case MLIL_LSL:
+	case MLIL_LSR:
+	case MLIL_ASR:
+	case MLIL_ROL:
+	case MLIL_ROR:
+	case MLIL_MUL:
+	case MLIL_MULU_DP:
+	case MLIL_MULS_DP:
+	case MLIL_DIVU:
+	case MLIL_DIVS:
+	case MLIL_MODU:
+	case MLIL_MODS:
+	case MLIL_DIVU_DP:
+	case MLIL_DIVS_DP:
+	case MLIL_MODU_DP:
+	case MLIL_MODS_DP:
+	case MLIL_CMP_E:
+	case MLIL_CMP_NE:
+	case MLIL_CMP_SLT:
+	case MLIL_CMP_ULT:
+	case MLIL_CMP_SLE:
+	case MLIL_CMP_ULE:
+	case MLIL_CMP_SGE:
+	case MLIL_CMP_UGE:
+	case MLIL_CMP_SGT:
+	case MLIL_CMP_UGT:
+	case MLIL_TEST_BIT:
+	case MLIL_ADD_OVERFLOW:
+	case MLIL_FADD:
+	case MLIL_FSUB:
+	case MLIL_FMUL:
+	case MLIL_FDIV:
+	case MLIL_FCMP_E:
+	case MLIL_FCMP_NE:
+	case MLIL_FCMP_LT:
+	case MLIL_FCMP_LE:
+	case MLIL_FCMP_GE:
+	case MLIL_FCMP_GT:
+	case MLIL_FCMP_O:
+	case MLIL_FCMP_UO:
+		LegacyVisitExprs(instr.AsTwoOperand().GetLeftExpr(), func);
+		LegacyVisitExprs(instr.AsTwoOperand().GetRightExpr(), func);
+		break;
+	case MLIL_ADC:
+	case MLIL_SBB:
+	case MLIL_RLC:
+	case MLIL_RRC:
+		LegacyVisitExprs(instr.AsTwoOperandWithCarry().GetLeftExpr(), func);
+		LegacyVisitExprs(instr.AsTwoOperandWithCarry().GetRightExpr(), func);
+		LegacyVisitExprs(instr.AsTwoOperandWithCarry().GetCarryExpr(), func);
+		break;
+	case MLIL_INTRINSIC:
+		for (auto i : instr.GetParameterExprs<MLIL_INTRINSIC>())
+			LegacyVisitExprs(i, func);
+		break;
+	case MLIL_INTRINSIC_SSA:
+	case MLIL_MEMORY_INTRINSIC_SSA:
+		for (auto i : instr.GetParameterExprs())
+			LegacyVisitExprs(i, func);
+		break;
+	default:
+		break;
+	}
+}
+
+
+static void LegacyCollectSubExprs(const HighLevelILInstruction& instr, stack<size_t>& toProcess)
+{
+	vector<HighLevelILInstruction> exprs;
+	switch (instr.operation)
+	{
+	case HLIL_BLOCK:
+		exprs = instr.GetBlockExprs<HLIL_BLOCK>();
+		for (auto i = exprs.rbegin(); i != exprs.rend(); ++i)
+			toProcess.push(i->exprIndex);
+		break;
+	case HLIL_IF:
+		if (instr.ast)
+		{
+			toProcess.push(instr.GetFalseExpr<HLIL_IF>().exprIndex);
+			toProcess.push(instr.GetTrueExpr<HLIL_IF>().exprIndex);
+		}
+		toProcess.push(instr.GetConditionExpr<HLIL_IF>().exprIndex);
+		break;
+	case HLIL_WHILE:
+		if (instr.ast)
+			toProcess.push(instr.GetLoopExpr<HLIL_WHILE>().exprIndex);
+		toProcess.push(instr.GetConditionExpr<HLIL_WHILE>().exprIndex);
+		break;
+	case HLIL_WHILE_SSA:
+		if (instr.ast)
+			toProcess.push(instr.GetLoopExpr<HLIL_WHILE_SSA>().exprIndex);
+		toProcess.push(instr.GetConditionExpr<HLIL_WHILE_SSA>().exprIndex);
+		toProcess.push(instr.GetConditionPhiExpr<HLIL_WHILE_SSA>().exprIndex);
+		break;
+	case HLIL_DO_WHILE:
+		toProcess.push(instr.GetConditionExpr<HLIL_DO_WHILE>().exprIndex);
+		if (instr.ast)
+			toProcess.push(instr.GetLoopExpr<HLIL_DO_WHILE>().exprIndex);
+		break;
+	case HLIL_DO_WHILE_SSA:
+		toProcess.push(instr.GetConditionExpr<HLIL_DO_WHILE_SSA>().exprIndex);
+		toProcess.push(instr.GetConditionPhiExpr<HLIL_DO_WHILE_SSA>().exprIndex);
+		if (instr.ast)
+			toProcess.push(instr.GetLoopExpr<HLIL_DO_WHILE_SSA>().exprIndex);
+		break;
+	case HLIL_FOR:
+		if (instr.ast)
+			toProcess.push(instr.GetLoopExpr<HLIL_FOR>().exprIndex);
+		toProcess.push(instr.GetUpdateExpr<HLIL_FOR>().exprIndex);
+		toProcess.push(instr.GetConditionExpr<HLIL_FOR>().exprIndex);
+		toProcess.push(instr.GetInitExpr<HLIL_FOR>().exprIndex);
+		break;
+	case HLIL_FOR_SSA:
+		if (instr.ast)
+			toProcess.push(instr.GetLoopExpr<HLIL_FOR_SSA>().exprIndex);
+		toProcess.push(instr.GetUpdateExpr<HLIL_FOR_SSA>().exprIndex);
+		toProcess.push(instr.GetConditionExpr<HLIL_FOR_SSA>().exprIndex);
+		toProcess.push(instr.GetConditionPhiExpr<HLIL_FOR_SSA>().exprIndex);
+		toProcess.push(instr.GetInitExpr<HLIL_FOR_SSA>().exprIndex);
+		break;
+	case HLIL_SWITCH:
+		if (instr.ast)
+		{
+			exprs = instr.GetCases<HLIL_SWITCH>();
+			for (auto i = exprs.rbegin(); i != exprs.rend(); ++i)
+				toProcess.push(i->exprIndex);
+			toProcess.push(instr.GetDefaultExpr<HLIL_SWITCH>().exprIndex);
+		}
+		toProcess.push(instr.GetConditionExpr<HLIL_SWITCH>().exprIndex);
+		break;
+	case HLIL_CASE:
+		if (instr.ast)
+			toProcess.push(instr.GetTrueExpr<HLIL_CASE>().exprIndex);
+		exprs = instr.GetValueExprs<HLIL_CASE>();
+		for (auto i = exprs.rbegin(); i != exprs.rend(); ++i)
+			toProcess.push(i->exprIndex);
+		break;
+	case HLIL_VAR_INIT:
+		toProcess.push(instr.GetSourceExpr<HLIL_VAR_INIT>().exprIndex);
+		break;
+	case HLIL_VAR_INIT_SSA:
+		toProcess.push(instr.GetSourceExpr<HLIL_VAR_INIT_SSA>().exprIndex);
+		break;
+	case HLIL_ASSIGN:
+		toProcess.push(instr.GetDestExpr<HLIL_ASSIGN>().exprIndex);
+		toProcess.push(instr.GetSourceExpr<HLIL_ASSIGN>().exprIndex);
+		break;
+	case HLIL_ASSIGN_UNPACK:
+		exprs = instr.GetDestExprs<HLIL_ASSIGN_UNPACK>();
+		for (auto i = exprs.rbegin(); i != exprs.rend(); ++i)
+			toProcess.push(i->exprIndex);
+		toProcess.push(instr.GetSourceExpr<HLIL_ASSIGN_UNPACK>().exprIndex);
+		break;
+	case HLIL_ASSIGN_MEM_SSA:
+		toProcess.push(instr.GetDestExpr<HLIL_ASSIGN_MEM_SSA>().exprIndex);
+		toProcess.push(instr.GetSourceExpr<HLIL_ASSIGN_MEM_SSA>().exprIndex);
+		break;
+	case HLIL_ASSIGN_UNPACK_MEM_SSA:
+		exprs = instr.GetDestExprs<HLIL_ASSIGN_UNPACK_MEM_SSA>();
+		for (auto i = exprs.rbegin(); i != exprs.rend(); ++i)
+			toProcess.push(i->exprIndex);
+		toProcess.push(instr.GetSourceExpr<HLIL_ASSIGN_UNPACK_MEM_SSA>().exprIndex);
+		break;
+	case HLIL_STRUCT_FIELD:
+		toProcess.push(instr.GetSourceExpr<HLIL_STRUCT_FIELD>().exprIndex);
+		break;
+	case HLIL_ARRAY_INDEX:
+		toProcess.push(instr.GetSourceExpr<HLIL_ARRAY_INDEX>().exprIndex);
+		toProcess.push(instr.GetIndexExpr<HLIL_ARRAY_INDEX>().exprIndex);
+		break;
+	case HLIL_ARRAY_INDEX_SSA:
+		toProcess.push(instr.GetSourceExpr<HLIL_ARRAY_INDEX_SSA>().exprIndex);
+		toProcess.push(instr.GetIndexExpr<HLIL_ARRAY_INDEX_SSA>().exprIndex);
+		break;
+	case HLIL_SPLIT:
+		toProcess.push(instr.GetLowExpr<HLIL_SPLIT>().exprIndex);
+		toProcess.push(instr.GetHighExpr<HLIL_SPLIT>().exprIndex);
+		break;
+	case HLIL_DEREF_FIELD:
+		toProcess.push(instr.GetSourceExpr<HLIL_DEREF_FIELD>().exprIndex);
+		break;
+	case HLIL_DEREF_SSA:
+		toProcess.push(instr.GetSourceExpr<HLIL_DEREF_SSA>().exprIndex);
+		break;
+	case HLIL_DEREF_FIELD_SSA:
+		toProcess.push(instr.GetSourceExpr<HLIL_DEREF_FIELD_SSA>().exprIndex);
+		break;
+	case HLIL_CALL:
+		toProcess.push(instr.GetDestExpr<HLIL_CALL>().exprIndex);
+		exprs = instr.GetParameterExprs<HLIL_CALL>();
+		for (auto i = exprs.rbegin(); i != exprs.rend(); ++i)
+			toProcess.push(i->exprIndex);
+		break;
+	case HLIL_SYSCALL:
+		exprs = instr.GetParameterExprs<HLIL_SYSCALL>();
+		for (auto i = exprs.rbegin(); i != exprs.rend(); ++i)
+			toProcess.push(i->exprIndex);
+		break;
+	case HLIL_TAILCALL:
+		toProcess.push(instr.GetDestExpr<HLIL_TAILCALL>().exprIndex);
+		exprs = instr.GetParameterExprs<HLIL_TAILCALL>();
+		for (auto i = exprs.rbegin(); i != exprs.rend(); ++i)
+			toProcess.push(i->exprIndex);
+		break;
+	case HLIL_CALL_SSA:
+		toProcess.push(instr.GetDestExpr<HLIL_CALL_SSA>().exprIndex);
+		exprs = instr.GetParameterExprs<HLIL_CALL_SSA>();
+		for (auto i = exprs.rbegin(); i != exprs.rend(); ++i)
+			toProcess.push(i->exprIndex);
+		break;
+	case HLIL_SYSCALL_SSA:
+		exprs = instr.GetParameterExprs<HLIL_SYSCALL_SSA>();
+		for (auto i = exprs.rbegin(); i != exprs.rend(); ++i)
+			toProcess.push(i->exprIndex);
+		break;
+	case HLIL_RET:
+		exprs = instr.GetSourceExprs<HLIL_RET>();
+		for (auto i = exprs.rbegin(); i != exprs.rend(); ++i)
+			toProcess.push(i->exprIndex);
+		break;
+	case HLIL_DEREF:
+	case HLIL_ADDRESS_OF:
+	case HLIL_NEG:
+	case HLIL_NOT:
+	case HLIL_SX:
+	case HLIL_ZX:
+	case HLIL_LOW_PART:
+	case HLIL_BOOL_TO_INT:
+	case HLIL_JUMP:
+	case HLIL_UNIMPL_MEM:
+	case HLIL_FSQRT:
+	case HLIL_FNEG:
+	case HLIL_FABS:
+	case HLIL_FLOAT_TO_INT:
+	case HLIL_INT_TO_FLOAT:
+	case HLIL_FLOAT_CONV:
+	case HLIL_ROUND_TO_INT:
+	case HLIL_FLOOR:
+	case HLIL_CEIL:
+	case HLIL_FTRUNC:
+		toProcess.push(instr.AsOneOperand().GetSourceExpr().exprIndex);
+		break;
+	case HLIL_ADD:
+	case HLIL_SUB:
+	case HLIL_AND:
+	case HLIL_OR:
+	case HLIL_XOR:
+	case HLIL_LSL:
+	case HLIL_LSR:
+	case HLIL_ASR:
+	case HLIL_ROL:
+	case HLIL_ROR:
+	case HLIL_MUL:
+	case HLIL_MULU_DP:
+	case HLIL_MULS_DP:
+	case HLIL_DIVU:
+	case HLIL_DIVS:
+	case HLIL_MODU:
+	case HLIL_MODS:
+	case HLIL_DIVU_DP:
+	case HLIL_DIVS_DP:
+	case HLIL_MODU_DP:
+	case HLIL_MODS_DP:
+	case HLIL_CMP_E:
+	case HLIL_CMP_NE:
+	case HLIL_CMP_SLT:
+	case HLIL_CMP_ULT:
+	case HLIL_CMP_SLE:
+	case HLIL_CMP_ULE:
+	case HLIL_CMP_SGE:
+	case HLIL_CMP_UGE:
+	case HLIL_CMP_SGT:
+	case HLIL_CMP_UGT:
+	case HLIL_TEST_BIT:
+	case HLIL_ADD_OVERFLOW:
+	case HLIL_FADD:
+	case HLIL_FSUB:
+	case HLIL_FMUL:
+	case HLIL_FDIV:
+	case HLIL_FCMP_E:
+	case HLIL_FCMP_NE:
+	case HLIL_FCMP_LT:
+	case HLIL_FCMP_LE:
+	case HLIL_FCMP_GE:
+	case HLIL_FCMP_GT:
+	case HLIL_FCMP_O:
+	case HLIL_FCMP_UO:
+		toProcess.push(instr.AsTwoOperand().GetRightExpr().exprIndex);
+		toProcess.push(instr.AsTwoOperand().GetLeftExpr().exprIndex);
+		break;
+	case HLIL_ADC:
+	case HLIL_SBB:
+	case HLIL_RLC:
+	case HLIL_RRC:
+		toProcess.push(instr.AsTwoOperandWithCarry().GetCarryExpr().exprIndex);
+		toProcess.push(instr.AsTwoOperandWithCarry().GetRightExpr().exprIndex);
+		toProcess.push(instr.AsTwoOperandWithCarry().GetLeftExpr().exprIndex);
+		break;
+	case HLIL_INTRINSIC:
+		exprs = instr.GetParameterExprs<HLIL_INTRINSIC>();
+		for (auto i = exprs.rbegin(); i != exprs.rend(); ++i)
+			toProcess.push(i->exprIndex);
+		break;
+	case HLIL_INTRINSIC_SSA:
+		exprs = instr.GetParameterExprs<HLIL_INTRINSIC_SSA>();
+		for (auto i = exprs.rbegin(); i != exprs.rend(); ++i)
+			toProcess.push(i->exprIndex);
+		break;
+	default:
+		break;
+	}
+}
+
+
+static void LegacyVisitExprs(
+	const HighLevelILInstruction& instr, const function<bool(const HighLevelILInstruction& expr)>& func)
+{
+	stack<size_t> toProcess;
+	toProcess.push(instr.exprIndex);
+	while (!toProcess.empty())
+	{
+		HighLevelILInstruction cur = instr.function->GetExpr(toProcess.top(), instr.ast);
+		toProcess.pop();
+		if (!func(cur))
+			continue;
+		LegacyCollectSubExprs(cur, toProcess);
+	}
+}
+
+
+struct BenchResult
+{
+	size_t exprs = 0;
+	double seconds = 0;
+};
+
+
+template <typename Instruction, typename Walk>
+static BenchResult Time(const vector<Instruction>& roots, size_t iterations, Walk&& walk)
+{
+	BenchResult result;
+	auto start = chrono::steady_clock::now();
+	for (size_t i = 0; i < iterations; i++)
+		for (auto& root : roots)
+			result.exprs += walk(root);
+	result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	return result;
+}
+
+
+template <typename Instruction>
+static void Compare(const char* name, const vector<Instruction>& roots, size_t iterations)
+{
+	BenchResult legacy = Time(roots, iterations, [](const Instruction& root) {
+		size_t count = 0;
+		LegacyVisitExprs(root, [&](const Instruction&) {
+			count++;
+			return true;
+		});
+		return count;
+	});
+	BenchResult visitor = Time(roots, iterations, [](const Instruction& root) {
+		size_t count = 0;
+		root.VisitExprs([&](const Instruction&) {
+			count++;
+			return true;
+		});
+		return count;
+	});
+
+	printf("%s: %" PRIuPTR " roots\n", name, roots.size());
+	printf("    previous VisitExprs: %10" PRIuPTR " exprs in %8.3fs\n", legacy.exprs, legacy.seconds);
+	printf("    VisitExprs<F>:       %10" PRIuPTR " exprs in %8.3fs (%.2fx)\n", visitor.exprs, visitor.seconds,
+		visitor.seconds > 0 ? legacy.seconds / visitor.seconds : 0.0);
+}
+
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2 || argc > 3)
+	{
+		fprintf(stderr, "Usage: %s <file> [iterations]\n", argv[0]);
+		return 1;
+	}
+	size_t iterations = (argc == 3) ? strtoul(argv[2], nullptr, 0) : 5;
+
+	// In order to initiate the bundled plugins properly, the location
+	// of where bundled plugins directory is must be set.
+	SetBundledPluginDirectory(GetBundledPluginDirectory());
+	InitPlugins();
+
+	Ref<BinaryView> bv = BinaryNinja::Load(argv[1]);
+	if (!bv || bv->GetTypeName() == "Raw")
+	{
+		fprintf(stderr, "Input file does not appear to be an executable\n");
+		return -1;
+	}
+
+	// Gather all the roots up front so IL generation isn't part of the measurement
+	vector<LowLevelILInstruction> llil;
+	vector<MediumLevelILInstruction> mlil;
+	vector<HighLevelILInstruction> hlil;
+	for (auto& func : bv->GetAnalysisFunctionList())
+	{
+		if (Ref<LowLevelILFunction> il = func->GetLowLevelIL())
+			for (size_t i = 0; i < il->GetInstructionCount(); i++)
+				llil.push_back(il->GetInstruction(i));
+		if (Ref<MediumLevelILFunction> il = func->GetMediumLevelIL())
+			for (size_t i = 0; i < il->GetInstructionCount(); i++)
+				mlil.push_back(il->GetInstruction(i));
+		if (Ref<HighLevelILFunction> il = func->GetHighLevelIL())
+			hlil.push_back(il->GetRootExpr());
+	}
+
+	Compare("LLIL", llil, iterations);
+	Compare("MLIL", mlil, iterations);
+	Compare("HLIL", hlil, iterations);
+
+	// Close the file so that the resources can be freed
+	bv->GetFile()->Close();
+
+	// Shutting down is required to allow for clean exit of the core
+	BNShutdown();
+
+	return 0;
+}
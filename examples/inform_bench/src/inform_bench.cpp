@@ -0,0 +1,91 @@
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include "binaryninjacore.h"
+#include "binaryninjaapi.h"
+
+using namespace BinaryNinja;
+using namespace std;
+
+// Compares the per-call cost of the typed AnalysisContext::Inform against building the same request as a
+// Json::Value and serializing it, the way Inform requests used to be sent. Requests go to an analysis context that
+// isn't attached to a function, so the core side of each call is as cheap as it gets and the difference is the
+// encoding.
+
+
+template <typename Request>
+static double Time(size_t iterations, Request&& request)
+{
+	auto start = chrono::steady_clock::now();
+	for (size_t i = 0; i < iterations; i++)
+		request(0x401000 + i * 4);
+	return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+
+static void Report(const char* name, size_t iterations, double json, double typed)
+{
+	printf("%s: %" PRIuPTR " calls\n", name, iterations);
+	printf("    Json::Value + writeString: %8.1f ns/call\n", json * 1e9 / iterations);
+	printf("    typed Inform:              %8.1f ns/call (%.2fx)\n", typed * 1e9 / iterations,
+		typed > 0 ? json / typed : 0.0);
+}
+
+
+int main(int argc, char* argv[])
+{
+	if (argc > 2)
+	{
+		fprintf(stderr, "Usage: %s [iterations]\n", argv[0]);
+		return 1;
+	}
+	size_t iterations = (argc == 2) ? strtoul(argv[1], nullptr, 0) : 1000000;
+
+	// In order to initiate the bundled plugins properly, the location
+	// of where bundled plugins directory is must be set.
+	SetBundledPluginDirectory(GetBundledPluginDirectory());
+	InitPlugins();
+
+	Ref<Architecture> arch = Architecture::GetByName("x86_64");
+	if (!arch)
+	{
+		fprintf(stderr, "x86_64 architecture is not available\n");
+		return -1;
+	}
+
+	Ref<AnalysisContext> context = new AnalysisContext(BNCreateAnalysisContext());
+	Json::StreamWriterBuilder builder;
+	builder["indentation"] = "";
+
+	double json = Time(iterations, [&](uint64_t addr) {
+		Json::Value request(Json::arrayValue);
+		request.append("directRefs");
+		request.append("insert");
+		request.append(Json::Value(addr + 0x100));
+		request.append(arch->GetName());
+		request.append(Json::Value(addr));
+		context->Inform(Json::writeString(builder, request));
+	});
+	double typed = Time(iterations,
+		[&](uint64_t addr) { context->Inform("directRefs", "insert", addr + 0x100, arch, addr); });
+	Report("directRefs", iterations, json, typed);
+
+	json = Time(iterations, [&](uint64_t addr) {
+		Json::Value request(Json::arrayValue);
+		request.append("directNoReturnCalls");
+		request.append("insert");
+		request.append(arch->GetName());
+		request.append(Json::Value(addr));
+		context->Inform(Json::writeString(builder, request));
+	});
+	typed = Time(iterations, [&](uint64_t addr) { context->Inform("directNoReturnCalls", "insert", arch, addr); });
+	Report("directNoReturnCalls", iterations, json, typed);
+
+	context = nullptr;
+
+	// Shutting down is required to allow for clean exit of the core
+	BNShutdown();
+
+	return 0;
+}
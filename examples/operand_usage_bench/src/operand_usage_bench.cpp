@@ -0,0 +1,148 @@
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include "binaryninjacore.h"
+#include "binaryninjaapi.h"
+#include "lowlevelilinstruction.h"
+#include "mediumlevelilinstruction.h"
+#include "highlevelilinstruction.h"
+
+using namespace BinaryNinja;
+using namespace std;
+
+// Times resolving operands by usage, which is what every GetSourceExpr, GetDestExpr, etc. does first, over every
+// expression of the largest function in a binary. The dense tables behind GetOperandIndexForUsage are compared with
+// looking the operation and usage up in the operationOperandIndex hash maps.
+
+
+template <typename Instruction>
+static vector<Instruction> GetAllExprs(Instruction root)
+{
+	vector<Instruction> result;
+	root.VisitExprs([&](const Instruction& expr) { result.push_back(expr); });
+	return result;
+}
+
+
+template <typename Instruction, typename Base>
+static void Compare(const char* name, const vector<Instruction>& exprs, size_t iterations)
+{
+	using Usage = typename decltype(Base::operandTypeForUsage)::key_type;
+	vector<Usage> usages;
+	for (auto& i : Base::operandTypeForUsage)
+		usages.push_back(i.first);
+
+	size_t mapFound = 0;
+	auto start = chrono::steady_clock::now();
+	for (size_t i = 0; i < iterations; i++)
+	{
+		for (auto& expr : exprs)
+		{
+			for (auto usage : usages)
+			{
+				auto operation = Base::operationOperandIndex.find(expr.operation);
+				if (operation == Base::operationOperandIndex.end())
+					continue;
+				auto index = operation->second.find(usage);
+				if (index != operation->second.end())
+					mapFound += index->second + 1;
+			}
+		}
+	}
+	double mapSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	size_t denseFound = 0;
+	start = chrono::steady_clock::now();
+	for (size_t i = 0; i < iterations; i++)
+	{
+		for (auto& expr : exprs)
+		{
+			for (auto usage : usages)
+			{
+				size_t index;
+				if (expr.GetOperandIndexForUsage(usage, index))
+					denseFound += index + 1;
+			}
+		}
+	}
+	double denseSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	size_t lookups = exprs.size() * usages.size() * iterations;
+	printf("%s: %" PRIuPTR " exprs, %" PRIuPTR " lookups\n", name, exprs.size(), lookups);
+	printf("    hash maps:    %8.3fs\n", mapSeconds);
+	printf("    dense tables: %8.3fs (%.2fx)%s\n", denseSeconds, denseSeconds > 0 ? mapSeconds / denseSeconds : 0.0,
+		mapFound == denseFound ? "" : " MISMATCH");
+}
+
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2 || argc > 3)
+	{
+		fprintf(stderr, "Usage: %s <file> [iterations]\n", argv[0]);
+		return 1;
+	}
+	size_t iterations = (argc == 3) ? strtoul(argv[2], nullptr, 0) : 100;
+
+	// In order to initiate the bundled plugins properly, the location
+	// of where bundled plugins directory is must be set.
+	SetBundledPluginDirectory(GetBundledPluginDirectory());
+	InitPlugins();
+
+	Ref<BinaryView> bv = BinaryNinja::Load(argv[1]);
+	if (!bv || bv->GetTypeName() == "Raw")
+	{
+		fprintf(stderr, "Input file does not appear to be an executable\n");
+		return -1;
+	}
+
+	Ref<Function> largest;
+	size_t largestSize = 0;
+	for (auto& func : bv->GetAnalysisFunctionList())
+	{
+		Ref<LowLevelILFunction> il = func->GetLowLevelIL();
+		if (il && il->GetExprCount() > largestSize)
+		{
+			largest = func;
+			largestSize = il->GetExprCount();
+		}
+	}
+	if (!largest)
+	{
+		fprintf(stderr, "No functions with IL found\n");
+		return -1;
+	}
+	printf("Largest function: %s @ 0x%" PRIx64 "\n", largest->GetSymbol()->GetFullName().c_str(), largest->GetStart());
+
+	// Gather the expressions up front so IL generation isn't part of the measurement
+	vector<LowLevelILInstruction> llil;
+	vector<MediumLevelILInstruction> mlil;
+	vector<HighLevelILInstruction> hlil;
+	if (Ref<LowLevelILFunction> il = largest->GetLowLevelIL())
+	{
+		for (size_t i = 0; i < il->GetInstructionCount(); i++)
+			for (auto& expr : GetAllExprs(il->GetInstruction(i)))
+				llil.push_back(expr);
+	}
+	if (Ref<MediumLevelILFunction> il = largest->GetMediumLevelIL())
+	{
+		for (size_t i = 0; i < il->GetInstructionCount(); i++)
+			for (auto& expr : GetAllExprs(il->GetInstruction(i)))
+				mlil.push_back(expr);
+	}
+	if (Ref<HighLevelILFunction> il = largest->GetHighLevelIL())
+		hlil = GetAllExprs(il->GetRootExpr());
+
+	Compare<LowLevelILInstruction, LowLevelILInstructionBase>("LLIL", llil, iterations);
+	Compare<MediumLevelILInstruction, MediumLevelILInstructionBase>("MLIL", mlil, iterations);
+	Compare<HighLevelILInstruction, HighLevelILInstructionBase>("HLIL", hlil, iterations);
+
+	// Close the file so that the resources can be freed
+	bv->GetFile()->Close();
+
+	// Shutting down is required to allow for clean exit of the core
+	BNShutdown();
+
+	return 0;
+}
@@ -25,26 +25,27 @@ extern "C"
 {
 	BN_DECLARE_CORE_ABI_VERSION
 
-	// TODO: Replace with analysis cache opaque datastore.
-	std::mutex g_mutex;
-	unordered_map<void*, unordered_map<uint64_t, set<uint64_t>>> g_callSiteInlines;
+	struct InlinedCallSites
+	{
+		std::mutex mutex;
+		set<uint64_t> addrs;
+	};
+
+	static const char* g_callSitesKey = "extension.functionInliner.callSites";
 
 	void FunctionInliner(Ref<AnalysisContext> analysisContext)
 	{
-		std::unique_lock<std::mutex> lock(g_mutex);
-
 		Ref<Function> function = analysisContext->GetFunction();
 		Ref<BinaryView> data = function->GetView();
-		auto gItr = g_callSiteInlines.find(data->GetObject());
-		if (gItr == g_callSiteInlines.end())
+		auto callSites = AnalysisDataStore::Get<InlinedCallSites>(function, g_callSitesKey);
+		if (!callSites)
 			return;
 
-		auto itr = gItr->second.find(function->GetStart());
-		if (itr == gItr->second.end())
-			return;
-
-		auto& callSiteInlines = itr->second;
-		lock.unlock();
+		set<uint64_t> callSiteInlines;
+		{
+			std::lock_guard<std::mutex> lock(callSites->mutex);
+			callSiteInlines = callSites->addrs;
+		}
 
 		bool updated = false;
 		uint8_t opcode[BN_MAX_INSTRUCTION_LENGTH];
@@ -152,8 +153,11 @@ extern "C"
 		    [](BinaryView* view, Function* func) {
 			    // TODO func->Inform("inlinedCallSites")
 			    // TODO resolve multiple embedded inlines
-			    std::lock_guard<std::mutex> lock(g_mutex);
-			    g_callSiteInlines[view->GetObject()][func->GetStart()].insert(view->GetCurrentOffset());
+			    auto callSites = AnalysisDataStore::GetOrCreate<InlinedCallSites>(func, g_callSitesKey);
+			    {
+				    std::lock_guard<std::mutex> lock(callSites->mutex);
+				    callSites->addrs.insert(view->GetCurrentOffset());
+			    }
 			    func->Reanalyze();
 		    },
 		    inlinerIsValid);
@@ -217,6 +217,70 @@ size_t HighLevelILFunction::GetExprCount() const
 }
 
 
+HighLevelILFunctionSnapshot HighLevelILFunction::Snapshot(bool asFullAst)
+{
+	HighLevelILFunctionSnapshot result;
+	auto& storage = *result.m_storage;
+	size_t exprCount = GetExprCount();
+	size_t instrCount = GetInstructionCount();
+	storage.Reserve(exprCount, instrCount);
+	for (size_t i = 0; i < exprCount; i++)
+		storage.AddExpr(asFullAst ? GetRawExpr(i) : GetRawNonASTExpr(i), GetInstructionForExpr(i));
+	for (size_t i = 0; i < instrCount; i++)
+		storage.instructionExprs.push_back(GetIndexForInstruction(i));
+	result.m_rootExpr = BNGetHighLevelILRootExpr(m_object);
+
+	size_t varCount;
+	BNVariable* vars = BNGetHighLevelILVariables(m_object, &varCount);
+	vector<SSAVariable> ssaVars;
+	for (size_t i = 0; i < varCount; i++)
+	{
+		size_t versionCount;
+		size_t* versions = BNGetHighLevelILVariableSSAVersions(m_object, &vars[i], &versionCount);
+		for (size_t j = 0; j < versionCount; j++)
+			ssaVars.emplace_back(vars[i], versions[j]);
+		BNFreeILInstructionList(versions);
+	}
+	BNFreeVariableList(vars);
+
+	sort(ssaVars.begin(), ssaVars.end());
+	ssaVars.erase(unique(ssaVars.begin(), ssaVars.end()), ssaVars.end());
+	for (auto& var : ssaVars)
+	{
+		size_t count;
+		size_t* uses = BNGetHighLevelILSSAVarUses(m_object, &var.var, var.version, &count);
+		result.m_ssaVariables.Add(var, GetSSAVarDefinition(var), uses, count);
+		BNFreeILInstructionList(uses);
+	}
+
+	// There is no list of memory versions, so take the ones defined by the copied expressions along with the
+	// version live at the first instruction, which covers the entry version that has no definition
+	vector<size_t> memoryVersions;
+	if (instrCount != 0)
+		memoryVersions.push_back(BNGetHighLevelILSSAMemoryVersionAtILInstruction(m_object, 0));
+	for (size_t i = 0; i < exprCount; i++)
+	{
+		auto usages = HighLevelILInstructionBase::operationOperandIndex.find(storage.operations[i]);
+		if (usages == HighLevelILInstructionBase::operationOperandIndex.end())
+			continue;
+		ILSnapshotExpr<BNHighLevelILInstruction> expr(&storage, i);
+		if (auto dest = usages->second.find(DestMemoryVersionHighLevelOperandUsage); dest != usages->second.end())
+			memoryVersions.push_back(expr.GetRawOperand(dest->second));
+	}
+	sort(memoryVersions.begin(), memoryVersions.end());
+	memoryVersions.erase(unique(memoryVersions.begin(), memoryVersions.end()), memoryVersions.end());
+	for (size_t version : memoryVersions)
+	{
+		size_t count;
+		size_t* uses = BNGetHighLevelILSSAMemoryUses(m_object, version, &count);
+		result.m_ssaMemory.Add(version, GetSSAMemoryDefinition(version), uses, count);
+		BNFreeILInstructionList(uses);
+	}
+
+	return result;
+}
+
+
 vector<Ref<BasicBlock>> HighLevelILFunction::GetBasicBlocks() const
 {
 	size_t count;
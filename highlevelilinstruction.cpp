@@ -31,6 +31,7 @@ using namespace BinaryNinjaCore;
 	#include "mediumlevelilinstruction.h"
 using namespace BinaryNinja;
 #endif
+#include "iloperandindex.h"
 
 #ifndef BINARYNINJACORE_LIBRARY
 using namespace std;
@@ -235,6 +236,12 @@ unordered_map<BNHighLevelILOperation, unordered_map<HighLevelILOperandUsage, siz
     HighLevelILInstructionBase::operationOperandIndex = GetOperandIndexForOperandUsages();
 
 
+// Built from the maps above, so it has to follow them
+static const ILOperandIndexTable<BNHighLevelILOperation, HighLevelILOperandUsage, HighLevelILOperandType>
+    operandIndexTable(HighLevelILInstructionBase::operationOperandIndex,
+        HighLevelILInstructionBase::operandTypeForUsage);
+
+
 bool HighLevelILIntegerList::ListIterator::operator==(const ListIterator& a) const
 {
 	return count == a.count;
@@ -509,10 +516,8 @@ HighLevelILOperand::HighLevelILOperand(
     m_instr(instr),
     m_usage(usage), m_operandIndex(operandIndex)
 {
-	auto i = HighLevelILInstructionBase::operandTypeForUsage.find(m_usage);
-	if (i == HighLevelILInstructionBase::operandTypeForUsage.end())
+	if (!operandIndexTable.GetOperandTypeForUsage(m_usage, m_type))
 		throw HighLevelILInstructionAccessException();
-	m_type = i->second;
 }
 
 
@@ -1037,160 +1042,158 @@ HighLevelILInstruction HighLevelILInstructionBase::GetParent() const
 }
 
 
-void HighLevelILInstruction::CollectSubExprs(stack<size_t>& toProcess) const
+// Index-only counterparts of the expression accessors, so collecting subexpressions doesn't fetch each one
+static size_t GetSubExprIndex(const HighLevelILInstruction& instr, HighLevelILOperandUsage usage)
+{
+	size_t operandIndex;
+	if (!instr.GetOperandIndexForUsage(usage, operandIndex))
+		throw HighLevelILInstructionAccessException();
+	return instr.GetRawOperandAsIndex(operandIndex);
+}
+
+
+static void AppendSubExprIndicesReversed(
+	const HighLevelILInstruction& instr, HighLevelILOperandUsage usage, vector<size_t>& toProcess)
+{
+	size_t operandIndex;
+	if (!instr.GetOperandIndexForUsage(usage, operandIndex))
+		throw HighLevelILInstructionAccessException();
+	vector<size_t> exprs = instr.GetRawOperandAsIndexList(operandIndex);
+	toProcess.insert(toProcess.end(), exprs.rbegin(), exprs.rend());
+}
+
+
+void HighLevelILInstruction::CollectSubExprs(vector<size_t>& toProcess) const
 {
-	vector<HighLevelILInstruction> exprs;
 	switch (operation)
 	{
 	case HLIL_BLOCK:
-		exprs = GetBlockExprs<HLIL_BLOCK>();
-		for (auto i = exprs.rbegin(); i != exprs.rend(); ++i)
-			toProcess.push(i->exprIndex);
+		AppendSubExprIndicesReversed(*this, BlockExprsHighLevelOperandUsage, toProcess);
 		break;
 	case HLIL_IF:
 		if (ast)
 		{
-			toProcess.push(GetFalseExpr<HLIL_IF>().exprIndex);
-			toProcess.push(GetTrueExpr<HLIL_IF>().exprIndex);
+			toProcess.push_back(GetSubExprIndex(*this, FalseExprHighLevelOperandUsage));
+			toProcess.push_back(GetSubExprIndex(*this, TrueExprHighLevelOperandUsage));
 		}
-		toProcess.push(GetConditionExpr<HLIL_IF>().exprIndex);
+		toProcess.push_back(GetSubExprIndex(*this, ConditionExprHighLevelOperandUsage));
 		break;
 	case HLIL_WHILE:
 		if (ast)
-			toProcess.push(GetLoopExpr<HLIL_WHILE>().exprIndex);
-		toProcess.push(GetConditionExpr<HLIL_WHILE>().exprIndex);
+			toProcess.push_back(GetSubExprIndex(*this, LoopExprHighLevelOperandUsage));
+		toProcess.push_back(GetSubExprIndex(*this, ConditionExprHighLevelOperandUsage));
 		break;
 	case HLIL_WHILE_SSA:
 		if (ast)
-			toProcess.push(GetLoopExpr<HLIL_WHILE_SSA>().exprIndex);
-		toProcess.push(GetConditionExpr<HLIL_WHILE_SSA>().exprIndex);
-		toProcess.push(GetConditionPhiExpr<HLIL_WHILE_SSA>().exprIndex);
+			toProcess.push_back(GetSubExprIndex(*this, LoopExprHighLevelOperandUsage));
+		toProcess.push_back(GetSubExprIndex(*this, ConditionExprHighLevelOperandUsage));
+		toProcess.push_back(GetSubExprIndex(*this, ConditionPhiExprHighLevelOperandUsage));
 		break;
 	case HLIL_DO_WHILE:
-		toProcess.push(GetConditionExpr<HLIL_DO_WHILE>().exprIndex);
+		toProcess.push_back(GetSubExprIndex(*this, ConditionExprHighLevelOperandUsage));
 		if (ast)
-			toProcess.push(GetLoopExpr<HLIL_DO_WHILE>().exprIndex);
+			toProcess.push_back(GetSubExprIndex(*this, LoopExprHighLevelOperandUsage));
 		break;
 	case HLIL_DO_WHILE_SSA:
-		toProcess.push(GetConditionExpr<HLIL_DO_WHILE_SSA>().exprIndex);
-		toProcess.push(GetConditionPhiExpr<HLIL_DO_WHILE_SSA>().exprIndex);
+		toProcess.push_back(GetSubExprIndex(*this, ConditionExprHighLevelOperandUsage));
+		toProcess.push_back(GetSubExprIndex(*this, ConditionPhiExprHighLevelOperandUsage));
 		if (ast)
-			toProcess.push(GetLoopExpr<HLIL_DO_WHILE_SSA>().exprIndex);
+			toProcess.push_back(GetSubExprIndex(*this, LoopExprHighLevelOperandUsage));
 		break;
 	case HLIL_FOR:
 		if (ast)
-			toProcess.push(GetLoopExpr<HLIL_FOR>().exprIndex);
-		toProcess.push(GetUpdateExpr<HLIL_FOR>().exprIndex);
-		toProcess.push(GetConditionExpr<HLIL_FOR>().exprIndex);
-		toProcess.push(GetInitExpr<HLIL_FOR>().exprIndex);
+			toProcess.push_back(GetSubExprIndex(*this, LoopExprHighLevelOperandUsage));
+		toProcess.push_back(GetSubExprIndex(*this, UpdateExprHighLevelOperandUsage));
+		toProcess.push_back(GetSubExprIndex(*this, ConditionExprHighLevelOperandUsage));
+		toProcess.push_back(GetSubExprIndex(*this, InitExprHighLevelOperandUsage));
 		break;
 	case HLIL_FOR_SSA:
 		if (ast)
-			toProcess.push(GetLoopExpr<HLIL_FOR_SSA>().exprIndex);
-		toProcess.push(GetUpdateExpr<HLIL_FOR_SSA>().exprIndex);
-		toProcess.push(GetConditionExpr<HLIL_FOR_SSA>().exprIndex);
-		toProcess.push(GetConditionPhiExpr<HLIL_FOR_SSA>().exprIndex);
-		toProcess.push(GetInitExpr<HLIL_FOR_SSA>().exprIndex);
+			toProcess.push_back(GetSubExprIndex(*this, LoopExprHighLevelOperandUsage));
+		toProcess.push_back(GetSubExprIndex(*this, UpdateExprHighLevelOperandUsage));
+		toProcess.push_back(GetSubExprIndex(*this, ConditionExprHighLevelOperandUsage));
+		toProcess.push_back(GetSubExprIndex(*this, ConditionPhiExprHighLevelOperandUsage));
+		toProcess.push_back(GetSubExprIndex(*this, InitExprHighLevelOperandUsage));
 		break;
 	case HLIL_SWITCH:
 		if (ast)
 		{
-			exprs = GetCases<HLIL_SWITCH>();
-			for (auto i = exprs.rbegin(); i != exprs.rend(); ++i)
-				toProcess.push(i->exprIndex);
-			toProcess.push(GetDefaultExpr<HLIL_SWITCH>().exprIndex);
+			AppendSubExprIndicesReversed(*this, CasesHighLevelOperandUsage, toProcess);
+			toProcess.push_back(GetSubExprIndex(*this, DefaultExprHighLevelOperandUsage));
 		}
-		toProcess.push(GetConditionExpr<HLIL_SWITCH>().exprIndex);
+		toProcess.push_back(GetSubExprIndex(*this, ConditionExprHighLevelOperandUsage));
 		break;
 	case HLIL_CASE:
 		if (ast)
-			toProcess.push(GetTrueExpr<HLIL_CASE>().exprIndex);
-		exprs = GetValueExprs<HLIL_CASE>();
-		for (auto i = exprs.rbegin(); i != exprs.rend(); ++i)
-			toProcess.push(i->exprIndex);
+			toProcess.push_back(GetSubExprIndex(*this, TrueExprHighLevelOperandUsage));
+		AppendSubExprIndicesReversed(*this, ValueExprsHighLevelOperandUsage, toProcess);
 		break;
 	case HLIL_VAR_INIT:
-		toProcess.push(GetSourceExpr<HLIL_VAR_INIT>().exprIndex);
+		toProcess.push_back(GetSubExprIndex(*this, SourceExprHighLevelOperandUsage));
 		break;
 	case HLIL_VAR_INIT_SSA:
-		toProcess.push(GetSourceExpr<HLIL_VAR_INIT_SSA>().exprIndex);
+		toProcess.push_back(GetSubExprIndex(*this, SourceExprHighLevelOperandUsage));
 		break;
 	case HLIL_ASSIGN:
-		toProcess.push(GetDestExpr<HLIL_ASSIGN>().exprIndex);
-		toProcess.push(GetSourceExpr<HLIL_ASSIGN>().exprIndex);
+		toProcess.push_back(GetSubExprIndex(*this, DestExprHighLevelOperandUsage));
+		toProcess.push_back(GetSubExprIndex(*this, SourceExprHighLevelOperandUsage));
 		break;
 	case HLIL_ASSIGN_UNPACK:
-		exprs = GetDestExprs<HLIL_ASSIGN_UNPACK>();
-		for (auto i = exprs.rbegin(); i != exprs.rend(); ++i)
-			toProcess.push(i->exprIndex);
-		toProcess.push(GetSourceExpr<HLIL_ASSIGN_UNPACK>().exprIndex);
+		AppendSubExprIndicesReversed(*this, DestExprsHighLevelOperandUsage, toProcess);
+		toProcess.push_back(GetSubExprIndex(*this, SourceExprHighLevelOperandUsage));
 		break;
 	case HLIL_ASSIGN_MEM_SSA:
-		toProcess.push(GetDestExpr<HLIL_ASSIGN_MEM_SSA>().exprIndex);
-		toProcess.push(GetSourceExpr<HLIL_ASSIGN_MEM_SSA>().exprIndex);
+		toProcess.push_back(GetSubExprIndex(*this, DestExprHighLevelOperandUsage));
+		toProcess.push_back(GetSubExprIndex(*this, SourceExprHighLevelOperandUsage));
 		break;
 	case HLIL_ASSIGN_UNPACK_MEM_SSA:
-		exprs = GetDestExprs<HLIL_ASSIGN_UNPACK_MEM_SSA>();
-		for (auto i = exprs.rbegin(); i != exprs.rend(); ++i)
-			toProcess.push(i->exprIndex);
-		toProcess.push(GetSourceExpr<HLIL_ASSIGN_UNPACK_MEM_SSA>().exprIndex);
+		AppendSubExprIndicesReversed(*this, DestExprsHighLevelOperandUsage, toProcess);
+		toProcess.push_back(GetSubExprIndex(*this, SourceExprHighLevelOperandUsage));
 		break;
 	case HLIL_STRUCT_FIELD:
-		toProcess.push(GetSourceExpr<HLIL_STRUCT_FIELD>().exprIndex);
+		toProcess.push_back(GetSubExprIndex(*this, SourceExprHighLevelOperandUsage));
 		break;
 	case HLIL_ARRAY_INDEX:
-		toProcess.push(GetSourceExpr<HLIL_ARRAY_INDEX>().exprIndex);
-		toProcess.push(GetIndexExpr<HLIL_ARRAY_INDEX>().exprIndex);
+		toProcess.push_back(GetSubExprIndex(*this, SourceExprHighLevelOperandUsage));
+		toProcess.push_back(GetSubExprIndex(*this, IndexExprHighLevelOperandUsage));
 		break;
 	case HLIL_ARRAY_INDEX_SSA:
-		toProcess.push(GetSourceExpr<HLIL_ARRAY_INDEX_SSA>().exprIndex);
-		toProcess.push(GetIndexExpr<HLIL_ARRAY_INDEX_SSA>().exprIndex);
+		toProcess.push_back(GetSubExprIndex(*this, SourceExprHighLevelOperandUsage));
+		toProcess.push_back(GetSubExprIndex(*this, IndexExprHighLevelOperandUsage));
 		break;
 	case HLIL_SPLIT:
-		toProcess.push(GetLowExpr<HLIL_SPLIT>().exprIndex);
-		toProcess.push(GetHighExpr<HLIL_SPLIT>().exprIndex);
+		toProcess.push_back(GetSubExprIndex(*this, LowExprHighLevelOperandUsage));
+		toProcess.push_back(GetSubExprIndex(*this, HighExprHighLevelOperandUsage));
 		break;
 	case HLIL_DEREF_FIELD:
-		toProcess.push(GetSourceExpr<HLIL_DEREF_FIELD>().exprIndex);
+		toProcess.push_back(GetSubExprIndex(*this, SourceExprHighLevelOperandUsage));
 		break;
 	case HLIL_DEREF_SSA:
-		toProcess.push(GetSourceExpr<HLIL_DEREF_SSA>().exprIndex);
+		toProcess.push_back(GetSubExprIndex(*this, SourceExprHighLevelOperandUsage));
 		break;
 	case HLIL_DEREF_FIELD_SSA:
-		toProcess.push(GetSourceExpr<HLIL_DEREF_FIELD_SSA>().exprIndex);
+		toProcess.push_back(GetSubExprIndex(*this, SourceExprHighLevelOperandUsage));
 		break;
 	case HLIL_CALL:
-		toProcess.push(GetDestExpr<HLIL_CALL>().exprIndex);
-		exprs = GetParameterExprs<HLIL_CALL>();
-		for (auto i = exprs.rbegin(); i != exprs.rend(); ++i)
-			toProcess.push(i->exprIndex);
+		toProcess.push_back(GetSubExprIndex(*this, DestExprHighLevelOperandUsage));
+		AppendSubExprIndicesReversed(*this, ParameterExprsHighLevelOperandUsage, toProcess);
 		break;
 	case HLIL_SYSCALL:
-		exprs = GetParameterExprs<HLIL_SYSCALL>();
-		for (auto i = exprs.rbegin(); i != exprs.rend(); ++i)
-			toProcess.push(i->exprIndex);
+		AppendSubExprIndicesReversed(*this, ParameterExprsHighLevelOperandUsage, toProcess);
 		break;
 	case HLIL_TAILCALL:
-		toProcess.push(GetDestExpr<HLIL_TAILCALL>().exprIndex);
-		exprs = GetParameterExprs<HLIL_TAILCALL>();
-		for (auto i = exprs.rbegin(); i != exprs.rend(); ++i)
-			toProcess.push(i->exprIndex);
+		toProcess.push_back(GetSubExprIndex(*this, DestExprHighLevelOperandUsage));
+		AppendSubExprIndicesReversed(*this, ParameterExprsHighLevelOperandUsage, toProcess);
 		break;
 	case HLIL_CALL_SSA:
-		toProcess.push(GetDestExpr<HLIL_CALL_SSA>().exprIndex);
-		exprs = GetParameterExprs<HLIL_CALL_SSA>();
-		for (auto i = exprs.rbegin(); i != exprs.rend(); ++i)
-			toProcess.push(i->exprIndex);
+		toProcess.push_back(GetSubExprIndex(*this, DestExprHighLevelOperandUsage));
+		AppendSubExprIndicesReversed(*this, ParameterExprsHighLevelOperandUsage, toProcess);
 		break;
 	case HLIL_SYSCALL_SSA:
-		exprs = GetParameterExprs<HLIL_SYSCALL_SSA>();
-		for (auto i = exprs.rbegin(); i != exprs.rend(); ++i)
-			toProcess.push(i->exprIndex);
+		AppendSubExprIndicesReversed(*this, ParameterExprsHighLevelOperandUsage, toProcess);
 		break;
 	case HLIL_RET:
-		exprs = GetSourceExprs<HLIL_RET>();
-		for (auto i = exprs.rbegin(); i != exprs.rend(); ++i)
-			toProcess.push(i->exprIndex);
+		AppendSubExprIndicesReversed(*this, SourceExprsHighLevelOperandUsage, toProcess);
 		break;
 	case HLIL_DEREF:
 	case HLIL_ADDRESS_OF:
@@ -1212,7 +1215,7 @@ void HighLevelILInstruction::CollectSubExprs(stack<size_t>& toProcess) const
 	case HLIL_FLOOR:
 	case HLIL_CEIL:
 	case HLIL_FTRUNC:
-		toProcess.push(AsOneOperand().GetSourceExpr().exprIndex);
+		toProcess.push_back(GetRawOperandAsIndex(0));
 		break;
 	case HLIL_ADD:
 	case HLIL_SUB:
@@ -1259,26 +1262,22 @@ void HighLevelILInstruction::CollectSubExprs(stack<size_t>& toProcess) const
 	case HLIL_FCMP_GT:
 	case HLIL_FCMP_O:
 	case HLIL_FCMP_UO:
-		toProcess.push(AsTwoOperand().GetRightExpr().exprIndex);
-		toProcess.push(AsTwoOperand().GetLeftExpr().exprIndex);
+		toProcess.push_back(GetRawOperandAsIndex(1));
+		toProcess.push_back(GetRawOperandAsIndex(0));
 		break;
 	case HLIL_ADC:
 	case HLIL_SBB:
 	case HLIL_RLC:
 	case HLIL_RRC:
-		toProcess.push(AsTwoOperandWithCarry().GetCarryExpr().exprIndex);
-		toProcess.push(AsTwoOperandWithCarry().GetRightExpr().exprIndex);
-		toProcess.push(AsTwoOperandWithCarry().GetLeftExpr().exprIndex);
+		toProcess.push_back(GetRawOperandAsIndex(2));
+		toProcess.push_back(GetRawOperandAsIndex(1));
+		toProcess.push_back(GetRawOperandAsIndex(0));
 		break;
 	case HLIL_INTRINSIC:
-		exprs = GetParameterExprs<HLIL_INTRINSIC>();
-		for (auto i = exprs.rbegin(); i != exprs.rend(); ++i)
-			toProcess.push(i->exprIndex);
+		AppendSubExprIndicesReversed(*this, ParameterExprsHighLevelOperandUsage, toProcess);
 		break;
 	case HLIL_INTRINSIC_SSA:
-		exprs = GetParameterExprs<HLIL_INTRINSIC_SSA>();
-		for (auto i = exprs.rbegin(); i != exprs.rend(); ++i)
-			toProcess.push(i->exprIndex);
+		AppendSubExprIndicesReversed(*this, ParameterExprsHighLevelOperandUsage, toProcess);
 		break;
 	default:
 		break;
@@ -1286,58 +1285,32 @@ void HighLevelILInstruction::CollectSubExprs(stack<size_t>& toProcess) const
 }
 
 
-void HighLevelILInstruction::VisitExprs(const std::function<bool(const HighLevelILInstruction& expr)>& func) const
+void HighLevelILInstruction::CollectSubExprs(stack<size_t>& toProcess) const
 {
-	stack<size_t> toProcess;
-	toProcess.push(exprIndex);
-	while (!toProcess.empty())
-	{
-		HighLevelILInstruction cur = function->GetExpr(toProcess.top(), ast);
-		toProcess.pop();
-		if (!func(cur))
-			continue;
-		cur.CollectSubExprs(toProcess);
-	}
+	vector<size_t> exprs;
+	CollectSubExprs(exprs);
+	for (size_t i : exprs)
+		toProcess.push(i);
 }
 
 
-void HighLevelILInstruction::VisitExprs(const std::function<bool(const HighLevelILInstruction& expr)>& preFunc,
-	const std::function<void(const HighLevelILInstruction& expr)>& postFunc) const
+HighLevelILInstruction HighLevelILInstruction::GetSubExpr(size_t expr) const
 {
-	stack<std::pair<HighLevelILInstruction, stack<size_t>>> toProcess;
-	HighLevelILInstruction cur = *this;
-	if (!preFunc(cur))
-		return;
+	return function->GetExpr(expr, ast);
+}
 
-	stack<size_t> subExprs;
-	cur.CollectSubExprs(subExprs);
 
-	while (true)
-	{
-		if (subExprs.size() == 0)
-		{
-			postFunc(cur);
+void HighLevelILInstruction::VisitExprs(const std::function<bool(const HighLevelILInstruction& expr)>& func) const
+{
+	VisitILExprs(*this, [&](const HighLevelILInstruction& expr) { return func(expr); });
+}
 
-			if (toProcess.empty())
-				break;
-			cur = toProcess.top().first;
-			subExprs = toProcess.top().second;
-			toProcess.pop();
-		}
-		else
-		{
-			HighLevelILInstruction next = function->GetExpr(subExprs.top());
-			subExprs.pop();
 
-			if (preFunc(next))
-			{
-				toProcess.push(std::pair<HighLevelILInstruction, stack<size_t>>(cur, subExprs));
-				cur = next;
-				subExprs = stack<size_t>();
-				cur.CollectSubExprs(subExprs);
-			}
-		}
-	}
+void HighLevelILInstruction::VisitExprs(const std::function<bool(const HighLevelILInstruction& expr)>& preFunc,
+	const std::function<void(const HighLevelILInstruction& expr)>& postFunc) const
+{
+	VisitILExprs(*this, [&](const HighLevelILInstruction& expr) { return preFunc(expr); },
+		[&](const HighLevelILInstruction& expr) { postFunc(expr); });
 }
 
 
@@ -2136,14 +2109,7 @@ bool HighLevelILInstruction::operator!=(const HighLevelILInstruction& other) con
 
 bool HighLevelILInstruction::GetOperandIndexForUsage(HighLevelILOperandUsage usage, size_t& operandIndex) const
 {
-	auto operationIter = HighLevelILInstructionBase::operationOperandIndex.find(operation);
-	if (operationIter == HighLevelILInstructionBase::operationOperandIndex.end())
-		return false;
-	auto usageIter = operationIter->second.find(usage);
-	if (usageIter == operationIter->second.end())
-		return false;
-	operandIndex = usageIter->second;
-	return true;
+	return operandIndexTable.GetOperandIndexForUsage(operation, usage, operandIndex);
 }
 
 
@@ -27,7 +27,9 @@
 	#include "variable.h"
 #else
 	#include "binaryninjaapi.h"
+	#include "ilsnapshot.h"
 #endif
+#include "ilvisitor.h"
 #include "mediumlevelilinstruction.h"
 #include <fmt/core.h>
 
@@ -454,10 +456,36 @@ namespace BinaryNinja
 		HighLevelILInstruction(const HighLevelILInstructionBase& instr);
 
 		void CollectSubExprs(_STD_STACK<size_t>& toProcess) const;
+		void CollectSubExprs(_STD_VECTOR<size_t>& toProcess) const;
+		HighLevelILInstruction GetSubExpr(size_t expr) const;
 		void VisitExprs(const std::function<bool(const HighLevelILInstruction& expr)>& func) const;
 		void VisitExprs(const std::function<bool(const HighLevelILInstruction& expr)>& preFunc,
 			const std::function<void(const HighLevelILInstruction& expr)>& postFunc) const;
 
+		/*! Visit this expression and its subexpressions in pre-order, without recursion
+
+			The callback can return an ILVisitAction, or a bool as with the std::function overload. Unlike that
+			overload, no std::function is involved and only the visited expressions are fetched.
+
+			\return false if the callback stopped the walk with StopILVisit
+		*/
+		template <typename F>
+		bool VisitExprs(F&& func) const
+		{
+			return VisitILExprs(*this, std::forward<F>(func));
+		}
+
+		/*! Visit this expression and its subexpressions, calling `preFunc` before and `postFunc` after the
+			subexpressions of each expression
+
+			\return false if a callback stopped the walk with StopILVisit
+		*/
+		template <typename PreFunc, typename PostFunc>
+		bool VisitExprs(PreFunc&& preFunc, PostFunc&& postFunc) const
+		{
+			return VisitILExprs(*this, std::forward<PreFunc>(preFunc), std::forward<PostFunc>(postFunc));
+		}
+
 		ExprId CopyTo(HighLevelILFunction* dest) const;
 		ExprId CopyTo(HighLevelILFunction* dest,
 		    const std::function<ExprId(const HighLevelILInstruction& subExpr)>& subExprHandler) const;
@@ -1428,6 +1456,36 @@ namespace BinaryNinja
 	struct HighLevelILInstructionAccessor<HLIL_FTRUNC> : public HighLevelILOneOperandInstruction
 	{};
 
+#ifndef BINARYNINJACORE_LIBRARY
+	typedef ILSnapshotExpr<BNHighLevelILInstruction> HighLevelILSnapshotExpr;
+
+	/*! A copy of every expression of a HighLevelILFunction, plus its SSA definitions and uses, taken with
+		HighLevelILFunction::Snapshot. Nothing here calls back into the core.
+
+		\ingroup highlevelil
+	*/
+	class HighLevelILFunctionSnapshot : public ILFunctionSnapshot<BNHighLevelILInstruction>
+	{
+		ILSnapshotSSATable<SSAVariable> m_ssaVariables;
+		ILSnapshotSSATable<size_t> m_ssaMemory;
+		size_t m_rootExpr = BN_INVALID_EXPR;
+
+		friend class HighLevelILFunction;
+
+	  public:
+		size_t GetRootExprIndex() const { return m_rootExpr; }
+		HighLevelILSnapshotExpr GetRootExpr() const { return GetExpr(m_rootExpr); }
+		const std::vector<size_t>& GetParents() const { return m_storage->parents; }
+		const std::vector<SSAVariable>& GetSSAVariables() const { return m_ssaVariables.GetKeys(); }
+		const std::vector<size_t>& GetSSAMemoryVersions() const { return m_ssaMemory.GetKeys(); }
+
+		size_t GetSSAVarDefinition(const SSAVariable& var) const { return m_ssaVariables.GetDefinition(var); }
+		size_t GetSSAMemoryDefinition(size_t version) const { return m_ssaMemory.GetDefinition(version); }
+		ILSnapshotIndexRange GetSSAVarUses(const SSAVariable& var) const { return m_ssaVariables.GetUses(var); }
+		ILSnapshotIndexRange GetSSAMemoryUses(size_t version) const { return m_ssaMemory.GetUses(version); }
+	};
+#endif
+
 #undef _STD_VECTOR
 #undef _STD_SET
 #undef _STD_UNORDERED_MAP
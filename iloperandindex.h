@@ -0,0 +1,98 @@
+// Copyright (c) 2015-2024 Vector 35 Inc
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#ifdef BINARYNINJACORE_LIBRARY
+namespace BinaryNinjaCore
+#else
+namespace BinaryNinja
+#endif
+{
+	/*! Dense copies of an IL level's operationOperandIndex and operandTypeForUsage maps
+
+		Resolving an operand by its usage happens for every GetSourceExpr, GetDestExpr, etc. and is a single array
+		load here rather than two hash lookups. Internal to the IL instruction sources; each of them builds one
+		instance from its own maps during static initialization, after the maps themselves.
+	*/
+	template <typename Operation, typename Usage, typename OperandType>
+	class ILOperandIndexTable
+	{
+		static constexpr uint8_t InvalidOperandIndex = 0xff;
+
+		size_t m_usageCount = 0;
+		size_t m_operationCount = 0;
+		std::vector<uint8_t> m_operandIndex;
+		std::vector<OperandType> m_operandTypeForUsage;
+		std::vector<bool> m_usagePresent;
+
+	public:
+		template <typename OperationOperandIndexMap, typename OperandTypeForUsageMap>
+		ILOperandIndexTable(
+			const OperationOperandIndexMap& operationOperandIndex, const OperandTypeForUsageMap& operandTypeForUsage)
+		{
+			for (auto& usage : operandTypeForUsage)
+				m_usageCount = std::max(m_usageCount, (size_t)usage.first + 1);
+			for (auto& operation : operationOperandIndex)
+			{
+				m_operationCount = std::max(m_operationCount, (size_t)operation.first + 1);
+				for (auto& usage : operation.second)
+					m_usageCount = std::max(m_usageCount, (size_t)usage.first + 1);
+			}
+
+			m_operandIndex.resize(m_operationCount * m_usageCount, InvalidOperandIndex);
+			for (auto& operation : operationOperandIndex)
+				for (auto& usage : operation.second)
+					m_operandIndex[(size_t)operation.first * m_usageCount + (size_t)usage.first] = (uint8_t)usage.second;
+
+			m_operandTypeForUsage.resize(m_usageCount);
+			m_usagePresent.resize(m_usageCount, false);
+			for (auto& usage : operandTypeForUsage)
+			{
+				m_operandTypeForUsage[(size_t)usage.first] = usage.second;
+				m_usagePresent[(size_t)usage.first] = true;
+			}
+		}
+
+		bool GetOperandIndexForUsage(Operation operation, Usage usage, size_t& operandIndex) const
+		{
+			if (((size_t)operation >= m_operationCount) || ((size_t)usage >= m_usageCount))
+				return false;
+			uint8_t index = m_operandIndex[(size_t)operation * m_usageCount + (size_t)usage];
+			if (index == InvalidOperandIndex)
+				return false;
+			operandIndex = index;
+			return true;
+		}
+
+		bool GetOperandTypeForUsage(Usage usage, OperandType& type) const
+		{
+			if (((size_t)usage >= m_usageCount) || !m_usagePresent[(size_t)usage])
+				return false;
+			type = m_operandTypeForUsage[(size_t)usage];
+			return true;
+		}
+	};
+}  // namespace BinaryNinjaCore
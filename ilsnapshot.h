@@ -0,0 +1,315 @@
+// Copyright (c) 2015-2024 Vector 35 Inc
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include "binaryninjacore.h"
+
+namespace BinaryNinja
+{
+	template <typename T, typename = void>
+	struct ILHasFlags : std::false_type
+	{};
+	template <typename T>
+	struct ILHasFlags<T, std::void_t<decltype(T::flags)>> : std::true_type
+	{};
+
+	template <typename T, typename = void>
+	struct ILHasParent : std::false_type
+	{};
+	template <typename T>
+	struct ILHasParent<T, std::void_t<decltype(T::parent)>> : std::true_type
+	{};
+
+	/*! Column storage for every expression of an IL function, indexed by expression index
+
+		\ingroup lowlevelil
+	*/
+	template <typename RawInstruction>
+	struct ILSnapshotStorage
+	{
+		using Operation = decltype(RawInstruction::operation);
+		static constexpr size_t OperandCount = std::extent_v<decltype(RawInstruction::operands)>;
+		static constexpr bool HasFlags = ILHasFlags<RawInstruction>::value;
+		static constexpr bool HasParent = ILHasParent<RawInstruction>::value;
+
+		std::vector<Operation> operations;
+		std::vector<uint32_t> attributes;
+		std::vector<uint32_t> sourceOperands;
+		std::vector<size_t> sizes;
+		std::vector<uint64_t> addresses;
+		std::vector<uint32_t> flags;     // Only filled for LLIL
+		std::vector<size_t> parents;     // Only filled for HLIL
+		std::vector<uint64_t> operands;  // OperandCount consecutive entries per expression
+		std::vector<size_t> exprInstructions;
+		std::vector<size_t> instructionExprs;
+
+		void Reserve(size_t exprCount, size_t instrCount)
+		{
+			operations.reserve(exprCount);
+			attributes.reserve(exprCount);
+			sourceOperands.reserve(exprCount);
+			sizes.reserve(exprCount);
+			addresses.reserve(exprCount);
+			if constexpr (HasFlags)
+				flags.reserve(exprCount);
+			if constexpr (HasParent)
+				parents.reserve(exprCount);
+			operands.reserve(exprCount * OperandCount);
+			exprInstructions.reserve(exprCount);
+			instructionExprs.reserve(instrCount);
+		}
+
+		void AddExpr(const RawInstruction& instr, size_t instrIndex)
+		{
+			operations.push_back(instr.operation);
+			attributes.push_back(instr.attributes);
+			sourceOperands.push_back(instr.sourceOperand);
+			sizes.push_back(instr.size);
+			addresses.push_back(instr.address);
+			if constexpr (HasFlags)
+				flags.push_back(instr.flags);
+			if constexpr (HasParent)
+				parents.push_back(instr.parent);
+			operands.insert(operands.end(), instr.operands, instr.operands + OperandCount);
+			exprInstructions.push_back(instrIndex);
+		}
+	};
+
+	/*! A contiguous, read-only range of instruction indices owned by a snapshot
+
+		\ingroup lowlevelil
+	*/
+	struct ILSnapshotIndexRange
+	{
+		const size_t* first = nullptr;
+		const size_t* last = nullptr;
+
+		const size_t* begin() const { return first; }
+		const size_t* end() const { return last; }
+		size_t size() const { return last - first; }
+		bool empty() const { return first == last; }
+		size_t operator[](size_t i) const { return first[i]; }
+	};
+
+	/*! SSA definitions and uses for every version of one kind of SSA value
+
+		Keys are kept sorted so lookups are a binary search; the uses of all keys are stored back to back.
+
+		\ingroup lowlevelil
+	*/
+	template <typename Key>
+	class ILSnapshotSSATable
+	{
+		std::vector<Key> m_keys;
+		std::vector<size_t> m_definitions;
+		std::vector<size_t> m_useStarts {0};
+		std::vector<size_t> m_uses;
+
+		size_t Find(const Key& key) const
+		{
+			auto i = std::lower_bound(m_keys.begin(), m_keys.end(), key);
+			if ((i == m_keys.end()) || (key < *i))
+				return m_keys.size();
+			return i - m_keys.begin();
+		}
+
+	  public:
+		// Keys must be added in ascending order
+		void Add(const Key& key, size_t definition, const size_t* uses, size_t useCount)
+		{
+			m_keys.push_back(key);
+			m_definitions.push_back(definition);
+			size_t start = m_uses.size();
+			m_uses.insert(m_uses.end(), uses, uses + useCount);
+			std::sort(m_uses.begin() + start, m_uses.end());
+			m_uses.erase(std::unique(m_uses.begin() + start, m_uses.end()), m_uses.end());
+			m_useStarts.push_back(m_uses.size());
+		}
+
+		const std::vector<Key>& GetKeys() const { return m_keys; }
+
+		size_t GetDefinition(const Key& key) const
+		{
+			size_t i = Find(key);
+			return (i < m_keys.size()) ? m_definitions[i] : BN_INVALID_EXPR;
+		}
+
+		ILSnapshotIndexRange GetUses(const Key& key) const
+		{
+			size_t i = Find(key);
+			if (i >= m_keys.size())
+				return {};
+			return {m_uses.data() + m_useStarts[i], m_uses.data() + m_useStarts[i + 1]};
+		}
+	};
+
+	/*! A read-only view of one expression in an IL function snapshot
+
+		Views are two words and never call into the core. They stay valid for as long as any copy of the snapshot
+		they came from is alive.
+
+		\ingroup lowlevelil
+	*/
+	template <typename RawInstruction>
+	class ILSnapshotExpr
+	{
+		using Storage = ILSnapshotStorage<RawInstruction>;
+
+		const Storage* m_storage = nullptr;
+		size_t m_index = BN_INVALID_EXPR;
+
+	  public:
+		using Operation = typename Storage::Operation;
+		static constexpr size_t OperandCount = Storage::OperandCount;
+
+		ILSnapshotExpr() = default;
+		ILSnapshotExpr(const Storage* storage, size_t index) : m_storage(storage), m_index(index) {}
+
+		bool IsValid() const { return m_storage && (m_index < m_storage->operations.size()); }
+
+		size_t GetExprIndex() const { return m_index; }
+		size_t GetInstructionIndex() const { return m_storage->exprInstructions[m_index]; }
+		Operation GetOperation() const { return m_storage->operations[m_index]; }
+		uint32_t GetAttributes() const { return m_storage->attributes[m_index]; }
+		uint32_t GetSourceOperand() const { return m_storage->sourceOperands[m_index]; }
+		size_t GetSize() const { return m_storage->sizes[m_index]; }
+		uint64_t GetAddress() const { return m_storage->addresses[m_index]; }
+
+		uint32_t GetFlags() const
+		{
+			static_assert(Storage::HasFlags, "Only LLIL expressions have flags");
+			return m_storage->flags[m_index];
+		}
+
+		size_t GetParent() const
+		{
+			static_assert(Storage::HasParent, "Only HLIL expressions have a parent");
+			return m_storage->parents[m_index];
+		}
+
+		uint64_t GetRawOperand(size_t operand) const { return m_storage->operands[m_index * OperandCount + operand]; }
+		ILSnapshotExpr GetRawOperandAsExpr(size_t operand) const
+		{
+			return ILSnapshotExpr(m_storage, (size_t)GetRawOperand(operand));
+		}
+
+		/*! Calls `func` with each value of the list whose count is in `operand` and whose storage starts at the
+			expression in `operand + 1`, following the chain of storage expressions the same way the list
+			iterators of the IL instruction classes do
+		*/
+		template <typename Func>
+		void ForEachRawOperandListValue(size_t operand, Func&& func) const
+		{
+			size_t count = (size_t)GetRawOperand(operand);
+			const uint64_t* node = &m_storage->operands[(size_t)GetRawOperand(operand + 1) * OperandCount];
+			size_t slot = 0;
+			for (size_t i = 0; i < count; i++)
+			{
+				if (slot >= OperandCount - 1)
+				{
+					node = &m_storage->operands[(size_t)node[OperandCount - 1] * OperandCount];
+					slot = 0;
+				}
+				func(node[slot++]);
+			}
+		}
+
+		std::vector<uint64_t> GetRawOperandAsList(size_t operand) const
+		{
+			std::vector<uint64_t> result;
+			result.reserve((size_t)GetRawOperand(operand));
+			ForEachRawOperandListValue(operand, [&](uint64_t value) { result.push_back(value); });
+			return result;
+		}
+
+		std::vector<ILSnapshotExpr> GetRawOperandAsExprList(size_t operand) const
+		{
+			std::vector<ILSnapshotExpr> result;
+			result.reserve((size_t)GetRawOperand(operand));
+			ForEachRawOperandListValue(
+			    operand, [&](uint64_t value) { result.push_back(ILSnapshotExpr(m_storage, (size_t)value)); });
+			return result;
+		}
+
+		// Rebuilds the raw core structure for code that already works in terms of it
+		RawInstruction GetRawExpr() const
+		{
+			RawInstruction result {};
+			result.operation = GetOperation();
+			result.attributes = GetAttributes();
+			result.sourceOperand = GetSourceOperand();
+			result.size = GetSize();
+			result.address = GetAddress();
+			if constexpr (Storage::HasFlags)
+				result.flags = m_storage->flags[m_index];
+			if constexpr (Storage::HasParent)
+				result.parent = m_storage->parents[m_index];
+			for (size_t i = 0; i < OperandCount; i++)
+				result.operands[i] = GetRawOperand(i);
+			return result;
+		}
+
+		bool operator==(const ILSnapshotExpr& other) const
+		{
+			return (m_storage == other.m_storage) && (m_index == other.m_index);
+		}
+		bool operator!=(const ILSnapshotExpr& other) const { return !(*this == other); }
+	};
+
+	/*! Expressions of an IL function copied out of the core in one pass
+
+		Expression fields are stored column by column so scans over a single field (operations, addresses, ...) touch
+		contiguous memory. Copies of a snapshot share the same immutable storage.
+
+		\ingroup lowlevelil
+	*/
+	template <typename RawInstruction>
+	class ILFunctionSnapshot
+	{
+	  public:
+		using Storage = ILSnapshotStorage<RawInstruction>;
+		using Expr = ILSnapshotExpr<RawInstruction>;
+		using Operation = typename Storage::Operation;
+
+	  protected:
+		std::shared_ptr<Storage> m_storage = std::make_shared<Storage>();
+
+	  public:
+		size_t GetExprCount() const { return m_storage->operations.size(); }
+		size_t GetInstructionCount() const { return m_storage->instructionExprs.size(); }
+		size_t GetIndexForInstruction(size_t i) const { return m_storage->instructionExprs[i]; }
+		size_t GetInstructionForExpr(size_t expr) const { return m_storage->exprInstructions[expr]; }
+
+		Expr GetExpr(size_t i) const { return Expr(m_storage.get(), i); }
+		Expr GetInstruction(size_t i) const { return Expr(m_storage.get(), GetIndexForInstruction(i)); }
+		Expr operator[](size_t i) const { return GetInstruction(i); }
+
+		// Whole columns, indexed by expression index. Operands are OperandCount entries per expression.
+		const std::vector<Operation>& GetOperations() const { return m_storage->operations; }
+		const std::vector<uint64_t>& GetAddresses() const { return m_storage->addresses; }
+		const std::vector<size_t>& GetSizes() const { return m_storage->sizes; }
+		const std::vector<uint64_t>& GetOperands() const { return m_storage->operands; }
+	};
+}  // namespace BinaryNinja
@@ -0,0 +1,152 @@
+// Copyright (c) 2015-2024 Vector 35 Inc
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#pragma once
+
+#include <type_traits>
+#include <vector>
+
+#ifdef BINARYNINJACORE_LIBRARY
+namespace BinaryNinjaCore
+#else
+namespace BinaryNinja
+#endif
+{
+	/*! What an expression visitor callback wants to happen next
+
+		\ingroup lowlevelil
+	*/
+	enum ILVisitAction
+	{
+		ContinueILVisit,      // Visit the children of this expression
+		SkipChildrenILVisit,  // Don't descend into this expression, but keep visiting its siblings
+		StopILVisit           // Abandon the whole walk
+	};
+
+	// Visitor callbacks may return ILVisitAction, bool (true to descend, false to skip children) or nothing
+	template <typename Func, typename Instruction>
+	ILVisitAction InvokeILVisitor(Func& func, const Instruction& expr)
+	{
+		using Result = decltype(func(expr));
+		if constexpr (std::is_void_v<Result>)
+		{
+			func(expr);
+			return ContinueILVisit;
+		}
+		else if constexpr (std::is_same_v<std::decay_t<Result>, ILVisitAction>)
+		{
+			return func(expr);
+		}
+		else
+		{
+			return func(expr) ? ContinueILVisit : SkipChildrenILVisit;
+		}
+	}
+
+	/*! Pre-order walk of an IL expression tree using an explicit stack
+
+		`Instruction` must provide `CollectSubExprs(std::vector<size_t>&)`, which appends the indices of its
+		subexpressions last-to-first, and `GetSubExpr(size_t)`, which materializes one of those indices. Only the
+		expressions handed to the callback are ever fetched from the core.
+
+		\return false if the callback stopped the walk with StopILVisit
+	*/
+	template <typename Instruction, typename Func>
+	bool VisitILExprs(const Instruction& root, Func&& func)
+	{
+		switch (InvokeILVisitor(func, root))
+		{
+		case StopILVisit:
+			return false;
+		case SkipChildrenILVisit:
+			return true;
+		default:
+			break;
+		}
+
+		std::vector<size_t> toProcess;
+		root.CollectSubExprs(toProcess);
+		while (!toProcess.empty())
+		{
+			Instruction cur = root.GetSubExpr(toProcess.back());
+			toProcess.pop_back();
+			switch (InvokeILVisitor(func, cur))
+			{
+			case StopILVisit:
+				return false;
+			case SkipChildrenILVisit:
+				break;
+			default:
+				cur.CollectSubExprs(toProcess);
+				break;
+			}
+		}
+		return true;
+	}
+
+	/*! Walk of an IL expression tree calling `preFunc` before and `postFunc` after an expression's children
+
+		`postFunc` is not called for expressions whose `preFunc` skipped them. Either callback can end the walk by
+		returning StopILVisit.
+
+		\return false if a callback stopped the walk with StopILVisit
+	*/
+	template <typename Instruction, typename PreFunc, typename PostFunc>
+	bool VisitILExprs(const Instruction& root, PreFunc&& preFunc, PostFunc&& postFunc)
+	{
+		struct Frame
+		{
+			Instruction expr;
+			size_t firstSubExpr;  // Where this expression's pending children start in toProcess
+		};
+
+		std::vector<Frame> frames;
+		std::vector<size_t> toProcess;
+		auto enter = [&](const Instruction& expr) {
+			ILVisitAction action = InvokeILVisitor(preFunc, expr);
+			if (action == ContinueILVisit)
+			{
+				size_t firstSubExpr = toProcess.size();
+				expr.CollectSubExprs(toProcess);
+				frames.push_back({expr, firstSubExpr});
+			}
+			return action != StopILVisit;
+		};
+
+		if (!enter(root))
+			return false;
+		while (!frames.empty())
+		{
+			if (toProcess.size() > frames.back().firstSubExpr)
+			{
+				size_t next = toProcess.back();
+				toProcess.pop_back();
+				if (!enter(frames.back().expr.GetSubExpr(next)))
+					return false;
+				continue;
+			}
+
+			if (InvokeILVisitor(postFunc, frames.back().expr) == StopILVisit)
+				return false;
+			frames.pop_back();
+		}
+		return true;
+	}
+}  // namespace BinaryNinjaCore
@@ -581,6 +581,56 @@ size_t LowLevelILFunction::GetExprCount() const
 }
 
 
+LowLevelILFunctionSnapshot LowLevelILFunction::Snapshot()
+{
+	LowLevelILFunctionSnapshot result;
+	auto& storage = *result.m_storage;
+	size_t exprCount = GetExprCount();
+	size_t instrCount = GetInstructionCount();
+	storage.Reserve(exprCount, instrCount);
+	for (size_t i = 0; i < exprCount; i++)
+		storage.AddExpr(GetRawExpr(i), GetInstructionForExpr(i));
+	for (size_t i = 0; i < instrCount; i++)
+		storage.instructionExprs.push_back(GetIndexForInstruction(i));
+
+	size_t count;
+	vector<SSARegister> regs = GetSSARegisters();
+	sort(regs.begin(), regs.end());
+	for (auto& reg : regs)
+	{
+		size_t* uses = BNGetLowLevelILSSARegisterUses(m_object, reg.reg, reg.version, &count);
+		result.m_ssaRegisters.Add(reg, GetSSARegisterDefinition(reg), uses, count);
+		BNFreeILInstructionList(uses);
+	}
+
+	vector<SSAFlag> flags = GetSSAFlags();
+	sort(flags.begin(), flags.end());
+	for (auto& flag : flags)
+	{
+		size_t* uses = BNGetLowLevelILSSAFlagUses(m_object, flag.flag, flag.version, &count);
+		result.m_ssaFlags.Add(flag, GetSSAFlagDefinition(flag), uses, count);
+		BNFreeILInstructionList(uses);
+	}
+
+	size_t* versions = BNGetLowLevelMemoryVersions(m_object, &count);
+	if (versions)
+	{
+		vector<size_t> memoryVersions(versions, versions + count);
+		BNFreeLLILVariableVersionList(versions);
+		sort(memoryVersions.begin(), memoryVersions.end());
+		memoryVersions.erase(unique(memoryVersions.begin(), memoryVersions.end()), memoryVersions.end());
+		for (size_t version : memoryVersions)
+		{
+			size_t* uses = BNGetLowLevelILSSAMemoryUses(m_object, version, &count);
+			result.m_ssaMemory.Add(version, GetSSAMemoryDefinition(version), uses, count);
+			BNFreeILInstructionList(uses);
+		}
+	}
+
+	return result;
+}
+
+
 void LowLevelILFunction::UpdateInstructionOperand(size_t i, size_t operandIndex, ExprId value)
 {
 	BNUpdateLowLevelILOperand(m_object, i, operandIndex, value);
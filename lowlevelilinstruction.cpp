@@ -18,6 +18,7 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 
+#include <algorithm>
 #include <cstring>
 #ifdef BINARYNINJACORE_LIBRARY
 	#include "lowlevelilfunction.h"
@@ -30,6 +31,7 @@ using namespace BinaryNinjaCore;
 	#include "mediumlevelilinstruction.h"
 using namespace BinaryNinja;
 #endif
+#include "iloperandindex.h"
 
 #ifndef BINARYNINJACORE_LIBRARY
 using namespace std;
@@ -306,6 +308,12 @@ unordered_map<BNLowLevelILOperation, unordered_map<LowLevelILOperandUsage, size_
     LowLevelILInstructionBase::operationOperandIndex = GetOperandIndexForOperandUsages();
 
 
+// Built from the maps above, so it has to follow them
+static const ILOperandIndexTable<BNLowLevelILOperation, LowLevelILOperandUsage, LowLevelILOperandType>
+    operandIndexTable(LowLevelILInstructionBase::operationOperandIndex,
+        LowLevelILInstructionBase::operandTypeForUsage);
+
+
 RegisterOrFlag::RegisterOrFlag() : isFlag(false), index(BN_INVALID_REGISTER) {}
 
 
@@ -1104,10 +1112,8 @@ LowLevelILOperand::LowLevelILOperand(
     m_instr(instr),
     m_usage(usage), m_operandIndex(operandIndex)
 {
-	auto i = LowLevelILInstructionBase::operandTypeForUsage.find(m_usage);
-	if (i == LowLevelILInstructionBase::operandTypeForUsage.end())
+	if (!operandIndexTable.GetOperandTypeForUsage(m_usage, m_type))
 		throw LowLevelILInstructionAccessException();
-	m_type = i->second;
 }
 
 
@@ -1840,107 +1846,101 @@ void LowLevelILInstructionBase::ClearAttribute(BNILInstructionAttribute attribut
 }
 
 
-void LowLevelILInstruction::VisitExprs(const std::function<bool(const LowLevelILInstruction& expr)>& func) const
+// Index-only counterparts of the expression accessors, so collecting subexpressions doesn't fetch each one
+static size_t GetSubExprIndex(const LowLevelILInstruction& instr, LowLevelILOperandUsage usage)
+{
+	size_t operandIndex;
+	if (!instr.GetOperandIndexForUsage(usage, operandIndex))
+		throw LowLevelILInstructionAccessException();
+	return instr.GetRawOperandAsIndex(operandIndex);
+}
+
+
+static void AppendParameterExprIndices(const LowLevelILInstruction& instr, vector<size_t>& toProcess)
+{
+	size_t operandIndex;
+	if (!instr.GetOperandIndexForUsage(ParameterExprsLowLevelOperandUsage, operandIndex))
+		throw LowLevelILInstructionAccessException();
+	LowLevelILIndexList exprs = (operandIndex == 0) ? instr.GetRawOperandAsIndexList(0) :
+		instr.GetRawOperandAsExpr(operandIndex).GetRawOperandAsIndexList(0);
+	for (size_t i : exprs)
+		toProcess.push_back(i);
+}
+
+
+void LowLevelILInstruction::CollectSubExprs(vector<size_t>& toProcess) const
 {
-	if (!func(*this))
-		return;
+	// Children are gathered first-to-last and then flipped, so the first child ends up on top of the stack
+	size_t first = toProcess.size();
 	switch (operation)
 	{
 	case LLIL_SET_REG:
-		GetSourceExpr<LLIL_SET_REG>().VisitExprs(func);
-		break;
 	case LLIL_SET_REG_SPLIT:
-		GetSourceExpr<LLIL_SET_REG_SPLIT>().VisitExprs(func);
-		break;
 	case LLIL_SET_REG_SSA:
-		GetSourceExpr<LLIL_SET_REG_SSA>().VisitExprs(func);
-		break;
 	case LLIL_SET_REG_SSA_PARTIAL:
-		GetSourceExpr<LLIL_SET_REG_SSA_PARTIAL>().VisitExprs(func);
-		break;
 	case LLIL_SET_REG_SPLIT_SSA:
-		GetSourceExpr<LLIL_SET_REG_SPLIT_SSA>().VisitExprs(func);
+		toProcess.push_back(GetSubExprIndex(*this, SourceExprLowLevelOperandUsage));
 		break;
 	case LLIL_SET_REG_STACK_REL:
-		GetDestExpr<LLIL_SET_REG_STACK_REL>().VisitExprs(func);
-		GetSourceExpr<LLIL_SET_REG_STACK_REL>().VisitExprs(func);
+		toProcess.push_back(GetSubExprIndex(*this, DestExprLowLevelOperandUsage));
+		toProcess.push_back(GetSubExprIndex(*this, SourceExprLowLevelOperandUsage));
 		break;
 	case LLIL_REG_STACK_PUSH:
-		GetSourceExpr<LLIL_REG_STACK_PUSH>().VisitExprs(func);
+		toProcess.push_back(GetSubExprIndex(*this, SourceExprLowLevelOperandUsage));
 		break;
 	case LLIL_SET_REG_STACK_REL_SSA:
-		GetDestExpr<LLIL_SET_REG_STACK_REL_SSA>().VisitExprs(func);
-		GetSourceExpr<LLIL_SET_REG_STACK_REL_SSA>().VisitExprs(func);
+		toProcess.push_back(GetSubExprIndex(*this, DestExprLowLevelOperandUsage));
+		toProcess.push_back(GetSubExprIndex(*this, SourceExprLowLevelOperandUsage));
 		break;
 	case LLIL_SET_REG_STACK_ABS_SSA:
-		GetSourceExpr<LLIL_SET_REG_STACK_ABS_SSA>().VisitExprs(func);
-		break;
 	case LLIL_SET_FLAG:
-		GetSourceExpr<LLIL_SET_FLAG>().VisitExprs(func);
-		break;
 	case LLIL_SET_FLAG_SSA:
-		GetSourceExpr<LLIL_SET_FLAG_SSA>().VisitExprs(func);
-		break;
 	case LLIL_REG_STACK_REL:
-		GetSourceExpr<LLIL_REG_STACK_REL>().VisitExprs(func);
+		toProcess.push_back(GetSubExprIndex(*this, SourceExprLowLevelOperandUsage));
 		break;
 	case LLIL_REG_STACK_FREE_REL:
-		GetDestExpr<LLIL_REG_STACK_FREE_REL>().VisitExprs(func);
+		toProcess.push_back(GetSubExprIndex(*this, DestExprLowLevelOperandUsage));
 		break;
 	case LLIL_REG_STACK_REL_SSA:
-		GetSourceExpr<LLIL_REG_STACK_REL_SSA>().VisitExprs(func);
+		toProcess.push_back(GetSubExprIndex(*this, SourceExprLowLevelOperandUsage));
 		break;
 	case LLIL_REG_STACK_FREE_REL_SSA:
-		GetDestExpr<LLIL_REG_STACK_FREE_REL_SSA>().VisitExprs(func);
+		toProcess.push_back(GetSubExprIndex(*this, DestExprLowLevelOperandUsage));
 		break;
 	case LLIL_LOAD:
-		GetSourceExpr<LLIL_LOAD>().VisitExprs(func);
-		break;
 	case LLIL_LOAD_SSA:
-		GetSourceExpr<LLIL_LOAD_SSA>().VisitExprs(func);
+		toProcess.push_back(GetSubExprIndex(*this, SourceExprLowLevelOperandUsage));
 		break;
 	case LLIL_STORE:
-		GetDestExpr<LLIL_STORE>().VisitExprs(func);
-		GetSourceExpr<LLIL_STORE>().VisitExprs(func);
-		break;
 	case LLIL_STORE_SSA:
-		GetDestExpr<LLIL_STORE_SSA>().VisitExprs(func);
-		GetSourceExpr<LLIL_STORE_SSA>().VisitExprs(func);
+		toProcess.push_back(GetSubExprIndex(*this, DestExprLowLevelOperandUsage));
+		toProcess.push_back(GetSubExprIndex(*this, SourceExprLowLevelOperandUsage));
 		break;
 	case LLIL_JUMP:
-		GetDestExpr<LLIL_JUMP>().VisitExprs(func);
-		break;
 	case LLIL_JUMP_TO:
-		GetDestExpr<LLIL_JUMP_TO>().VisitExprs(func);
+		toProcess.push_back(GetSubExprIndex(*this, DestExprLowLevelOperandUsage));
 		break;
 	case LLIL_IF:
-		GetConditionExpr<LLIL_IF>().VisitExprs(func);
+		toProcess.push_back(GetSubExprIndex(*this, ConditionExprLowLevelOperandUsage));
 		break;
 	case LLIL_CALL:
-		GetDestExpr<LLIL_CALL>().VisitExprs(func);
-		break;
 	case LLIL_CALL_STACK_ADJUST:
-		GetDestExpr<LLIL_CALL_STACK_ADJUST>().VisitExprs(func);
-		break;
 	case LLIL_TAILCALL:
-		GetDestExpr<LLIL_TAILCALL>().VisitExprs(func);
+		toProcess.push_back(GetSubExprIndex(*this, DestExprLowLevelOperandUsage));
 		break;
 	case LLIL_CALL_SSA:
-		GetDestExpr<LLIL_CALL_SSA>().VisitExprs(func);
-		for (auto i : GetParameterExprs<LLIL_CALL_SSA>())
-			i.VisitExprs(func);
+		toProcess.push_back(GetSubExprIndex(*this, DestExprLowLevelOperandUsage));
+		AppendParameterExprIndices(*this, toProcess);
 		break;
 	case LLIL_SYSCALL_SSA:
-		for (auto i : GetParameterExprs<LLIL_SYSCALL_SSA>())
-			i.VisitExprs(func);
+		AppendParameterExprIndices(*this, toProcess);
 		break;
 	case LLIL_TAILCALL_SSA:
-		GetDestExpr<LLIL_TAILCALL_SSA>().VisitExprs(func);
-		for (auto i : GetParameterExprs<LLIL_TAILCALL_SSA>())
-			i.VisitExprs(func);
+		toProcess.push_back(GetSubExprIndex(*this, DestExprLowLevelOperandUsage));
+		AppendParameterExprIndices(*this, toProcess);
 		break;
 	case LLIL_RET:
-		GetDestExpr<LLIL_RET>().VisitExprs(func);
+		toProcess.push_back(GetSubExprIndex(*this, DestExprLowLevelOperandUsage));
 		break;
 	case LLIL_PUSH:
 	case LLIL_NEG:
@@ -1960,7 +1960,7 @@ void LowLevelILInstruction::VisitExprs(const std::function<bool(const LowLevelIL
 	case LLIL_FLOOR:
 	case LLIL_CEIL:
 	case LLIL_FTRUNC:
-		AsOneOperand().GetSourceExpr().VisitExprs(func);
+		toProcess.push_back(GetRawOperandAsIndex(0));
 		break;
 	case LLIL_ADD:
 	case LLIL_SUB:
@@ -2007,40 +2007,41 @@ void LowLevelILInstruction::VisitExprs(const std::function<bool(const LowLevelIL
 	case LLIL_FCMP_GT:
 	case LLIL_FCMP_O:
 	case LLIL_FCMP_UO:
-		AsTwoOperand().GetLeftExpr().VisitExprs(func);
-		AsTwoOperand().GetRightExpr().VisitExprs(func);
+		toProcess.push_back(GetRawOperandAsIndex(0));
+		toProcess.push_back(GetRawOperandAsIndex(1));
 		break;
 	case LLIL_ADC:
 	case LLIL_SBB:
 	case LLIL_RLC:
 	case LLIL_RRC:
-		AsTwoOperandWithCarry().GetLeftExpr().VisitExprs(func);
-		AsTwoOperandWithCarry().GetRightExpr().VisitExprs(func);
-		AsTwoOperandWithCarry().GetCarryExpr().VisitExprs(func);
+		toProcess.push_back(GetRawOperandAsIndex(0));
+		toProcess.push_back(GetRawOperandAsIndex(1));
+		toProcess.push_back(GetRawOperandAsIndex(2));
 		break;
 	case LLIL_INTRINSIC:
-		for (auto i : GetParameterExprs<LLIL_INTRINSIC>())
-			i.VisitExprs(func);
-		break;
 	case LLIL_INTRINSIC_SSA:
-		for (auto i : GetParameterExprs<LLIL_INTRINSIC_SSA>())
-			i.VisitExprs(func);
-		break;
 	case LLIL_MEMORY_INTRINSIC_SSA:
-		for (auto i : GetParameterExprs<LLIL_MEMORY_INTRINSIC_SSA>())
-			i.VisitExprs(func);
-		break;
 	case LLIL_SEPARATE_PARAM_LIST_SSA:
-		for (auto i : GetParameterExprs<LLIL_SEPARATE_PARAM_LIST_SSA>())
-			i.VisitExprs(func);
-		break;
 	case LLIL_SHARED_PARAM_SLOT_SSA:
-		for (auto i : GetParameterExprs<LLIL_SHARED_PARAM_SLOT_SSA>())
-			i.VisitExprs(func);
+		AppendParameterExprIndices(*this, toProcess);
 		break;
 	default:
 		break;
 	}
+
+	std::reverse(toProcess.begin() + first, toProcess.end());
+}
+
+
+LowLevelILInstruction LowLevelILInstruction::GetSubExpr(size_t expr) const
+{
+	return LowLevelILInstruction(function, function->GetRawExpr(expr), expr, instructionIndex);
+}
+
+
+void LowLevelILInstruction::VisitExprs(const std::function<bool(const LowLevelILInstruction& expr)>& func) const
+{
+	VisitILExprs(*this, [&](const LowLevelILInstruction& expr) { return func(expr); });
 }
 
 
@@ -2353,14 +2354,7 @@ ExprId LowLevelILInstruction::CopyTo(
 
 bool LowLevelILInstruction::GetOperandIndexForUsage(LowLevelILOperandUsage usage, size_t& operandIndex) const
 {
-	auto operationIter = LowLevelILInstructionBase::operationOperandIndex.find(operation);
-	if (operationIter == LowLevelILInstructionBase::operationOperandIndex.end())
-		return false;
-	auto usageIter = operationIter->second.find(usage);
-	if (usageIter == operationIter->second.end())
-		return false;
-	operandIndex = usageIter->second;
-	return true;
+	return operandIndexTable.GetOperandIndexForUsage(operation, usage, operandIndex);
 }
 
 
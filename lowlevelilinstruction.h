@@ -27,7 +27,9 @@
 	#include "type.h"
 #else
 	#include "binaryninjaapi.h"
+	#include "ilsnapshot.h"
 #endif
+#include "ilvisitor.h"
 
 #ifdef BINARYNINJACORE_LIBRARY
 namespace BinaryNinjaCore
@@ -813,8 +815,34 @@ namespace BinaryNinja
 		    LowLevelILFunction* func, const BNLowLevelILInstruction& instr, size_t expr, size_t instrIdx);
 		LowLevelILInstruction(const LowLevelILInstructionBase& instr);
 
+		void CollectSubExprs(_STD_VECTOR<size_t>& toProcess) const;
+		LowLevelILInstruction GetSubExpr(size_t expr) const;
 		void VisitExprs(const std::function<bool(const LowLevelILInstruction& expr)>& func) const;
 
+		/*! Visit this expression and its subexpressions in pre-order, without recursion
+
+			The callback can return an ILVisitAction, or a bool as with the std::function overload. Unlike that
+			overload, no std::function is involved and only the visited expressions are fetched.
+
+			\return false if the callback stopped the walk with StopILVisit
+		*/
+		template <typename F>
+		bool VisitExprs(F&& func) const
+		{
+			return VisitILExprs(*this, std::forward<F>(func));
+		}
+
+		/*! Visit this expression and its subexpressions, calling `preFunc` before and `postFunc` after the
+			subexpressions of each expression
+
+			\return false if a callback stopped the walk with StopILVisit
+		*/
+		template <typename PreFunc, typename PostFunc>
+		bool VisitExprs(PreFunc&& preFunc, PostFunc&& postFunc) const
+		{
+			return VisitILExprs(*this, std::forward<PreFunc>(preFunc), std::forward<PostFunc>(postFunc));
+		}
+
 		ExprId CopyTo(LowLevelILFunction* dest) const;
 		ExprId CopyTo(LowLevelILFunction* dest,
 		    const std::function<ExprId(const LowLevelILInstruction& subExpr)>& subExprHandler) const;
@@ -2005,6 +2033,38 @@ namespace BinaryNinja
 	template <>
 	struct LowLevelILInstructionAccessor<LLIL_FTRUNC> : public LowLevelILOneOperandInstruction
 	{};
+
+#ifndef BINARYNINJACORE_LIBRARY
+	typedef ILSnapshotExpr<BNLowLevelILInstruction> LowLevelILSnapshotExpr;
+
+	/*! A copy of every expression of a LowLevelILFunction, plus its SSA definitions and uses, taken with
+		LowLevelILFunction::Snapshot. Nothing here calls back into the core.
+
+		\ingroup lowlevelil
+	*/
+	class LowLevelILFunctionSnapshot : public ILFunctionSnapshot<BNLowLevelILInstruction>
+	{
+		ILSnapshotSSATable<SSARegister> m_ssaRegisters;
+		ILSnapshotSSATable<SSAFlag> m_ssaFlags;
+		ILSnapshotSSATable<size_t> m_ssaMemory;
+
+		friend class LowLevelILFunction;
+
+	  public:
+		const std::vector<uint32_t>& GetFlags() const { return m_storage->flags; }
+
+		const std::vector<SSARegister>& GetSSARegisters() const { return m_ssaRegisters.GetKeys(); }
+		const std::vector<SSAFlag>& GetSSAFlags() const { return m_ssaFlags.GetKeys(); }
+		const std::vector<size_t>& GetSSAMemoryVersions() const { return m_ssaMemory.GetKeys(); }
+
+		size_t GetSSARegisterDefinition(const SSARegister& reg) const { return m_ssaRegisters.GetDefinition(reg); }
+		size_t GetSSAFlagDefinition(const SSAFlag& flag) const { return m_ssaFlags.GetDefinition(flag); }
+		size_t GetSSAMemoryDefinition(size_t version) const { return m_ssaMemory.GetDefinition(version); }
+		ILSnapshotIndexRange GetSSARegisterUses(const SSARegister& reg) const { return m_ssaRegisters.GetUses(reg); }
+		ILSnapshotIndexRange GetSSAFlagUses(const SSAFlag& flag) const { return m_ssaFlags.GetUses(flag); }
+		ILSnapshotIndexRange GetSSAMemoryUses(size_t version) const { return m_ssaMemory.GetUses(version); }
+	};
+#endif
 #undef _STD_VECTOR
 #undef _STD_SET
 #undef _STD_UNORDERED_MAP
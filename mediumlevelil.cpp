@@ -279,6 +279,71 @@ size_t MediumLevelILFunction::GetExprCount() const
 }
 
 
+MediumLevelILFunctionSnapshot MediumLevelILFunction::Snapshot()
+{
+	MediumLevelILFunctionSnapshot result;
+	auto& storage = *result.m_storage;
+	size_t exprCount = GetExprCount();
+	size_t instrCount = GetInstructionCount();
+	storage.Reserve(exprCount, instrCount);
+	for (size_t i = 0; i < exprCount; i++)
+		storage.AddExpr(GetRawExpr(i), GetInstructionForExpr(i));
+	for (size_t i = 0; i < instrCount; i++)
+		storage.instructionExprs.push_back(GetIndexForInstruction(i));
+
+	size_t varCount;
+	BNVariable* vars = BNGetMediumLevelILVariables(m_object, &varCount);
+	vector<SSAVariable> ssaVars;
+	for (size_t i = 0; i < varCount; i++)
+	{
+		size_t versionCount;
+		size_t* versions = BNGetMediumLevelILVariableSSAVersions(m_object, &vars[i], &versionCount);
+		for (size_t j = 0; j < versionCount; j++)
+			ssaVars.emplace_back(vars[i], versions[j]);
+		BNFreeILInstructionList(versions);
+	}
+	BNFreeVariableList(vars);
+
+	sort(ssaVars.begin(), ssaVars.end());
+	ssaVars.erase(unique(ssaVars.begin(), ssaVars.end()), ssaVars.end());
+	for (auto& var : ssaVars)
+	{
+		size_t count;
+		size_t* uses = BNGetMediumLevelILSSAVarUses(m_object, &var.var, var.version, &count);
+		result.m_ssaVariables.Add(var, GetSSAVarDefinition(var), uses, count);
+		BNFreeILInstructionList(uses);
+	}
+
+	// There is no list of memory versions, so take the ones defined by the copied expressions along with the
+	// version live at the first instruction, which covers the entry version that has no definition
+	vector<size_t> memoryVersions;
+	if (instrCount != 0)
+		memoryVersions.push_back(BNGetMediumLevelILSSAMemoryVersionAtILInstruction(m_object, 0));
+	for (size_t i = 0; i < exprCount; i++)
+	{
+		auto usages = MediumLevelILInstructionBase::operationOperandIndex.find(storage.operations[i]);
+		if (usages == MediumLevelILInstructionBase::operationOperandIndex.end())
+			continue;
+		ILSnapshotExpr<BNMediumLevelILInstruction> expr(&storage, i);
+		if (auto dest = usages->second.find(DestMemoryVersionMediumLevelOperandUsage); dest != usages->second.end())
+			memoryVersions.push_back(expr.GetRawOperand(dest->second));
+		else if (auto output = usages->second.find(OutputSSAMemoryVersionMediumLevelOperandUsage); output != usages->second.end())
+			memoryVersions.push_back(expr.GetRawOperandAsExpr(output->second).GetRawOperand(0));
+	}
+	sort(memoryVersions.begin(), memoryVersions.end());
+	memoryVersions.erase(unique(memoryVersions.begin(), memoryVersions.end()), memoryVersions.end());
+	for (size_t version : memoryVersions)
+	{
+		size_t count;
+		size_t* uses = BNGetMediumLevelILSSAMemoryUses(m_object, version, &count);
+		result.m_ssaMemory.Add(version, GetSSAMemoryDefinition(version), uses, count);
+		BNFreeILInstructionList(uses);
+	}
+
+	return result;
+}
+
+
 void MediumLevelILFunction::UpdateInstructionOperand(size_t i, size_t operandIndex, ExprId value)
 {
 	BNUpdateMediumLevelILOperand(m_object, i, operandIndex, value);
@@ -18,6 +18,7 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 
+#include <algorithm>
 #include <cstring>
 #ifdef BINARYNINJACORE_LIBRARY
 	#include "mediumlevelilfunction.h"
@@ -30,6 +31,7 @@ using namespace BinaryNinjaCore;
 	#include "lowlevelilinstruction.h"
 using namespace BinaryNinja;
 #endif
+#include "iloperandindex.h"
 
 #ifndef BINARYNINJACORE_LIBRARY
 using namespace std;
@@ -302,6 +304,12 @@ unordered_map<BNMediumLevelILOperation, unordered_map<MediumLevelILOperandUsage,
     MediumLevelILInstructionBase::operationOperandIndex = GetOperandIndexForOperandUsages();
 
 
+// Built from the maps above, so it has to follow them
+static const ILOperandIndexTable<BNMediumLevelILOperation, MediumLevelILOperandUsage, MediumLevelILOperandType>
+    operandIndexTable(MediumLevelILInstructionBase::operationOperandIndex,
+        MediumLevelILInstructionBase::operandTypeForUsage);
+
+
 SSAVariable::SSAVariable() : version(0) {}
 
 
@@ -722,10 +730,8 @@ MediumLevelILOperand::MediumLevelILOperand(
     m_instr(instr),
     m_usage(usage), m_operandIndex(operandIndex)
 {
-	auto i = MediumLevelILInstructionBase::operandTypeForUsage.find(m_usage);
-	if (i == MediumLevelILInstructionBase::operandTypeForUsage.end())
+	if (!operandIndexTable.GetOperandTypeForUsage(m_usage, m_type))
 		throw MediumLevelILInstructionAccessException();
-	m_type = i->second;
 }
 
 
@@ -1390,119 +1396,98 @@ void MediumLevelILInstructionBase::ClearAttribute(BNILInstructionAttribute attri
 }
 
 
-void MediumLevelILInstruction::VisitExprs(const std::function<bool(const MediumLevelILInstruction& expr)>& func) const
+// Index-only counterparts of the expression accessors, so collecting subexpressions doesn't fetch each one
+static size_t GetSubExprIndex(const MediumLevelILInstruction& instr, MediumLevelILOperandUsage usage)
+{
+	size_t operandIndex;
+	if (!instr.GetOperandIndexForUsage(usage, operandIndex))
+		throw MediumLevelILInstructionAccessException();
+	return instr.GetRawOperandAsIndex(operandIndex);
+}
+
+
+static void AppendSubExprIndices(
+	const MediumLevelILInstruction& instr, MediumLevelILOperandUsage usage, vector<size_t>& toProcess)
 {
-	if (!func(*this))
+	size_t operandIndex;
+	if (!instr.GetOperandIndexForUsage(usage, operandIndex))
+		throw MediumLevelILInstructionAccessException();
+	for (size_t i : instr.GetRawOperandAsIndexList(operandIndex))
+		toProcess.push_back(i);
+}
+
+
+static void AppendParameterExprIndices(const MediumLevelILInstruction& instr, vector<size_t>& toProcess)
+{
+	// Mirrors GetParameterExprs, untyped calls keep their parameters in a subexpression
+	size_t operandIndex;
+	if (instr.GetOperandIndexForUsage(ParameterExprsMediumLevelOperandUsage, operandIndex))
+	{
+		AppendSubExprIndices(instr, ParameterExprsMediumLevelOperandUsage, toProcess);
 		return;
+	}
+
+	size_t listOperand;
+	if (instr.GetOperandIndexForUsage(UntypedParameterExprsMediumLevelOperandUsage, operandIndex))
+		listOperand = 0;
+	else if (instr.GetOperandIndexForUsage(UntypedParameterSSAExprsMediumLevelOperandUsage, operandIndex))
+		listOperand = 1;
+	else
+		throw MediumLevelILInstructionAccessException();
+	for (size_t i : instr.GetRawOperandAsExpr(operandIndex).GetRawOperandAsIndexList(listOperand))
+		toProcess.push_back(i);
+}
+
+
+void MediumLevelILInstruction::CollectSubExprs(vector<size_t>& toProcess) const
+{
+	// Children are gathered first-to-last and then flipped, so the first child ends up on top of the stack
+	size_t first = toProcess.size();
 	switch (operation)
 	{
 	case MLIL_SET_VAR:
-		GetSourceExpr<MLIL_SET_VAR>().VisitExprs(func);
-		break;
 	case MLIL_SET_VAR_SSA:
-		GetSourceExpr<MLIL_SET_VAR_SSA>().VisitExprs(func);
-		break;
 	case MLIL_SET_VAR_ALIASED:
-		GetSourceExpr<MLIL_SET_VAR_ALIASED>().VisitExprs(func);
-		break;
 	case MLIL_SET_VAR_SPLIT:
-		GetSourceExpr<MLIL_SET_VAR_SPLIT>().VisitExprs(func);
-		break;
 	case MLIL_SET_VAR_SPLIT_SSA:
-		GetSourceExpr<MLIL_SET_VAR_SPLIT_SSA>().VisitExprs(func);
-		break;
 	case MLIL_SET_VAR_FIELD:
-		GetSourceExpr<MLIL_SET_VAR_FIELD>().VisitExprs(func);
-		break;
 	case MLIL_SET_VAR_SSA_FIELD:
-		GetSourceExpr<MLIL_SET_VAR_SSA_FIELD>().VisitExprs(func);
-		break;
 	case MLIL_SET_VAR_ALIASED_FIELD:
-		GetSourceExpr<MLIL_SET_VAR_ALIASED_FIELD>().VisitExprs(func);
+		toProcess.push_back(GetSubExprIndex(*this, SourceExprMediumLevelOperandUsage));
 		break;
 	case MLIL_CALL:
-		GetDestExpr<MLIL_CALL>().VisitExprs(func);
-		for (auto i : GetParameterExprs<MLIL_CALL>())
-			i.VisitExprs(func);
-		break;
 	case MLIL_CALL_UNTYPED:
-		GetDestExpr<MLIL_CALL_UNTYPED>().VisitExprs(func);
-		for (auto i : GetParameterExprs<MLIL_CALL_UNTYPED>())
-			i.VisitExprs(func);
-		break;
 	case MLIL_CALL_SSA:
-		GetDestExpr<MLIL_CALL_SSA>().VisitExprs(func);
-		for (auto i : GetParameterExprs<MLIL_CALL_SSA>())
-			i.VisitExprs(func);
-		break;
 	case MLIL_CALL_UNTYPED_SSA:
-		GetDestExpr<MLIL_CALL_UNTYPED_SSA>().VisitExprs(func);
-		for (auto i : GetParameterExprs<MLIL_CALL_UNTYPED_SSA>())
-			i.VisitExprs(func);
+		toProcess.push_back(GetSubExprIndex(*this, DestExprMediumLevelOperandUsage));
+		AppendParameterExprIndices(*this, toProcess);
 		break;
 	case MLIL_SYSCALL:
-		for (auto i : GetParameterExprs<MLIL_SYSCALL>())
-			i.VisitExprs(func);
-		break;
 	case MLIL_SYSCALL_UNTYPED:
-		for (auto i : GetParameterExprs<MLIL_SYSCALL_UNTYPED>())
-			i.VisitExprs(func);
-		break;
 	case MLIL_SYSCALL_SSA:
-		for (auto i : GetParameterExprs<MLIL_SYSCALL_SSA>())
-			i.VisitExprs(func);
-		break;
 	case MLIL_SYSCALL_UNTYPED_SSA:
-		for (auto i : GetParameterExprs<MLIL_SYSCALL_UNTYPED_SSA>())
-			i.VisitExprs(func);
+		AppendParameterExprIndices(*this, toProcess);
 		break;
 	case MLIL_TAILCALL:
-		GetDestExpr<MLIL_TAILCALL>().VisitExprs(func);
-		for (auto i : GetParameterExprs<MLIL_TAILCALL>())
-			i.VisitExprs(func);
-		break;
 	case MLIL_TAILCALL_UNTYPED:
-		GetDestExpr<MLIL_TAILCALL_UNTYPED>().VisitExprs(func);
-		for (auto i : GetParameterExprs<MLIL_TAILCALL_UNTYPED>())
-			i.VisitExprs(func);
-		break;
 	case MLIL_TAILCALL_SSA:
-		GetDestExpr<MLIL_TAILCALL_SSA>().VisitExprs(func);
-		for (auto i : GetParameterExprs<MLIL_TAILCALL_SSA>())
-			i.VisitExprs(func);
-		break;
 	case MLIL_TAILCALL_UNTYPED_SSA:
-		GetDestExpr<MLIL_TAILCALL_UNTYPED_SSA>().VisitExprs(func);
-		for (auto i : GetParameterExprs<MLIL_TAILCALL_UNTYPED_SSA>())
-			i.VisitExprs(func);
+		toProcess.push_back(GetSubExprIndex(*this, DestExprMediumLevelOperandUsage));
+		AppendParameterExprIndices(*this, toProcess);
 		break;
 	case MLIL_SEPARATE_PARAM_LIST:
-		for (auto i : GetParameterExprs<MLIL_SEPARATE_PARAM_LIST>())
-			i.VisitExprs(func);
-		break;
 	case MLIL_SHARED_PARAM_SLOT:
-		for (auto i : GetParameterExprs<MLIL_SHARED_PARAM_SLOT>())
-			i.VisitExprs(func);
+		AppendParameterExprIndices(*this, toProcess);
 		break;
 	case MLIL_RET:
-		for (auto i : GetSourceExprs<MLIL_RET>())
-			i.VisitExprs(func);
+		AppendSubExprIndices(*this, SourceExprsMediumLevelOperandUsage, toProcess);
 		break;
 	case MLIL_STORE:
-		GetDestExpr<MLIL_STORE>().VisitExprs(func);
-		GetSourceExpr<MLIL_STORE>().VisitExprs(func);
-		break;
 	case MLIL_STORE_STRUCT:
-		GetDestExpr<MLIL_STORE_STRUCT>().VisitExprs(func);
-		GetSourceExpr<MLIL_STORE_STRUCT>().VisitExprs(func);
-		break;
 	case MLIL_STORE_SSA:
-		GetDestExpr<MLIL_STORE_SSA>().VisitExprs(func);
-		GetSourceExpr<MLIL_STORE_SSA>().VisitExprs(func);
-		break;
 	case MLIL_STORE_STRUCT_SSA:
-		GetDestExpr<MLIL_STORE_STRUCT_SSA>().VisitExprs(func);
-		GetSourceExpr<MLIL_STORE_STRUCT_SSA>().VisitExprs(func);
+		toProcess.push_back(GetSubExprIndex(*this, DestExprMediumLevelOperandUsage));
+		toProcess.push_back(GetSubExprIndex(*this, SourceExprMediumLevelOperandUsage));
 		break;
 	case MLIL_NEG:
 	case MLIL_NOT:
@@ -1529,7 +1514,7 @@ void MediumLevelILInstruction::VisitExprs(const std::function<bool(const MediumL
 	case MLIL_FLOOR:
 	case MLIL_CEIL:
 	case MLIL_FTRUNC:
-		AsOneOperand().GetSourceExpr().VisitExprs(func);
+		toProcess.push_back(GetRawOperandAsIndex(0));
 		break;
 	case MLIL_ADD:
 	case MLIL_SUB:
@@ -1576,29 +1561,39 @@ void MediumLevelILInstruction::VisitExprs(const std::function<bool(const MediumL
 	case MLIL_FCMP_GT:
 	case MLIL_FCMP_O:
 	case MLIL_FCMP_UO:
-		AsTwoOperand().GetLeftExpr().VisitExprs(func);
-		AsTwoOperand().GetRightExpr().VisitExprs(func);
+		toProcess.push_back(GetRawOperandAsIndex(0));
+		toProcess.push_back(GetRawOperandAsIndex(1));
 		break;
 	case MLIL_ADC:
 	case MLIL_SBB:
 	case MLIL_RLC:
 	case MLIL_RRC:
-		AsTwoOperandWithCarry().GetLeftExpr().VisitExprs(func);
-		AsTwoOperandWithCarry().GetRightExpr().VisitExprs(func);
-		AsTwoOperandWithCarry().GetCarryExpr().VisitExprs(func);
+		toProcess.push_back(GetRawOperandAsIndex(0));
+		toProcess.push_back(GetRawOperandAsIndex(1));
+		toProcess.push_back(GetRawOperandAsIndex(2));
 		break;
 	case MLIL_INTRINSIC:
-		for (auto i : GetParameterExprs<MLIL_INTRINSIC>())
-			i.VisitExprs(func);
-		break;
 	case MLIL_INTRINSIC_SSA:
 	case MLIL_MEMORY_INTRINSIC_SSA:
-		for (auto i : GetParameterExprs())
-			i.VisitExprs(func);
+		AppendParameterExprIndices(*this, toProcess);
 		break;
 	default:
 		break;
 	}
+
+	std::reverse(toProcess.begin() + first, toProcess.end());
+}
+
+
+MediumLevelILInstruction MediumLevelILInstruction::GetSubExpr(size_t expr) const
+{
+	return MediumLevelILInstruction(function, function->GetRawExpr(expr), expr, instructionIndex);
+}
+
+
+void MediumLevelILInstruction::VisitExprs(const std::function<bool(const MediumLevelILInstruction& expr)>& func) const
+{
+	VisitILExprs(*this, [&](const MediumLevelILInstruction& expr) { return func(expr); });
 }
 
 
@@ -1931,14 +1926,7 @@ ExprId MediumLevelILInstruction::CopyTo(MediumLevelILFunction* dest,
 
 bool MediumLevelILInstruction::GetOperandIndexForUsage(MediumLevelILOperandUsage usage, size_t& operandIndex) const
 {
-	auto operationIter = MediumLevelILInstructionBase::operationOperandIndex.find(operation);
-	if (operationIter == MediumLevelILInstructionBase::operationOperandIndex.end())
-		return false;
-	auto usageIter = operationIter->second.find(usage);
-	if (usageIter == operationIter->second.end())
-		return false;
-	operandIndex = usageIter->second;
-	return true;
+	return operandIndexTable.GetOperandIndexForUsage(operation, usage, operandIndex);
 }
 
 
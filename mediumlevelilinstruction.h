@@ -28,7 +28,9 @@
 	#include "variable.h"
 #else
 	#include "binaryninjaapi.h"
+	#include "ilsnapshot.h"
 #endif
+#include "ilvisitor.h"
 
 #ifdef BINARYNINJACORE_LIBRARY
 namespace BinaryNinjaCore
@@ -570,8 +572,34 @@ namespace BinaryNinja
 		    MediumLevelILFunction* func, const BNMediumLevelILInstruction& instr, size_t expr, size_t instrIdx);
 		MediumLevelILInstruction(const MediumLevelILInstructionBase& instr);
 
+		void CollectSubExprs(_STD_VECTOR<size_t>& toProcess) const;
+		MediumLevelILInstruction GetSubExpr(size_t expr) const;
 		void VisitExprs(const std::function<bool(const MediumLevelILInstruction& expr)>& func) const;
 
+		/*! Visit this expression and its subexpressions in pre-order, without recursion
+
+			The callback can return an ILVisitAction, or a bool as with the std::function overload. Unlike that
+			overload, no std::function is involved and only the visited expressions are fetched.
+
+			\return false if the callback stopped the walk with StopILVisit
+		*/
+		template <typename F>
+		bool VisitExprs(F&& func) const
+		{
+			return VisitILExprs(*this, std::forward<F>(func));
+		}
+
+		/*! Visit this expression and its subexpressions, calling `preFunc` before and `postFunc` after the
+			subexpressions of each expression
+
+			\return false if a callback stopped the walk with StopILVisit
+		*/
+		template <typename PreFunc, typename PostFunc>
+		bool VisitExprs(PreFunc&& preFunc, PostFunc&& postFunc) const
+		{
+			return VisitILExprs(*this, std::forward<PreFunc>(preFunc), std::forward<PostFunc>(postFunc));
+		}
+
 		ExprId CopyTo(MediumLevelILFunction* dest) const;
 		ExprId CopyTo(MediumLevelILFunction* dest,
 		    const std::function<ExprId(const MediumLevelILInstruction& subExpr)>& subExprHandler) const;
@@ -1708,6 +1736,32 @@ namespace BinaryNinja
 	struct MediumLevelILInstructionAccessor<MLIL_FTRUNC> : public MediumLevelILOneOperandInstruction
 	{};
 
+#ifndef BINARYNINJACORE_LIBRARY
+	typedef ILSnapshotExpr<BNMediumLevelILInstruction> MediumLevelILSnapshotExpr;
+
+	/*! A copy of every expression of a MediumLevelILFunction, plus its SSA definitions and uses, taken with
+		MediumLevelILFunction::Snapshot. Nothing here calls back into the core.
+
+		\ingroup mediumlevelil
+	*/
+	class MediumLevelILFunctionSnapshot : public ILFunctionSnapshot<BNMediumLevelILInstruction>
+	{
+		ILSnapshotSSATable<SSAVariable> m_ssaVariables;
+		ILSnapshotSSATable<size_t> m_ssaMemory;
+
+		friend class MediumLevelILFunction;
+
+	  public:
+		const std::vector<SSAVariable>& GetSSAVariables() const { return m_ssaVariables.GetKeys(); }
+		const std::vector<size_t>& GetSSAMemoryVersions() const { return m_ssaMemory.GetKeys(); }
+
+		size_t GetSSAVarDefinition(const SSAVariable& var) const { return m_ssaVariables.GetDefinition(var); }
+		size_t GetSSAMemoryDefinition(size_t version) const { return m_ssaMemory.GetDefinition(version); }
+		ILSnapshotIndexRange GetSSAVarUses(const SSAVariable& var) const { return m_ssaVariables.GetUses(var); }
+		ILSnapshotIndexRange GetSSAMemoryUses(size_t version) const { return m_ssaMemory.GetUses(version); }
+	};
+#endif
+
 #undef _STD_VECTOR
 #undef _STD_SET
 #undef _STD_UNORDERED_MAP
@@ -0,0 +1,77 @@
+// Copyright (c) 2015-2024 Vector 35 Inc
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace BinaryNinja
+{
+	/*! Calls `func(i)` for every i in [0, count) on a handful of short lived threads and waits for all of them
+
+		The core worker pool is deliberately not used, since view initialization may already be running on it.
+		If `func` throws, the remaining indices are abandoned and the first exception is rethrown on the calling
+		thread once every worker has stopped.
+	*/
+	template <typename Func>
+	void ParallelForEach(size_t count, Func&& func)
+	{
+		size_t threadCount = std::min<size_t>(count, std::max<unsigned>(1, std::thread::hardware_concurrency()));
+		if (threadCount <= 1)
+		{
+			for (size_t i = 0; i < count; i++)
+				func(i);
+			return;
+		}
+
+		std::atomic<size_t> next = 0;
+		std::mutex errorMutex;
+		std::exception_ptr error;
+		std::vector<std::thread> threads;
+		threads.reserve(threadCount);
+		for (size_t t = 0; t < threadCount; t++)
+		{
+			threads.emplace_back([&]() {
+				try
+				{
+					for (size_t i = next++; i < count; i = next++)
+						func(i);
+				}
+				catch (...)
+				{
+					std::unique_lock<std::mutex> lock(errorMutex);
+					if (!error)
+						error = std::current_exception();
+					next = count;
+				}
+			});
+		}
+		for (auto& thread : threads)
+			thread.join();
+		if (error)
+			std::rethrow_exception(error);
+	}
+}  // namespace BinaryNinja
@@ -1,10 +1,81 @@
 #include "rtti.h"
+#include "parallel.h"
+
+#include <cstring>
+#include <functional>
+#include <unordered_set>
 
 using namespace BinaryNinja;
 
 constexpr int COL_SIG_REV0 = 0;
 constexpr int COL_SIG_REV1 = 1;
 constexpr int RTTI_CONFIDENCE = 100;
+// Segments are swept in chunks of this many bytes, each chunk read with a single call.
+constexpr size_t SCAN_CHUNK_SIZE = 0x100000;
+// Bytes past a candidate address that the sweeps may look at, also the gap left at the end of each segment.
+constexpr size_t SCAN_WINDOW_SIZE = 0x18;
+
+
+static uint64_t LoadValue(const uint8_t *data, size_t size, BNEndianness endianness)
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < size; i++)
+    {
+        size_t byte = endianness == LittleEndian ? size - 1 - i : i;
+        value = (value << 8) | data[byte];
+    }
+    return value;
+}
+
+
+// Sweeps every pointer aligned address of the given segments, the way the old BinaryReader loops did, but on
+// in-memory chunks spread over worker threads. isCandidate(addr, data) is called with the SCAN_WINDOW_SIZE bytes
+// at addr and must be thread safe. Candidates are returned in segment then address order.
+template <typename Func>
+static std::vector<uint64_t> SweepSegments(BinaryView *view, const std::vector<Ref<Segment>> &segments, Func &&isCandidate)
+{
+    struct Chunk
+    {
+        uint64_t start;
+        uint64_t end;
+        uint64_t readEnd;
+    };
+
+    const size_t addrSize = view->GetAddressSize();
+    std::vector<Chunk> chunks;
+    for (const auto &segment: segments)
+    {
+        uint64_t segmentEnd = segment->GetEnd();
+        if (segmentEnd - segment->GetStart() <= SCAN_WINDOW_SIZE)
+            continue;
+        uint64_t scanEnd = segmentEnd - SCAN_WINDOW_SIZE;
+        for (uint64_t start = segment->GetStart(); start < scanEnd; start += SCAN_CHUNK_SIZE)
+        {
+            uint64_t end = std::min<uint64_t>(start + SCAN_CHUNK_SIZE, scanEnd);
+            chunks.push_back({start, end, std::min<uint64_t>(end + SCAN_WINDOW_SIZE, segmentEnd)});
+        }
+    }
+
+    std::vector<std::vector<uint64_t>> candidates(chunks.size());
+    ParallelForEach(chunks.size(), [&](size_t i) {
+        const Chunk &chunk = chunks[i];
+        std::vector<uint8_t> data(chunk.readEnd - chunk.start);
+        size_t len = view->Read(data.data(), chunk.start, data.size());
+        // Chunks start at the segment start plus a multiple of SCAN_CHUNK_SIZE, so stepping by addrSize from here
+        // visits the same addresses as stepping from the segment start.
+        for (size_t offset = 0; chunk.start + offset < chunk.end && offset + SCAN_WINDOW_SIZE <= len;
+             offset += addrSize)
+        {
+            if (isCandidate(chunk.start + offset, data.data() + offset))
+                candidates[i].push_back(chunk.start + offset);
+        }
+    });
+
+    std::vector<uint64_t> result;
+    for (auto &chunkCandidates: candidates)
+        result.insert(result.end(), chunkCandidates.begin(), chunkCandidates.end());
+    return result;
+}
 
 
 ClassHierarchyDescriptor::ClassHierarchyDescriptor(BinaryView *view, uint64_t address)
@@ -503,25 +574,47 @@ std::optional<ClassInfo> MicrosoftRTTIProcessor::ProcessRTTI(uint64_t coLocatorA
 }
 
 
-std::optional<VirtualFunctionTableInfo> MicrosoftRTTIProcessor::ProcessVFT(uint64_t vftAddr, const ClassInfo &classInfo)
+std::vector<uint64_t> MicrosoftRTTIProcessor::ReadVirtualFunctions(uint64_t vftAddr)
 {
-    VirtualFunctionTableInfo vftInfo = {vftAddr};
-    // Gather all virtual functions
+    // Only reads the view, so tables can be read on worker threads.
     BinaryReader reader = BinaryReader(m_view);
     reader.Seek(vftAddr);
+    std::vector<uint64_t> vFuncAddrs = {};
+    try
+    {
+        while (true)
+        {
+            uint64_t vFuncAddr = reader.ReadPointer();
+            if (m_view->GetAnalysisFunctionsForAddress(vFuncAddr).empty())
+            {
+                Ref<Segment> segment = m_view->GetSegmentAt(vFuncAddr);
+                if (segment == nullptr || !(segment->GetFlags() & (SegmentExecutable | SegmentDenyWrite)))
+                {
+                    // Last CompleteObjectLocator or hit the next CompleteObjectLocator
+                    break;
+                }
+            }
+            vFuncAddrs.push_back(vFuncAddr);
+        }
+    }
+    catch (ReadException &)
+    {
+        // The table runs to the end of the mapped region.
+    }
+    return vFuncAddrs;
+}
+
+
+std::optional<VirtualFunctionTableInfo> MicrosoftRTTIProcessor::ProcessVFT(uint64_t vftAddr, const ClassInfo &classInfo,
+    const std::vector<uint64_t> &vFuncAddrs)
+{
+    VirtualFunctionTableInfo vftInfo = {vftAddr};
     std::vector<Ref<Function> > virtualFunctions = {};
-    while (true)
+    for (uint64_t vFuncAddr: vFuncAddrs)
     {
-        uint64_t vFuncAddr = reader.ReadPointer();
         auto funcs = m_view->GetAnalysisFunctionsForAddress(vFuncAddr);
         if (funcs.empty())
         {
-            Ref<Segment> segment = m_view->GetSegmentAt(vFuncAddr);
-            if (segment == nullptr || !(segment->GetFlags() & (SegmentExecutable | SegmentDenyWrite)))
-            {
-                // Last CompleteObjectLocator or hit the next CompleteObjectLocator
-                break;
-            }
             // TODO: Is likely a function check here?
             m_logger->LogDebug("Discovered function from virtual function table... %llx", vFuncAddr);
             auto vFunc = m_view->AddFunctionForAnalysis(m_view->GetDefaultPlatform(), vFuncAddr, true);
@@ -637,66 +730,59 @@ void MicrosoftRTTIProcessor::ProcessRTTI()
     auto start_time = std::chrono::high_resolution_clock::now();
     uint64_t startAddr = m_view->GetOriginalImageBase();
     uint64_t endAddr = m_view->GetEnd();
-    BinaryReader optReader = BinaryReader(m_view);
-    auto addrSize = m_view->GetAddressSize();
+    BNEndianness endianness = m_view->GetDefaultEndianness();
 
-    auto scan = [&](const Ref<Segment> &segment) {
-        for (uint64_t coLocatorAddr = segment->GetStart(); coLocatorAddr < segment->GetEnd() - 0x18;
-             coLocatorAddr += addrSize)
+    // Only reads memory, the colocators themselves are processed in address order afterwards.
+    auto isCoLocator = [&](uint64_t coLocatorAddr, const uint8_t *data) {
+        uint32_t sigVal = LoadValue(data, 4, endianness);
+        if (sigVal == COL_SIG_REV1)
         {
-            optReader.Seek(coLocatorAddr);
-            uint32_t sigVal = optReader.Read32();
-            if (sigVal == COL_SIG_REV1)
-            {
-                // Check for self reference
-                optReader.SeekRelative(16);
-                if (optReader.Read32() == coLocatorAddr - startAddr)
-                {
-                    if (auto classInfo = ProcessRTTI(coLocatorAddr))
-                        m_classInfo[coLocatorAddr] = classInfo.value();
-                }
-            }
-            else if (sigVal == COL_SIG_REV0)
-            {
-                // Check ?AV
-                optReader.SeekRelative(8);
-                uint64_t typeDescNameAddr = optReader.Read32() + 8;
-                if (typeDescNameAddr > startAddr && typeDescNameAddr < endAddr)
-                {
-                    // Make sure we do not read across segment boundary.
-                    auto typeDescSegment = m_view->GetSegmentAt(typeDescNameAddr);
-                    if (typeDescSegment != nullptr && typeDescSegment->GetEnd() - typeDescNameAddr > 4)
-                    {
-                        optReader.Seek(typeDescNameAddr);
-                        auto typeDescNameStart = optReader.ReadString(4);
-                        if (typeDescNameStart == ".?AV" || typeDescNameStart == ".?AU" || typeDescNameStart == ".?AW")
-                        {
-                            if (auto classInfo = ProcessRTTI(coLocatorAddr))
-                                m_classInfo[coLocatorAddr] = classInfo.value();
-                        }
-                    }
-                }
-            }
+            // Check for self reference
+            return LoadValue(data + 20, 4, endianness) == coLocatorAddr - startAddr;
+        }
+        if (sigVal == COL_SIG_REV0)
+        {
+            // Check ?AV
+            uint64_t typeDescNameAddr = LoadValue(data + 12, 4, endianness) + 8;
+            if (typeDescNameAddr <= startAddr || typeDescNameAddr >= endAddr)
+                return false;
+            // Make sure we do not read across segment boundary.
+            auto typeDescSegment = m_view->GetSegmentAt(typeDescNameAddr);
+            if (typeDescSegment == nullptr || typeDescSegment->GetEnd() - typeDescNameAddr <= 4)
+                return false;
+            char typeDescNameStart[4];
+            if (m_view->Read(typeDescNameStart, typeDescNameAddr, 4) != 4)
+                return false;
+            return memcmp(typeDescNameStart, ".?AV", 4) == 0 || memcmp(typeDescNameStart, ".?AU", 4) == 0
+                || memcmp(typeDescNameStart, ".?AW", 4) == 0;
         }
+        return false;
     };
 
     // Scan data sections for colocators.
+    std::vector<Ref<Segment>> segments;
     auto rdataSection = m_view->GetSectionByName(".rdata");
     for (const Ref<Segment> &segment: m_view->GetSegments())
     {
         if (segment->GetFlags() == (SegmentReadable | SegmentContainsData))
         {
-            m_logger->LogDebug("Attempting to find VirtualFunctionTables in segment %llx", segment->GetStart());
-            scan(segment);
+            m_logger->LogDebug("Attempting to find CompleteObjectLocators in segment %llx", segment->GetStart());
+            segments.push_back(segment);
         }
         else if (checkWritableRData && rdataSection && rdataSection->GetStart() == segment->GetStart())
         {
-            m_logger->LogDebug("Attempting to find VirtualFunctionTables in writable rdata segment %llx",
+            m_logger->LogDebug("Attempting to find CompleteObjectLocators in writable rdata segment %llx",
                                segment->GetStart());
-            scan(segment);
+            segments.push_back(segment);
         }
     }
 
+    for (uint64_t coLocatorAddr: SweepSegments(m_view, segments, isCoLocator))
+    {
+        if (auto classInfo = ProcessRTTI(coLocatorAddr))
+            m_classInfo[coLocatorAddr] = classInfo.value();
+    }
+
     auto end_time = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> elapsed_time = end_time - start_time;
     m_logger->LogInfo("ProcessRTTI took %f seconds", elapsed_time.count());
@@ -708,88 +794,165 @@ void MicrosoftRTTIProcessor::ProcessVFT()
     std::map<uint64_t, uint64_t> vftMap = {};
     std::map<uint64_t, std::optional<VirtualFunctionTableInfo>> vftFinishedMap = {};
     auto start_time = std::chrono::high_resolution_clock::now();
+    std::vector<uint64_t> coLocatorAddrs;
+    coLocatorAddrs.reserve(m_classInfo.size());
     for (auto &[coLocatorAddr, classInfo]: m_classInfo)
+        coLocatorAddrs.push_back(coLocatorAddr);
+
+    // Query the references of all colocators at once, then apply them in address order.
+    std::vector<std::vector<uint64_t>> coLocatorRefs(coLocatorAddrs.size());
+    ParallelForEach(coLocatorAddrs.size(), [&](size_t i) {
+        coLocatorRefs[i] = m_view->GetDataReferences(coLocatorAddrs[i]);
+    });
+    for (size_t i = 0; i < coLocatorAddrs.size(); i++)
     {
-        for (auto &ref: m_view->GetDataReferences(coLocatorAddr))
+        for (auto &ref: coLocatorRefs[i])
         {
             auto vftAddr = ref + m_view->GetAddressSize();
-            vftMap[coLocatorAddr] = vftAddr;
+            vftMap[coLocatorAddrs[i]] = vftAddr;
         }
     }
 
     if (virtualFunctionTableSweep)
     {
-        BinaryReader optReader = BinaryReader(m_view);
         auto addrSize = m_view->GetAddressSize();
-        auto scan = [&](const Ref<Segment> &segment) {
-            uint64_t startAddr = segment->GetStart();
-            uint64_t endAddr = segment->GetEnd();
-            for (uint64_t vtableAddr = startAddr; vtableAddr < endAddr - 0x18; vtableAddr += addrSize)
-            {
-                optReader.Seek(vtableAddr);
-                uint64_t coLocatorAddr = optReader.ReadPointer();
-                auto coLocator = m_classInfo.find(coLocatorAddr);
-                if (coLocator == m_classInfo.end())
-                    continue;
-                // Found a vtable reference to colocator.
-                vftMap[coLocatorAddr] = vtableAddr + addrSize;
-            }
+        BNEndianness endianness = m_view->GetDefaultEndianness();
+        std::unordered_set<uint64_t> knownCoLocators(coLocatorAddrs.begin(), coLocatorAddrs.end());
+        auto isColocatorRef = [&](uint64_t, const uint8_t *data) {
+            return knownCoLocators.find(LoadValue(data, addrSize, endianness)) != knownCoLocators.end();
         };
 
         // Scan data sections for virtual function tables.
+        std::vector<Ref<Segment>> segments;
         auto rdataSection = m_view->GetSectionByName(".rdata");
         for (const Ref<Segment> &segment: m_view->GetSegments())
         {
             if (segment->GetFlags() == (SegmentReadable | SegmentContainsData))
             {
                 m_logger->LogDebug("Attempting to find VirtualFunctionTables in segment %llx", segment->GetStart());
-                scan(segment);
+                segments.push_back(segment);
             }
             else if (checkWritableRData && rdataSection && rdataSection->GetStart() == segment->GetStart())
             {
                 m_logger->LogDebug("Attempting to find VirtualFunctionTables in writable rdata segment %llx",
                                    segment->GetStart());
-                scan(segment);
+                segments.push_back(segment);
             }
         }
+
+        BinaryReader optReader = BinaryReader(m_view);
+        for (uint64_t vtableAddr: SweepSegments(m_view, segments, isColocatorRef))
+        {
+            // Found a vtable reference to colocator.
+            optReader.Seek(vtableAddr);
+            vftMap[optReader.ReadPointer()] = vtableAddr + addrSize;
+        }
     }
 
-    auto GetCachedVFTInfo = [&](uint64_t vftAddr, const ClassInfo& classInfo) {
-        // Check in the cache so that we don't process vfts more than once.
-        auto cachedVftInfo = vftFinishedMap.find(vftAddr);
-        if (cachedVftInfo != vftFinishedMap.end())
-            return cachedVftInfo->second;
-        auto vftInfo = ProcessVFT(vftAddr, classInfo);
-        vftFinishedMap[vftAddr] = vftInfo;
-        return vftInfo;
+    // Index the colocators by class name so base classes don't need a scan of every class.
+    std::unordered_map<std::string, std::vector<uint64_t>> coLocatorsByName;
+    for (auto &[coLocatorAddr, classInfo]: m_classInfo)
+        coLocatorsByName[classInfo.className].push_back(coLocatorAddr);
+
+    auto baseCoLocators = [&](const ClassInfo &classInfo) -> const std::vector<uint64_t> * {
+        if (!classInfo.baseClassName.has_value())
+            return nullptr;
+        auto bases = coLocatorsByName.find(classInfo.baseClassName.value());
+        return bases == coLocatorsByName.end() ? nullptr : &bases->second;
     };
-    
+
+    // A class is processed one level after the deepest class it could take its base vtable from, so that every base
+    // vtable is finished (and adjusted for its own base) before the vtables that inherit from it.
+    std::unordered_map<uint64_t, size_t> depths;
+    std::function<size_t(uint64_t)> depthOf = [&](uint64_t coLocatorAddr) -> size_t {
+        auto [depth, inserted] = depths.try_emplace(coLocatorAddr, 0);
+        if (!inserted)
+            return depth->second;  // Either already known or part of a cycle
+        size_t result = 0;
+        if (auto bases = baseCoLocators(m_classInfo.find(coLocatorAddr)->second))
+        {
+            for (uint64_t baseCoLocAddr: *bases)
+            {
+                if (vftMap.find(baseCoLocAddr) != vftMap.end())
+                    result = std::max(result, depthOf(baseCoLocAddr) + 1);
+            }
+        }
+        depths[coLocatorAddr] = result;
+        return result;
+    };
+
+    std::vector<std::vector<uint64_t>> levels;
     for (const auto &[coLocatorAddr, vftAddr]: vftMap)
     {
-        auto classInfo = m_classInfo.find(coLocatorAddr)->second;
-        if (classInfo.baseClassName.has_value())
+        if (m_classInfo.find(coLocatorAddr) == m_classInfo.end())
+            continue;
+        size_t depth = depthOf(coLocatorAddr);
+        if (levels.size() <= depth)
+            levels.resize(depth + 1);
+        levels[depth].push_back(coLocatorAddr);
+    }
+
+    for (const auto &level: levels)
+    {
+        // Resolve the base vtables, all of which were finished in earlier levels.
+        struct PendingClass
         {
-            // Process base vtable and add it to the class info.
-            for (auto& [baseCoLocAddr, baseClassInfo] : m_classInfo)
+            uint64_t coLocatorAddr;
+            uint64_t vftAddr;
+            ClassInfo classInfo;
+        };
+        std::vector<PendingClass> pending;
+        for (uint64_t coLocatorAddr: level)
+        {
+            ClassInfo classInfo = m_classInfo.find(coLocatorAddr)->second;
+            if (auto bases = baseCoLocators(classInfo))
             {
-                if (baseClassInfo.className == classInfo.baseClassName.value())
+                for (uint64_t baseCoLocAddr: *bases)
                 {
-                    uint64_t baseVftAddr = vftMap[baseCoLocAddr];
-                    if (auto baseVftInfo = GetCachedVFTInfo(baseVftAddr, baseClassInfo))
+                    auto baseVftAddr = vftMap.find(baseCoLocAddr);
+                    if (baseVftAddr == vftMap.end())
+                        continue;
+                    auto baseVftInfo = vftFinishedMap.find(baseVftAddr->second);
+                    if (baseVftInfo != vftFinishedMap.end() && baseVftInfo->second.has_value())
                     {
-                        classInfo.baseVft = baseVftInfo.value();
+                        classInfo.baseVft = baseVftInfo->second.value();
                         break;
                     }
                 }
             }
+            pending.push_back({coLocatorAddr, vftMap[coLocatorAddr], std::move(classInfo)});
+        }
+
+        // Classes in a level are independent; only the first class to claim a vtable processes it.
+        std::vector<size_t> work;
+        std::unordered_set<uint64_t> claimed;
+        for (size_t i = 0; i < pending.size(); i++)
+        {
+            uint64_t vftAddr = pending[i].vftAddr;
+            if (vftFinishedMap.find(vftAddr) == vftFinishedMap.end() && claimed.insert(vftAddr).second)
+                work.push_back(i);
+        }
+        // Reading the tables is the slow part and is done in parallel. Creating functions, types and symbols
+        // mutates the view, so that happens here, in order.
+        std::vector<std::vector<uint64_t>> vFuncAddrs(work.size());
+        ParallelForEach(work.size(), [&](size_t i) {
+            vFuncAddrs[i] = ReadVirtualFunctions(pending[work[i]].vftAddr);
+        });
+        for (size_t i = 0; i < work.size(); i++)
+        {
+            const PendingClass &cls = pending[work[i]];
+            vftFinishedMap[cls.vftAddr] = ProcessVFT(cls.vftAddr, cls.classInfo, vFuncAddrs[i]);
         }
 
-        if (auto vftInfo = GetCachedVFTInfo(vftAddr, classInfo))
+        for (auto &[coLocatorAddr, vftAddr, classInfo]: pending)
         {
-            classInfo.vft = vftInfo.value();
+            auto &vftInfo = vftFinishedMap[vftAddr];
+            if (vftInfo.has_value())
+                classInfo.vft = vftInfo.value();
+            m_classInfo[coLocatorAddr] = std::move(classInfo);
         }
     }
-    
+
     auto end_time = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> elapsed_time = end_time - start_time;
     m_logger->LogInfo("ProcessVFT took %f seconds", elapsed_time.count());
@@ -106,7 +106,10 @@ namespace BinaryNinja {
 
 		std::optional<ClassInfo> ProcessRTTI(uint64_t coLocatorAddr);
 
-		std::optional<VirtualFunctionTableInfo> ProcessVFT(uint64_t vftAddr, const ClassInfo &classInfo);
+		std::vector<uint64_t> ReadVirtualFunctions(uint64_t vftAddr);
+
+		std::optional<VirtualFunctionTableInfo> ProcessVFT(uint64_t vftAddr, const ClassInfo &classInfo,
+			const std::vector<uint64_t> &vFuncAddrs);
 
 	public:
 		MicrosoftRTTIProcessor(const Ref<BinaryView> &view, bool useMangled = true, bool checkRData = true, bool vftSweep = true);
@@ -1,9 +1,12 @@
+#include <algorithm>
+#include <optional>
 #include <string.h>
 #ifndef _MSC_VER
 #include <cxxabi.h>
 #endif
 #include <inttypes.h>
 #include "elfview.h"
+#include "parallel.h"
 
 #define STRING_READ_CHUNK_SIZE 32
 
@@ -143,25 +146,23 @@ ElfView::ElfView(BinaryView* data, bool parseOnly): BinaryView("ELF", data->GetF
 		Elf64ProgramHeader progHeader;
 		if (m_elf32) // 32-bit ELF
 		{
-			progHeader.type = reader.Read32();
-			progHeader.offset = reader.Read32();
-			progHeader.virtualAddress = reader.Read32();
-			progHeader.physicalAddress = reader.Read32();
-			progHeader.fileSize = reader.Read32();
-			progHeader.memorySize = reader.Read32();
-			progHeader.flags = reader.Read32();
-			progHeader.align = reader.Read32();
+			auto ph32 = reader.ReadStruct<Elf32ProgramHeader>(&Elf32ProgramHeader::type, &Elf32ProgramHeader::offset,
+				&Elf32ProgramHeader::virtualAddress, &Elf32ProgramHeader::physicalAddress, &Elf32ProgramHeader::fileSize,
+				&Elf32ProgramHeader::memorySize, &Elf32ProgramHeader::flags, &Elf32ProgramHeader::align);
+			progHeader.type = ph32.type;
+			progHeader.offset = ph32.offset;
+			progHeader.virtualAddress = ph32.virtualAddress;
+			progHeader.physicalAddress = ph32.physicalAddress;
+			progHeader.fileSize = ph32.fileSize;
+			progHeader.memorySize = ph32.memorySize;
+			progHeader.flags = ph32.flags;
+			progHeader.align = ph32.align;
 		}
 		else // 64-bit ELF
 		{
-			progHeader.type = reader.Read32();
-			progHeader.flags = reader.Read32();
-			progHeader.offset = reader.Read64();
-			progHeader.virtualAddress = reader.Read64();
-			progHeader.physicalAddress = reader.Read64();
-			progHeader.fileSize = reader.Read64();
-			progHeader.memorySize = reader.Read64();
-			progHeader.align = reader.Read64();
+			progHeader = reader.ReadStruct<Elf64ProgramHeader>(&Elf64ProgramHeader::type, &Elf64ProgramHeader::flags,
+				&Elf64ProgramHeader::offset, &Elf64ProgramHeader::virtualAddress, &Elf64ProgramHeader::physicalAddress,
+				&Elf64ProgramHeader::fileSize, &Elf64ProgramHeader::memorySize, &Elf64ProgramHeader::align);
 		}
 
 		m_logger->LogDebug(
@@ -204,29 +205,27 @@ ElfView::ElfView(BinaryView* data, bool parseOnly): BinaryView("ELF", data->GetF
 			reader.Seek(header.sectionHeaderOffset + (i * header.sectionHeaderSize));
 			if (m_elf32) // 32-bit ELF
 			{
-				section.name = reader.Read32();
-				section.type = reader.Read32();
-				section.flags = reader.Read32();
-				section.address = reader.Read32();
-				section.offset = reader.Read32();
-				section.size = reader.Read32();
-				section.link = reader.Read32();
-				section.info = reader.Read32();
-				section.align = reader.Read32();
-				section.entrySize = reader.Read32();
+				auto sh32 = reader.ReadStruct<Elf32SectionHeader>(&Elf32SectionHeader::name, &Elf32SectionHeader::type,
+					&Elf32SectionHeader::flags, &Elf32SectionHeader::address, &Elf32SectionHeader::offset,
+					&Elf32SectionHeader::size, &Elf32SectionHeader::link, &Elf32SectionHeader::info,
+					&Elf32SectionHeader::align, &Elf32SectionHeader::entrySize);
+				section.name = sh32.name;
+				section.type = sh32.type;
+				section.flags = sh32.flags;
+				section.address = sh32.address;
+				section.offset = sh32.offset;
+				section.size = sh32.size;
+				section.link = sh32.link;
+				section.info = sh32.info;
+				section.align = sh32.align;
+				section.entrySize = sh32.entrySize;
 			}
 			else // 64-bit ELF
 			{
-				section.name = reader.Read32();
-				section.type = reader.Read32();
-				section.flags = reader.Read64();
-				section.address = reader.Read64();
-				section.offset = reader.Read64();
-				section.size = reader.Read64();
-				section.link = reader.Read32();
-				section.info = reader.Read32();
-				section.align = reader.Read64();
-				section.entrySize = reader.Read64();
+				section = reader.ReadStruct<Elf64SectionHeader>(&Elf64SectionHeader::name, &Elf64SectionHeader::type,
+					&Elf64SectionHeader::flags, &Elf64SectionHeader::address, &Elf64SectionHeader::offset,
+					&Elf64SectionHeader::size, &Elf64SectionHeader::link, &Elf64SectionHeader::info,
+					&Elf64SectionHeader::align, &Elf64SectionHeader::entrySize);
 			}
 
 			m_elfSections.push_back(section);
@@ -338,48 +337,83 @@ static BNSymbolBinding TranslateELFBindingType(uint8_t type)
 }
 
 
+namespace
+{
+	// Symbol table entries as they are laid out in the file
+	struct RawSymbol32 { uint32_t nameOffset, value, size; uint8_t info, other; uint16_t section; };
+	struct RawSymbol64 { uint32_t nameOffset; uint8_t info, other; uint16_t section; uint64_t value, size; };
+}
+
+
+template <typename RawSymbol>
+static ElfSymbolTableEntry MakeSymbolTableEntry(const RawSymbol& raw, bool dynamic)
+{
+	ElfSymbolTableEntry entry;
+	entry.nameOffset = raw.nameOffset;
+	entry.type = ELF_ST_TYPE(raw.info);
+	entry.binding = TranslateELFBindingType(ELF_ST_BIND(raw.info));
+	entry.other = raw.other;
+	entry.section = raw.section;
+	entry.value = raw.value;
+	entry.size = raw.size;
+	entry.dynamic = dynamic;
+	return entry;
+}
+
+
+// Reads count consecutive symbol table entries from the reader's position with one read, without their names
+static vector<ElfSymbolTableEntry> ReadSymbolTableEntries(BinaryReader& reader, size_t count, bool elf32, bool dynamic)
+{
+	vector<ElfSymbolTableEntry> result;
+	result.reserve(count);
+	if (elf32)
+	{
+		for (auto& raw : reader.ReadArray<RawSymbol32>(count, &RawSymbol32::nameOffset, &RawSymbol32::value,
+			&RawSymbol32::size, &RawSymbol32::info, &RawSymbol32::other, &RawSymbol32::section))
+			result.push_back(MakeSymbolTableEntry(raw, dynamic));
+	}
+	else
+	{
+		for (auto& raw : reader.ReadArray<RawSymbol64>(count, &RawSymbol64::nameOffset, &RawSymbol64::info,
+			&RawSymbol64::other, &RawSymbol64::section, &RawSymbol64::value, &RawSymbol64::size))
+			result.push_back(MakeSymbolTableEntry(raw, dynamic));
+	}
+	return result;
+}
+
+
+void ElfView::ReadSymbolName(BinaryReader& reader, ElfSymbolTableEntry& entry, const Elf64SectionHeader& stringTable)
+{
+	if (entry.type == ELF_STT_SECTION)
+	{
+		if (entry.section < m_elfSections.size())
+			entry.name = ReadStringTableView(reader, m_sectionStringTable, m_elfSections[entry.section].name);
+	}
+	else
+	{
+		entry.name = ReadStringTableView(reader, stringTable, entry.nameOffset);
+	}
+}
+
+
 bool ElfView::ParseSymbolTableEntry(BinaryReader& reader, ElfSymbolTableEntry& entry, uint64_t sym,
 	const Elf64SectionHeader& symbolTable, const Elf64SectionHeader& stringTable, bool dynamic)
 {
 	try
 	{
-		entry.dynamic = dynamic;
 		if (m_elf32)
 		{
 			reader.Seek(symbolTable.offset + (sym * 16));
-			entry.nameOffset = reader.Read32();
-			entry.value = reader.Read32();
-			entry.size = reader.Read32();
-			uint8_t info = reader.Read8();
-			entry.type = ELF_ST_TYPE(info);
-			entry.binding = TranslateELFBindingType(ELF_ST_BIND(info));
-			entry.other = reader.Read8();
-			entry.section = reader.Read16();
+			entry = MakeSymbolTableEntry(reader.ReadStruct<RawSymbol32>(&RawSymbol32::nameOffset, &RawSymbol32::value,
+				&RawSymbol32::size, &RawSymbol32::info, &RawSymbol32::other, &RawSymbol32::section), dynamic);
 		}
 		else
 		{
 			reader.Seek(symbolTable.offset + (sym * 24));
-			entry.nameOffset = reader.Read32();
-			uint8_t info = reader.Read8();
-			entry.type = ELF_ST_TYPE(info);
-			entry.binding = TranslateELFBindingType(ELF_ST_BIND(info));
-			entry.other = reader.Read8();
-			entry.section = reader.Read16();
-			entry.value = reader.Read64();
-			entry.size = reader.Read64();
-		}
-
-		if (entry.type == ELF_STT_SECTION)
-		{
-			if (entry.section < m_elfSections.size())
-			{
-				entry.name = ReadStringTable(reader, m_sectionStringTable, m_elfSections[entry.section].name);
-			}
-		}
-		else
-		{
-			entry.name = ReadStringTable(reader, stringTable, entry.nameOffset);
+			entry = MakeSymbolTableEntry(reader.ReadStruct<RawSymbol64>(&RawSymbol64::nameOffset, &RawSymbol64::info,
+				&RawSymbol64::other, &RawSymbol64::section, &RawSymbol64::value, &RawSymbol64::size), dynamic);
 		}
+		ReadSymbolName(reader, entry, stringTable);
 	}
 	catch (ReadException&)
 	{
@@ -395,7 +429,7 @@ bool ElfView::ParseSymbolTableEntry(BinaryReader& reader, ElfSymbolTableEntry& e
 		"\tsection    = %#04x\n"
 		"\tvalue      = %#012lx\n"
 		"\tsize       = %#012lx\n"
-		"\tname       = %#s",
+		"\tname       = %.*s",
 		sym, symbolTable.offset, stringTable.offset,
 		entry.nameOffset,
 		entry.type,
@@ -404,7 +438,7 @@ bool ElfView::ParseSymbolTableEntry(BinaryReader& reader, ElfSymbolTableEntry& e
 		entry.section,
 		entry.value,
 		entry.size,
-		entry.name.c_str());
+		(int)entry.name.size(), entry.name.data());
 	return true;
 }
 
@@ -417,14 +451,49 @@ void ElfView::GetRelocEntries(BinaryReader& reader, const vector<Elf64SectionHea
 
 	for (auto& section : sections)
 	{
-		for (uint64_t j = 0; j < section.size / relocSize; j++)
+		// Each relocation is 2 or 3 words, read the whole section's worth at once
+		size_t count = section.size / relocSize;
+		size_t wordsPerReloc = implicit ? 2 : 3;
+		vector<uint64_t> words;
+		try
+		{
+			reader.Seek(section.offset);
+			if (m_elf32)
+			{
+				vector<uint32_t> words32 = reader.ReadArray<uint32_t>(count * wordsPerReloc);
+				words.assign(words32.begin(), words32.end());
+			}
+			else
+			{
+				words = reader.ReadArray<uint64_t>(count * wordsPerReloc);
+			}
+		}
+		catch (ReadException&)
+		{
+			// Part of the section can't be read, keep the entries before the first one that can't. The read of that
+			// entry throws to the caller, which stops at the first unreadable relocation as before.
+			for (size_t j = 0; j < count; j++)
+			{
+				reader.Seek(section.offset + (j * relocSize));
+				uint64_t ofs = m_elf32 ? reader.Read32() : reader.Read64();
+				uint64_t info = m_elf32 ? reader.Read32() : reader.Read64();
+				uint64_t addend = 0;
+				if (!implicit)
+					addend = m_elf32 ? reader.Read32() : reader.Read64();
+
+				result.push_back(ELFRelocEntry(ofs, info >> (m_elf32 ? 8 : 32), info & (m_elf32 ? 0xff : 0xffffffff),
+					addend, section.info, implicit));
+			}
+			continue;
+		}
+
+		// Only reserve once the section has been read, the count comes straight from the section header
+		result.reserve(result.size() + words.size() / wordsPerReloc);
+		for (size_t j = 0; j < count; j++)
 		{
-			reader.Seek(section.offset + (j * relocSize));
-			uint64_t ofs = m_elf32 ? reader.Read32() : reader.Read64();
-			uint64_t info = m_elf32 ? reader.Read32() : reader.Read64();
-			uint64_t addend = 0;
-			if (!implicit)
-				addend = m_elf32 ? reader.Read32() : reader.Read64();
+			uint64_t ofs = words[j * wordsPerReloc];
+			uint64_t info = words[j * wordsPerReloc + 1];
+			uint64_t addend = implicit ? 0 : words[j * wordsPerReloc + 2];
 
 			result.push_back(ELFRelocEntry(ofs, info >> (m_elf32 ? 8 : 32), info & (m_elf32 ? 0xff : 0xffffffff),
 				addend, section.info, implicit));
@@ -761,6 +830,7 @@ bool ElfView::Init()
 	if (m_parseOnly)
 	{
 		m_stringTableCache.clear();
+		m_symbolNameStorage.clear();
 		return true;
 	}
 
@@ -1330,6 +1400,14 @@ bool ElfView::Init()
 
 	ParseMiniDebugInfo();
 
+	// Demangle the queued symbols' names up front, so the queue finds them in the cache
+	if (m_arch)
+	{
+		bool simplify = Settings::Instance()->Get<bool>("analysis.types.templateSimplifier", this);
+		m_demangleCache.DemangleBatch(m_arch, m_queuedSymbolNames, this, simplify);
+	}
+	m_queuedSymbolNames.clear();
+
 	// Process the queued symbols
 	m_symbolQueue->Process();
 	delete m_symbolQueue;
@@ -1342,39 +1420,136 @@ bool ElfView::Init()
 	{
 		try
 		{
-			for (auto& reloc: relocs)
+			// In unlinked images reloc.offset is relative to the info section specified. Look each of those
+			// sections up once rather than once per relocation. Relocations against a section that doesn't exist
+			// are left without a start and skipped.
+			vector<optional<uint64_t>> relocSectionStarts;
+			auto relocSectionStart = [&](const ELFRelocEntry& reloc) {
+				if (reloc.sectionIdx >= relocSectionStarts.size())
+					return optional<uint64_t>();
+				return relocSectionStarts[reloc.sectionIdx];
+			};
+			if (m_objectFile)
 			{
-				BNRelocationInfo relocInfo;
-				memset(&relocInfo, 0, sizeof(BNRelocationInfo));
-				if (m_objectFile)
+				relocSectionStarts.resize(m_elfSections.size());
+				vector<bool> relocSectionSeen(m_elfSections.size());
+				size_t invalidSectionCount = 0;
+				for (auto& reloc : relocs)
 				{
-					// In unlinked images reloc.offset is relative to the info section specified
 					if (reloc.sectionIdx >= m_elfSections.size())
-						throw ReadException();
+					{
+						invalidSectionCount++;
+						continue;
+					}
+					if (relocSectionSeen[reloc.sectionIdx])
+						continue;
+					relocSectionSeen[reloc.sectionIdx] = true;
 					auto sectionName = ReadStringTable(reader, m_sectionStringTable, m_elfSections[reloc.sectionIdx].name);
-					auto sec = GetSectionByName(sectionName);
-					if (!sec)
+					if (auto sec = GetSectionByName(sectionName); sec)
+						relocSectionStarts[reloc.sectionIdx] = sec->GetStart();
+				}
+				if (invalidSectionCount)
+					m_logger->LogWarn("Skipping %zu relocations with an invalid section index", invalidSectionCount);
+			}
+
+			// Read the relocated bytes from one read of each segment instead of one read per relocation
+			vector<Ref<Segment>> segments = GetSegments();
+			sort(segments.begin(), segments.end(),
+				[](const Ref<Segment>& a, const Ref<Segment>& b) { return a->GetStart() < b->GetStart(); });
+			vector<DataBuffer> segmentData(segments.size());
+			vector<bool> segmentRead(segments.size());
+			auto findSegment = [&](uint64_t addr) {
+				auto i = upper_bound(segments.begin(), segments.end(), addr,
+					[](uint64_t value, const Ref<Segment>& segment) { return value < segment->GetStart(); });
+				if (i == segments.begin() || addr >= (*(i - 1))->GetEnd())
+					return segments.size();
+				return (size_t)(i - segments.begin() - 1);
+			};
+
+			vector<size_t> relocSegments(relocs.size());
+			for (size_t i = 0; i < relocs.size(); i++)
+			{
+				auto& reloc = relocs[i];
+				if (m_objectFile)
+				{
+					auto sectionStart = relocSectionStart(reloc);
+					if (!sectionStart)
+						continue;
+					reloc.offset += *sectionStart - imageBaseAdjustment;
+				}
+				relocSegments[i] = findSegment(reloc.offset);
+				if (relocSegments[i] < segments.size() && !segmentRead[relocSegments[i]])
+				{
+					segmentRead[relocSegments[i]] = true;
+					auto& segment = segments[relocSegments[i]];
+					segmentData[relocSegments[i]] = ReadBuffer(segment->GetStart(),
+						std::min(segment->GetLength(), segment->GetDataLength()));
+				}
+			}
+
+			vector<const uint8_t*> segmentBytes(segments.size());
+			vector<size_t> segmentLengths(segments.size());
+			for (size_t i = 0; i < segments.size(); i++)
+			{
+				segmentBytes[i] = (const uint8_t*)segmentData[i].GetData();
+				segmentLengths[i] = segmentData[i].GetLength();
+			}
+
+			// Fill in the relocation infos a chunk at a time, then hand them over in the original order
+			constexpr size_t RelocsPerChunk = 4096;
+			vector<BNRelocationInfo> relocInfos(relocs.size());
+			vector<uint8_t> relocValid(relocs.size());
+			vector<uint8_t> relocCached(relocs.size());
+			ParallelForEach((relocs.size() + RelocsPerChunk - 1) / RelocsPerChunk, [&](size_t chunk) {
+				size_t end = std::min(relocs.size(), (chunk + 1) * RelocsPerChunk);
+				for (size_t i = chunk * RelocsPerChunk; i < end; i++)
+				{
+					const auto& reloc = relocs[i];
+					if (m_objectFile && !relocSectionStart(reloc))
 						continue;
-					reloc.offset += sec->GetStart() - imageBaseAdjustment;
+
+					BNRelocationInfo& relocInfo = relocInfos[i];
+					memset(&relocInfo, 0, sizeof(BNRelocationInfo));
+					relocInfo.symbolIndex = reloc.sym;
+					relocInfo.address = reloc.offset;
+					relocInfo.nativeType = reloc.relocType;
+					relocInfo.addend = reloc.addend;
+					relocInfo.implicitAddend = reloc.implicit;
+					relocInfo.base = baseAddress;
+					relocValid[i] = 1;
+
+					size_t segment = relocSegments[i];
+					if (segment >= segments.size())
+						continue;
+					uint64_t offset = reloc.offset - segments[segment]->GetStart();
+					if (offset + MAX_RELOCATION_SIZE > segmentLengths[segment])
+						continue;
+					memcpy(relocInfo.relocationDataCache, segmentBytes[segment] + offset, MAX_RELOCATION_SIZE);
+					relocCached[i] = 1;
 				}
+			});
 
-				relocInfo.symbolIndex = reloc.sym;
-				relocInfo.address = reloc.offset;
-				relocInfo.nativeType = reloc.relocType;
-				relocInfo.addend = reloc.addend;
-				relocInfo.implicitAddend = reloc.implicit;
-				relocInfo.base = baseAddress;
-				virtualReader.Seek(relocInfo.address);
-				memset(relocInfo.relocationDataCache, 0, sizeof(relocInfo.relocationDataCache));
-				virtualReader.TryRead(relocInfo.relocationDataCache, MAX_RELOCATION_SIZE);
+			m_relocationInfo.reserve(m_relocationInfo.size() + relocs.size());
+			for (size_t i = 0; i < relocs.size(); i++)
+			{
+				if (!relocValid[i])
+					continue;
+
+				BNRelocationInfo& relocInfo = relocInfos[i];
+				if (!relocCached[i])
+				{
+					// Runs past the end of the segment's data, or isn't in a segment; read whatever is there
+					virtualReader.Seek(relocInfo.address);
+					virtualReader.TryRead(relocInfo.relocationDataCache, MAX_RELOCATION_SIZE);
+				}
 				m_relocationInfo.push_back(relocInfo);
 
 				if (isArmV7)
 				{
-					if(reloc.relocType == R_ARM_TLS_DTPOFF32)
-						tlsOffsets.push_back(reloc.offset);
-					else if(reloc.relocType == R_ARM_TLS_DTPMOD32)
-						tlsModuleStarts.push_back(reloc.offset);
+					if(relocs[i].relocType == R_ARM_TLS_DTPOFF32)
+						tlsOffsets.push_back(relocs[i].offset);
+					else if(relocs[i].relocType == R_ARM_TLS_DTPMOD32)
+						tlsModuleStarts.push_back(relocs[i].offset);
 				}
 			}
 
@@ -1415,7 +1590,7 @@ bool ElfView::Init()
 						if (entry.type == ELF_STT_SECTION)
 						{
 							// Section relative relocation
-							if (auto section = GetSectionByName(entry.name); section)
+							if (auto section = GetSectionByName(string(entry.name)); section)
 							{
 								DefineRelocation(m_arch, relocInfo, section->GetStart(), relocInfo.address);
 								continue;
@@ -1426,39 +1601,40 @@ bool ElfView::Init()
 							// handle anonymous symbol generation
 							if (!entry.name.size())
 							{
-								entry.name = "anonymous_";
+								string anonymousName = "anonymous_";
 								if (entry.type == ELF_STT_FUNC)
-									entry.name += "func";
+									anonymousName += "func";
 								else if (entry.type == ELF_STT_OBJECT)
-									entry.name += "object";
+									anonymousName += "object";
 								else
-									entry.name += "data";
-								entry.name += "_";
+									anonymousName += "data";
+								anonymousName += "_";
 
 								switch(entry.binding)
 								{
 									case NoBinding:
-										entry.name += "bind_none";
+										anonymousName += "bind_none";
 										break;
 									case LocalBinding:
-										entry.name += "bind_local";
+										anonymousName += "bind_local";
 										break;
 									case GlobalBinding:
-										entry.name += "bind_global";
+										anonymousName += "bind_global";
 										break;
 									case WeakBinding:
-										entry.name += "bind_weak";
+										anonymousName += "bind_weak";
 										break;
 									default:
 										break;
 								}
-								entry.name += "_";
-								entry.name += std::to_string(anonymousEntryCount++);
+								anonymousName += "_";
+								anonymousName += std::to_string(anonymousEntryCount++);
+								entry.name = m_symbolNameStorage.emplace_back(std::move(anonymousName));
 								DefineElfSymbol(ExternalSymbol, entry.name, 0, false, entry.binding, entry.size);
 							}
 
 							// section undefined so query for external symbol directly
-							auto symbol = GetSymbolByRawName(entry.name, GetExternalNameSpace());
+							auto symbol = GetSymbolByRawName(string(entry.name), GetExternalNameSpace());
 							if (symbol)
 							{
 								DefineRelocation(m_arch, relocInfo, symbol, relocInfo.address);
@@ -1478,7 +1654,7 @@ bool ElfView::Init()
 						}
 
 						// retrieve first symbol that is not a symbol relocation
-						auto symbols = GetSymbolsByName(entry.name);
+						auto symbols = GetSymbolsByName(string(entry.name));
 						for (const auto& symbol : symbols)
 						{
 							if (symbol->GetAddress() == relocInfo.address)
@@ -2373,18 +2549,20 @@ bool ElfView::Init()
 	double t = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count() / 1000.0;
 	m_logger->LogInfo("ELF parsing took %.3f seconds\n", t);
 	m_stringTableCache.clear();
+	m_symbolNameStorage.clear();
+	m_demangleCache.Clear();
 	return true;
 }
 
 
-void ElfView::DefineElfSymbol(BNSymbolType type, const string& incomingName, uint64_t addr, bool gotEntry,
+void ElfView::DefineElfSymbol(BNSymbolType type, string_view incomingName, uint64_t addr, bool gotEntry,
 	BNSymbolBinding binding, size_t size, Ref<Type> typeObj)
 {
 	// Ensure symbol is within the executable
 	if (type != ExternalSymbol && !IsValidOffset(addr))
 		return;
 
-	string name = incomingName;
+	string name(incomingName);
 	Ref<Type> symbolTypeRef;
 	if ((type == ExternalSymbol) || (type == ImportAddressSymbol) || (type == ImportedDataSymbol))
 	{
@@ -2436,6 +2614,12 @@ void ElfView::DefineElfSymbol(BNSymbolType type, const string& incomingName, uin
 	if (gotEntry)
 		m_gotEntryLocations.emplace(addr);
 
+	// If name does not start with alphabetic character or symbol, prepend an underscore
+	string rawName = name;
+	if (!(((name[0] >= 'A') && (name[0] <= 'Z')) || ((name[0] >= 'a') && (name[0] <= 'z')) || (name[0] == '_')
+			|| (name[0] == '?') || (name[0] == '$') || (name[0] == '@') || (name[0] == '.')))
+		rawName = "_" + name;
+
 	auto process = [=]() {
 		NameSpace nameSpace = GetInternalNameSpace();
 		if (type == ExternalSymbol)
@@ -2443,12 +2627,6 @@ void ElfView::DefineElfSymbol(BNSymbolType type, const string& incomingName, uin
 			nameSpace = GetExternalNameSpace();
 		}
 
-		// If name does not start with alphabetic character or symbol, prepend an underscore
-		string rawName = name;
-		if (!(((name[0] >= 'A') && (name[0] <= 'Z')) || ((name[0] >= 'a') && (name[0] <= 'z')) || (name[0] == '_')
-				|| (name[0] == '?') || (name[0] == '$') || (name[0] == '@') || (name[0] == '.')))
-			rawName = "_" + name;
-
 		// Try to demangle any C++ symbols
 		string shortName = rawName;
 		string fullName = rawName;
@@ -2458,7 +2636,7 @@ void ElfView::DefineElfSymbol(BNSymbolType type, const string& incomingName, uin
 			QualifiedName demangledName;
 			Ref<Type> demangledType;
 			bool simplify = Settings::Instance()->Get<bool>("analysis.types.templateSimplifier", this);
-			if (DemangleGeneric(m_arch, rawName, demangledType, demangledName, this, simplify))
+			if (m_demangleCache.Demangle(m_arch, rawName, demangledType, demangledName, this, simplify))
 			{
 				shortName = demangledName.GetString();
 				fullName = shortName;
@@ -2480,6 +2658,8 @@ void ElfView::DefineElfSymbol(BNSymbolType type, const string& incomingName, uin
 
 	if (m_symbolQueue)
 	{
+		if (m_arch)
+			m_queuedSymbolNames.push_back(rawName);
 		m_symbolQueue->Append(process, [this](Symbol* symbol, Type* type) {
 			DefineAutoSymbolAndVariableOrFunction(GetDefaultPlatform(), symbol, type);
 		});
@@ -2564,8 +2744,14 @@ void ElfView::ApplyTypesToStringTable(const Elf64SectionHeader& section, const i
 
 string ElfView::ReadStringTable(BinaryReader& reader, const Elf64SectionHeader& section, uint64_t offset)
 {
-	if (offset == 0 || offset > section.size)
-		return "";
+	return string(ReadStringTableView(reader, section, offset));
+}
+
+
+string_view ElfView::ReadStringTableView(BinaryReader& reader, const Elf64SectionHeader& section, uint64_t offset)
+{
+	if (offset == 0 || offset >= section.size)
+		return {};
 
 	auto itr = m_stringTableCache.find(section.offset);
 	if (itr == m_stringTableCache.end())
@@ -2573,7 +2759,7 @@ string ElfView::ReadStringTable(BinaryReader& reader, const Elf64SectionHeader&
 		if (section.size > GetParentView()->GetLength())
 		{
 			m_logger->LogError("Unable to read string table with section offset: 0x%" PRIx64 " size: 0x%" PRIx64, section.offset, section.size);
-			return "";
+			return {};
 		}
 
 		std::vector<char>& tableCache = m_stringTableCache[section.offset];
@@ -2583,8 +2769,13 @@ string ElfView::ReadStringTable(BinaryReader& reader, const Elf64SectionHeader&
 		itr = m_stringTableCache.find(section.offset);
 	}
 
+	// Tables are cached by offset, so one cached for a smaller section header may be shorter than this one
 	const std::vector<char>& tableCache = itr->second;
-	return std::string(&tableCache[offset], strlen(tableCache.data() + offset));
+	if (offset >= tableCache.size())
+		return {};
+	const char* start = tableCache.data() + offset;
+	const char* end = (const char*)memchr(start, 0, tableCache.size() - offset);
+	return string_view(start, end ? (end - start) : (tableCache.size() - offset));
 }
 
 
@@ -2653,38 +2844,74 @@ void ElfView::ParseMiniDebugInfo()
 vector<ElfSymbolTableEntry> ElfView::ParseSymbolTable(BinaryReader& reader, const Elf64SectionHeader& symbolSection,
 	const Elf64SectionHeader& stringSection, bool dynamic, size_t startEntry)
 {
-	size_t size = (size_t)symbolSection.size / (m_elf32 ? 16 : 24);
+	// Entries are read a block at a time and decoded from that read; names stay views into the cached string table
+	constexpr size_t BlockEntries = 0x1000;
+	size_t entrySize = m_elf32 ? 16 : 24;
+	size_t size = (size_t)symbolSection.size / entrySize;
 	vector<ElfSymbolTableEntry> result;
-	for (size_t i = startEntry; i < size; i++)
+	for (size_t blockStart = startEntry; blockStart < size; blockStart += BlockEntries)
 	{
-		ElfSymbolTableEntry entry;
-		if (!ParseSymbolTableEntry(reader, entry, i, symbolSection, stringSection, dynamic))
-			break;
+		size_t count = std::min(size - blockStart, BlockEntries);
+		vector<ElfSymbolTableEntry> block;
+		bool truncated = false;
+		try
+		{
+			reader.Seek(symbolSection.offset + (blockStart * entrySize));
+			block = ReadSymbolTableEntries(reader, count, m_elf32, dynamic);
+		}
+		catch (ReadException&)
+		{
+			// Part of the block can't be read, keep the entries before the first one that can't
+			block.clear();
+			for (size_t i = blockStart; i < blockStart + count; i++)
+			{
+				ElfSymbolTableEntry entry;
+				if (!ParseSymbolTableEntry(reader, entry, i, symbolSection, stringSection, dynamic))
+					break;
+				block.push_back(entry);
+			}
+			truncated = true;
+		}
 
-		/* TODO: PPC64 specific symbol handling to be moved to architecture extension for ELF */
-		if (m_commonHeader.arch == EM_PPC64 && entry.type == ELF_STT_FUNC)
+		for (auto& entry : block)
 		{
-			uint64_t func_start;
-			if (DerefPpc64Descriptor(reader, entry.value, func_start))
+			try
+			{
+				ReadSymbolName(reader, entry, stringSection);
+			}
+			catch (ReadException&)
 			{
-				if (entry.name[0] != '.')
+				return result;
+			}
+
+			/* TODO: PPC64 specific symbol handling to be moved to architecture extension for ELF */
+			if (m_commonHeader.arch == EM_PPC64 && entry.type == ELF_STT_FUNC)
+			{
+				uint64_t func_start;
+				if (DerefPpc64Descriptor(reader, entry.value, func_start))
 				{
-					/* new symbol with function entry as address */
-					ElfSymbolTableEntry entry2 = entry;
-					entry2.name = "." + entry2.name;
-					entry2.value = func_start;
-					result.push_back(entry2);
+					if (entry.name.empty() || entry.name[0] != '.')
+					{
+						/* new symbol with function entry as address */
+						ElfSymbolTableEntry entry2 = entry;
+						entry2.name = m_symbolNameStorage.emplace_back("." + string(entry.name));
+						entry2.value = func_start;
+						result.push_back(entry2);
 
-					m_logger->LogDebug("PPC64 symbol %s=%016x to %s=%016x\n", entry.name.c_str(), entry.value,
-						entry2.name.c_str(), entry2.value);
+						m_logger->LogDebug("PPC64 symbol %.*s=%016x to %.*s=%016x\n", (int)entry.name.size(),
+							entry.name.data(), entry.value, (int)entry2.name.size(), entry2.name.data(), entry2.value);
 
-					/* force the descriptor to a data symbol */
-					entry.type = ELF_STT_OBJECT;
+						/* force the descriptor to a data symbol */
+						entry.type = ELF_STT_OBJECT;
+					}
 				}
 			}
+
+			result.push_back(entry);
 		}
 
-		result.push_back(entry);
+		if (truncated)
+			break;
 	}
 
 	return result;
@@ -2794,9 +3021,8 @@ uint64_t ElfViewType::ParseHeaders(BinaryView* data, ElfIdent& ident, ElfCommonH
 	// parse ElfCommonHeader
 	reader.SetEndianness(endianness);
 	reader.Seek(sizeof(ident));
-	commonHeader.type = reader.Read16();
-	commonHeader.arch = reader.Read16();
-	commonHeader.version = reader.Read32();
+	commonHeader = reader.ReadStruct<ElfCommonHeader>(
+		&ElfCommonHeader::type, &ElfCommonHeader::arch, &ElfCommonHeader::version);
 
 	// Promote the file class to 64-bit
 	// TODO potentially add a setting to allow the user to override header interpretation
@@ -2811,29 +3037,27 @@ uint64_t ElfViewType::ParseHeaders(BinaryView* data, ElfIdent& ident, ElfCommonH
 	// parse Elf64Header
 	if (ident.fileClass == 1) // 32-bit ELF
 	{
-		header.entry = reader.Read32();
-		header.programHeaderOffset = reader.Read32();
-		header.sectionHeaderOffset = reader.Read32();
-		header.flags = reader.Read32();
-		header.headerSize = reader.Read16();
-		header.programHeaderSize = reader.Read16();
-		header.programHeaderCount = reader.Read16();
-		header.sectionHeaderSize = reader.Read16();
-		header.sectionHeaderCount = reader.Read16();
-		header.stringTable = reader.Read16();
+		auto header32 = reader.ReadStruct<Elf32Header>(&Elf32Header::entry, &Elf32Header::programHeaderOffset,
+			&Elf32Header::sectionHeaderOffset, &Elf32Header::flags, &Elf32Header::headerSize,
+			&Elf32Header::programHeaderSize, &Elf32Header::programHeaderCount, &Elf32Header::sectionHeaderSize,
+			&Elf32Header::sectionHeaderCount, &Elf32Header::stringTable);
+		header.entry = header32.entry;
+		header.programHeaderOffset = header32.programHeaderOffset;
+		header.sectionHeaderOffset = header32.sectionHeaderOffset;
+		header.flags = header32.flags;
+		header.headerSize = header32.headerSize;
+		header.programHeaderSize = header32.programHeaderSize;
+		header.programHeaderCount = header32.programHeaderCount;
+		header.sectionHeaderSize = header32.sectionHeaderSize;
+		header.sectionHeaderCount = header32.sectionHeaderCount;
+		header.stringTable = header32.stringTable;
 	}
 	else if (ident.fileClass == 2) // 64-bit ELF
 	{
-		header.entry = reader.Read64();
-		header.programHeaderOffset = reader.Read64();
-		header.sectionHeaderOffset = reader.Read64();
-		header.flags = reader.Read32();
-		header.headerSize = reader.Read16();
-		header.programHeaderSize = reader.Read16();
-		header.programHeaderCount = reader.Read16();
-		header.sectionHeaderSize = reader.Read16();
-		header.sectionHeaderCount = reader.Read16();
-		header.stringTable = reader.Read16();
+		header = reader.ReadStruct<Elf64Header>(&Elf64Header::entry, &Elf64Header::programHeaderOffset,
+			&Elf64Header::sectionHeaderOffset, &Elf64Header::flags, &Elf64Header::headerSize,
+			&Elf64Header::programHeaderSize, &Elf64Header::programHeaderCount, &Elf64Header::sectionHeaderSize,
+			&Elf64Header::sectionHeaderCount, &Elf64Header::stringTable);
 	}
 	else
 	{
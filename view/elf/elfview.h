@@ -1,7 +1,9 @@
 #pragma once
 
 #include "binaryninjaapi.h"
+#include <deque>
 #include <exception>
+#include <string_view>
 
 #define ELF_PT_NULL    0
 #define ELF_PT_LOAD    1
@@ -462,7 +464,7 @@ namespace BinaryNinja
 		uint16_t section;
 		uint64_t value;
 		uint64_t size;
-		std::string name;
+		std::string_view name;  // Into the view's string table cache, valid until Init returns
 		bool dynamic;
 	};
 
@@ -496,6 +498,7 @@ namespace BinaryNinja
 		bool m_simplifyTemplates;
 		bool m_relocatable = false;
 		std::map<uint64_t, std::vector<char>> m_stringTableCache;
+		std::deque<std::string> m_symbolNameStorage;  // Names made up while parsing, which aren't in any string table
 
 		// Section and program headers, internally use 64-bit form as it is a superset of 32-bit
 		std::vector<Elf64SectionHeader> m_elfSections;
@@ -516,13 +519,17 @@ namespace BinaryNinja
 		uint64_t m_gnuHashHeader = 0;
 
 		SymbolQueue* m_symbolQueue = nullptr;
+		DemangleCache m_demangleCache;  // Only kept while Init runs
+		std::vector<std::string> m_queuedSymbolNames;  // Raw names of the symbols waiting in m_symbolQueue
 
-		void DefineElfSymbol(BNSymbolType type, const std::string& name, uint64_t addr, bool gotEntry,
+		void DefineElfSymbol(BNSymbolType type, std::string_view name, uint64_t addr, bool gotEntry,
 			BNSymbolBinding binding, size_t size=0, Ref<Type> typeObj=nullptr);
 
 		void ApplyTypesToParentStringTable(const Elf64SectionHeader& section, const bool offset = true);
 		void ApplyTypesToStringTable(const Elf64SectionHeader& section, const int64_t imageBaseAdjustment, const bool offset = true);
 		std::string ReadStringTable(BinaryReader& view, const Elf64SectionHeader& section, uint64_t offset);
+		std::string_view ReadStringTableView(BinaryReader& view, const Elf64SectionHeader& section, uint64_t offset);
+		void ReadSymbolName(BinaryReader& reader, ElfSymbolTableEntry& entry, const Elf64SectionHeader& stringTable);
 		bool ParseSymbolTableEntry(BinaryReader& reader, ElfSymbolTableEntry& entry, uint64_t sym,
 			const Elf64SectionHeader& symbolTable, const Elf64SectionHeader& stringTable, bool dynamic);
 
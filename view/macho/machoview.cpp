@@ -1,10 +1,12 @@
 #include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <sstream>
 #include <stdlib.h>
 #include <string.h>
 #include <inttypes.h>
 #include <tuple>
+#include <unordered_set>
 #ifndef _MSC_VER
 #include <cxxabi.h>
 #endif
@@ -12,6 +14,7 @@
 #include "fatmachoview.h"
 #include "universalview.h"
 #include "lowlevelilinstruction.h"
+#include "parallel.h"
 #include "rapidjsonwrapper.h"
 
 enum {
@@ -169,7 +172,7 @@ static int64_t readSLEB128(DataBuffer& buffer, size_t length, size_t &offset)
 }
 
 
-static uint64_t readLEB128(DataBuffer& p, size_t end, size_t &offset)
+static uint64_t readLEB128(const uint8_t* p, size_t end, size_t &offset)
 {
 	uint64_t result = 0;
 	int bit = 0;
@@ -190,12 +193,33 @@ static uint64_t readLEB128(DataBuffer& p, size_t end, size_t &offset)
 }
 
 
-uint64_t readValidULEB128(DataBuffer& buffer, size_t& cursor)
+static uint64_t readLEB128(DataBuffer& p, size_t end, size_t &offset)
 {
-	uint64_t value = readLEB128(buffer, buffer.GetLength(), cursor);
-	if ((int64_t)value == -1)
-		throw ReadException();
-	return value;
+	return readLEB128((const uint8_t*)p.GetData(), std::min(end, p.GetLength()), offset);
+}
+
+
+static uint64_t readPointer(const uint8_t* data, size_t size, BNEndianness endian)
+{
+	uint64_t result = 0;
+	if (endian == LittleEndian)
+	{
+		for (size_t i = size; i > 0; i--)
+			result = (result << 8) | data[i - 1];
+	}
+	else
+	{
+		for (size_t i = 0; i < size; i++)
+			result = (result << 8) | data[i];
+	}
+	return result;
+}
+
+
+static double SecondsSince(std::chrono::steady_clock::time_point start)
+{
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+	return std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() / 1000.0;
 }
 
 
@@ -352,8 +376,7 @@ MachOHeader MachoView::HeaderForAddress(BinaryView* data, uint64_t address, bool
 			section_64 sect;
 			memset(&sect, 0, sizeof(sect));
 			size_t curOffset = reader.GetOffset();
-			load.cmd = reader.Read32();
-			load.cmdsize = reader.Read32();
+			load = reader.ReadStruct<load_command>(&load_command::cmd, &load_command::cmdsize);
 			size_t nextOffset = curOffset + load.cmdsize;
 			m_logger->LogDebug("Segment cmd: %08x - cmdsize: %08x - ", load.cmd, load.cmdsize);
 			if (load.cmdsize < sizeof(load_command))
@@ -610,10 +633,8 @@ MachOHeader MachoView::HeaderForAddress(BinaryView* data, uint64_t address, bool
 				break;
 			case LC_SYMTAB:
 				m_logger->LogDebug("LC_SYMTAB\n");
-				header.symtab.symoff  = reader.Read32();
-				header.symtab.nsyms   = reader.Read32();
-				header.symtab.stroff  = reader.Read32();
-				header.symtab.strsize = reader.Read32();
+				header.symtab = reader.ReadStruct<symtab_command>(&symtab_command::symoff, &symtab_command::nsyms,
+					&symtab_command::stroff, &symtab_command::strsize);
 				reader.Seek(header.symtab.stroff);
 				header.stringList->Append(reader.Read(header.symtab.strsize));
 				header.stringListSize = header.symtab.strsize;
@@ -626,24 +647,13 @@ MachOHeader MachoView::HeaderForAddress(BinaryView* data, uint64_t address, bool
 				break;
 			case LC_DYSYMTAB:
 				m_logger->LogDebug("LC_DYSYMTAB\n");
-				header.dysymtab.ilocalsym = reader.Read32();
-				header.dysymtab.nlocalsym = reader.Read32();
-				header.dysymtab.iextdefsym = reader.Read32();
-				header.dysymtab.nextdefsym = reader.Read32();
-				header.dysymtab.iundefsym = reader.Read32();
-				header.dysymtab.nundefsym = reader.Read32();
-				header.dysymtab.tocoff = reader.Read32();
-				header.dysymtab.ntoc = reader.Read32();
-				header.dysymtab.modtaboff = reader.Read32();
-				header.dysymtab.nmodtab = reader.Read32();
-				header.dysymtab.extrefsymoff = reader.Read32();
-				header.dysymtab.nextrefsyms = reader.Read32();
-				header.dysymtab.indirectsymoff = reader.Read32();
-				header.dysymtab.nindirectsyms = reader.Read32();
-				header.dysymtab.extreloff = reader.Read32();
-				header.dysymtab.nextrel = reader.Read32();
-				header.dysymtab.locreloff = reader.Read32();
-				header.dysymtab.nlocrel = reader.Read32();
+				header.dysymtab = reader.ReadStruct<dysymtab_command>(&dysymtab_command::ilocalsym,
+					&dysymtab_command::nlocalsym, &dysymtab_command::iextdefsym, &dysymtab_command::nextdefsym,
+					&dysymtab_command::iundefsym, &dysymtab_command::nundefsym, &dysymtab_command::tocoff,
+					&dysymtab_command::ntoc, &dysymtab_command::modtaboff, &dysymtab_command::nmodtab,
+					&dysymtab_command::extrefsymoff, &dysymtab_command::nextrefsyms, &dysymtab_command::indirectsymoff,
+					&dysymtab_command::nindirectsyms, &dysymtab_command::extreloff, &dysymtab_command::nextrel,
+					&dysymtab_command::locreloff, &dysymtab_command::nlocrel);
 				m_logger->LogDebug("\theader.dysymtab.ilocalsym      0x%08x\n"\
 					"\theader.dysymtab.nlocalsym      0x%08x\n"\
 					"\theader.dysymtab.iextdefsym     0x%08x\n"\
@@ -691,16 +701,11 @@ MachOHeader MachoView::HeaderForAddress(BinaryView* data, uint64_t address, bool
 			case LC_DYLD_INFO:
 			case LC_DYLD_INFO_ONLY:
 				m_logger->LogDebug("LC_DYLD_INFO\n");
-				header.dyldInfo.rebase_off = reader.Read32();
-				header.dyldInfo.rebase_size = reader.Read32();
-				header.dyldInfo.bind_off = reader.Read32();
-				header.dyldInfo.bind_size = reader.Read32();
-				header.dyldInfo.weak_bind_off = reader.Read32();
-				header.dyldInfo.weak_bind_size = reader.Read32();
-				header.dyldInfo.lazy_bind_off = reader.Read32();
-				header.dyldInfo.lazy_bind_size = reader.Read32();
-				header.dyldInfo.export_off = reader.Read32();
-				header.dyldInfo.export_size = reader.Read32();
+				header.dyldInfo = reader.ReadStruct<dyld_info_command>(&dyld_info_command::rebase_off,
+					&dyld_info_command::rebase_size, &dyld_info_command::bind_off, &dyld_info_command::bind_size,
+					&dyld_info_command::weak_bind_off, &dyld_info_command::weak_bind_size,
+					&dyld_info_command::lazy_bind_off, &dyld_info_command::lazy_bind_size,
+					&dyld_info_command::export_off, &dyld_info_command::export_size);
 				header.exportTrie.dataoff = header.dyldInfo.export_off;
 				header.exportTrie.datasize = header.dyldInfo.export_size;
 				header.exportTriePresent = true;
@@ -1547,6 +1552,7 @@ bool MachoView::Init()
 	std::chrono::steady_clock::time_point endTime = std::chrono::steady_clock::now();
 	double t = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count() / 1000.0;
 	m_logger->LogInfo("Mach-O parsing took %.3f seconds\n", t);
+	m_demangleCache.Clear();
 	return true;
 }
 
@@ -2009,9 +2015,8 @@ bool MachoView::InitializeHeader(MachOHeader& header, bool isMainHeader, uint64_
 		// Handle indirect symbols
 		if (header.dysymtab.nindirectsyms)
 		{
-			indirectSymbols.resize(header.dysymtab.nindirectsyms);
 			reader.Seek(header.dysymtab.indirectsymoff);
-			reader.Read(&indirectSymbols[0], header.dysymtab.nindirectsyms * sizeof(uint32_t));
+			indirectSymbols = reader.ReadArray<uint32_t>(header.dysymtab.nindirectsyms);
 		}
 	}
 	catch (ReadException&)
@@ -2044,23 +2049,21 @@ bool MachoView::InitializeHeader(MachOHeader& header, bool isMainHeader, uint64_
 		m_logger->LogError("Failed to parse symbol table!");
 	}
 
+	// Demangle the queued symbols' names up front, so the queue finds them in the cache
+	if (m_arch)
+	{
+		bool simplify = Settings::Instance()->Get<bool>("analysis.types.templateSimplifier", this);
+		m_demangleCache.DemangleBatch(m_arch, m_queuedSymbolNames, this, simplify);
+	}
+	m_queuedSymbolNames.clear();
+
 	m_symbolQueue->Process();
 	delete m_symbolQueue;
 	m_symbolQueue = nullptr;
 
 	EndBulkModifySymbols();
 
-	for (auto& relocation : header.rebaseRelocations)
-	{
-		uint64_t relocationLocation = relocation.address;
-		virtualReader.Seek(relocationLocation);
-		uint64_t target = virtualReader.ReadPointer();
-		uint64_t slidTarget = target + m_imageBaseAdjustment;
-		relocation.address = slidTarget;
-		DefineRelocation(m_arch, relocation, slidTarget, relocationLocation);
-		if (m_objcProcessor)
-			m_objcProcessor->AddRelocatedPointer(relocationLocation, slidTarget);
-	}
+	ApplyRebaseRelocations(virtualReader, header);
 	for (auto& [relocation, name] : header.externalRelocations)
 	{
 		if (auto symbol = GetSymbolByRawName(name, GetExternalNameSpace()); symbol)
@@ -2413,13 +2416,13 @@ Ref<Symbol> MachoView::DefineMachoSymbol(
 
 	}
 
-	auto process = [=]() {
-		// If name does not start with alphabetic character or symbol, prepend an underscore
-		string rawName = name;
-		if (!(((name[0] >= 'A') && (name[0] <= 'Z')) || ((name[0] >= 'a') && (name[0] <= 'z')) || (name[0] == '_')
-				|| (name[0] == '?') || (name[0] == '$') || (name[0] == '@')))
-			rawName = "_" + name;
+	// If name does not start with alphabetic character or symbol, prepend an underscore
+	string rawName = name;
+	if (!(((name[0] >= 'A') && (name[0] <= 'Z')) || ((name[0] >= 'a') && (name[0] <= 'z')) || (name[0] == '_')
+			|| (name[0] == '?') || (name[0] == '$') || (name[0] == '@')))
+		rawName = "_" + name;
 
+	auto process = [=]() {
 		NameSpace nameSpace = GetInternalNameSpace();
 		if (type == ExternalSymbol)
 		{
@@ -2436,7 +2439,7 @@ Ref<Symbol> MachoView::DefineMachoSymbol(
 			QualifiedName demangledName;
 			Ref<Type> demangledType;
 			bool simplify = Settings::Instance()->Get<bool>("analysis.types.templateSimplifier", this);
-			if (DemangleGeneric(m_arch, rawName, demangledType, demangledName, this, simplify))
+			if (m_demangleCache.Demangle(m_arch, rawName, demangledType, demangledName, this, simplify))
 			{
 				shortName = demangledName.GetString();
 				fullName = shortName;
@@ -2457,6 +2460,8 @@ Ref<Symbol> MachoView::DefineMachoSymbol(
 
 	if (deferred)
 	{
+		if (m_arch)
+			m_queuedSymbolNames.push_back(rawName);
 		m_symbolQueue->Append(process, [this](Symbol* symbol, Type* type) {
 			DefineAutoSymbolAndVariableOrFunction(GetDefaultPlatform(), symbol, type);
 		});
@@ -2503,52 +2508,30 @@ bool MachoView::GetSectionPermissions(MachOHeader& header, uint64_t address, uin
 
 void MachoView::ParseExportTrie(BinaryReader& reader, linkedit_data_command exportTrie)
 {
+	std::vector<ExportTrieEntry> exports;
 	try {
-		uint32_t endGuard = exportTrie.datasize;
 		DataBuffer buffer = GetParentView()->ReadBuffer(m_universalImageOffset + exportTrie.dataoff, exportTrie.datasize);
-
-		ReadExportNode(GetStart(), buffer, "", 0, endGuard);
+		ReadExportTrie((const uint8_t*)buffer.GetData(), buffer.GetLength(), exports);
 	}
 	catch (ReadException&)
 	{
 		m_logger->LogError("Error while parsing Export Trie");
 	}
-}
 
-void MachoView::ReadExportNode(uint64_t viewStart, DataBuffer& buffer, const std::string& currentText, size_t cursor, uint32_t endGuard)
-{
-	if (cursor > endGuard)
-		throw ReadException();
-
-	uint64_t terminalSize = readValidULEB128(buffer, cursor);
-	uint64_t childOffset = cursor + terminalSize;
-	if (terminalSize != 0) {
-		uint64_t imageOffset = 0;
-		uint64_t flags = readValidULEB128(buffer, cursor);
-		if (!(flags & EXPORT_SYMBOL_FLAGS_REEXPORT))
-		{
-			imageOffset = readValidULEB128(buffer, cursor);
-			auto symbolType = GetAnalysisFunctionsForAddress(viewStart + imageOffset).size() ? FunctionSymbol : DataSymbol;
-			DefineMachoSymbol(symbolType, currentText, imageOffset + viewStart, GlobalBinding, true);
-		}
-	}
-	cursor = childOffset;
-	uint8_t childCount = buffer[cursor];
-	cursor++;
-	if (cursor > endGuard)
-		throw ReadException();
-	for (uint8_t i = 0; i < childCount; ++i)
-	{
-		std::string childText;
-		while (buffer[cursor] != 0 & cursor <= endGuard)
-			childText.push_back(buffer[cursor++]);
-		cursor++;
-		if (cursor > endGuard)
-			throw ReadException();
-		auto next = readValidULEB128(buffer, cursor);
-		if (next == 0)
-			throw ReadException();
-		ReadExportNode(viewStart, buffer, currentText + childText, next, endGuard);
+	if (exports.empty())
+		return;
+
+	// Look up the functions from the function starts once instead of once per export
+	std::unordered_set<uint64_t> functionStarts;
+	for (auto& func : GetAnalysisFunctionList())
+		functionStarts.insert(func->GetStart());
+
+	uint64_t viewStart = GetStart();
+	for (auto& entry : exports)
+	{
+		uint64_t addr = viewStart + entry.offset;
+		auto symbolType = functionStarts.count(addr) ? FunctionSymbol : DataSymbol;
+		DefineMachoSymbol(symbolType, entry.name, addr, GlobalBinding, true);
 	}
 }
 
@@ -2569,16 +2552,39 @@ void MachoView::ParseRebaseTable(BinaryReader& reader, MachOHeader& header, uint
 		return header.segments[segmentIndex].vmaddr + header.segments[segmentIndex].vmsize;
 	};
 
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	size_t startCount = header.rebaseRelocations.size();
+
 	try {
 		reader.Seek(tableOffset);
-		auto table = reader.Read(tableSize);
+		DataBuffer tableBuffer = reader.Read(tableSize);
+		const uint8_t* table = (const uint8_t*)tableBuffer.GetData();
 
 		BNRelocationInfo rebaseRelocation;
+		memset(&rebaseRelocation, 0, sizeof(rebaseRelocation));
+		rebaseRelocation.nativeType = BINARYNINJA_MANUAL_RELOCATION;
+		rebaseRelocation.size = m_addressSize;
+		rebaseRelocation.pcRelative = false;
+		rebaseRelocation.external = false;
 
 		uint64_t segmentIndex = 0;
 		uint64_t address = segmentActualLoadAddress(0);
 		uint64_t segmentStartAddress = segmentActualLoadAddress(0);
 		uint64_t segmentEndAddress = segmentActualEndAddress(0);
+		auto addRebase = [&](uint64_t count, uint64_t step) {
+			for (uint64_t j = 0; j < count; ++j)
+			{
+				if (address < segmentStartAddress || address >= segmentEndAddress)
+				{
+					m_logger->LogError("Rebase address out of segment bounds");
+					throw ReadException();
+				}
+				rebaseRelocation.address = address;
+				header.rebaseRelocations.push_back(rebaseRelocation);
+				address += step;
+			}
+		};
+
 		uint64_t count;
 		uint64_t skip;
 		bool done = false;
@@ -2588,7 +2594,6 @@ void MachoView::ParseRebaseTable(BinaryReader& reader, MachOHeader& header, uint
 			uint8_t opAndIm = table[i];
 			uint8_t opcode = opAndIm & RebaseOpcodeMask;
 			uint64_t immediate = opAndIm & RebaseImmediateMask;
-			m_logger->LogDebug("Rebase opcode 0x%llx (im: 0x%llx)", opcode, immediate);
 			i++;
 			switch (opcode)
 			{
@@ -2610,81 +2615,20 @@ void MachoView::ParseRebaseTable(BinaryReader& reader, MachOHeader& header, uint
 				address += immediate * m_addressSize;
 				break;
 			case RebaseOpcodeDoRebaseImmediateTimes:
-				count = immediate;
-				for (uint64_t j = 0; j < count; ++j)
-				{
-					m_logger->LogDebug("Rebasing address %llx", address);
-					if (address < segmentStartAddress || address >= segmentEndAddress)
-					{
-						m_logger->LogError("Rebase address out of segment bounds");
-						throw ReadException();
-					}
-					memset(&rebaseRelocation, 0, sizeof(rebaseRelocation));
-					rebaseRelocation.nativeType = BINARYNINJA_MANUAL_RELOCATION;
-					rebaseRelocation.address = address;
-					rebaseRelocation.size = m_addressSize;
-					rebaseRelocation.pcRelative = false;
-					rebaseRelocation.external = false;
-					header.rebaseRelocations.push_back(rebaseRelocation);
-					address += m_addressSize;
-				}
+				addRebase(immediate, m_addressSize);
 				break;
 			case RebaseOpcodeDoRebaseUlebTimes:
 				count = readLEB128(table, tableSize, i);
-				for (uint64_t j = 0; j < count; ++j)
-				{
-					m_logger->LogDebug("Rebasing address %llx", address);
-					if (address < segmentStartAddress || address >= segmentEndAddress)
-					{
-						m_logger->LogError("Rebase address out of segment bounds");
-						throw ReadException();
-					}
-					memset(&rebaseRelocation, 0, sizeof(rebaseRelocation));
-					rebaseRelocation.nativeType = BINARYNINJA_MANUAL_RELOCATION;
-					rebaseRelocation.address = address;
-					rebaseRelocation.size = m_addressSize;
-					rebaseRelocation.pcRelative = false;
-					rebaseRelocation.external = false;
-					header.rebaseRelocations.push_back(rebaseRelocation);
-					address += m_addressSize;
-				}
+				addRebase(count, m_addressSize);
 				break;
 			case RebaseOpcodeDoRebaseAddAddressUleb:
-				m_logger->LogDebug("Rebasing address %llx", address);
-				if (address < segmentStartAddress || address >= segmentEndAddress)
-				{
-					m_logger->LogError("Rebase address out of segment bounds");
-					throw ReadException();
-				}
-				memset(&rebaseRelocation, 0, sizeof(rebaseRelocation));
-				rebaseRelocation.nativeType = BINARYNINJA_MANUAL_RELOCATION;
-				rebaseRelocation.address = address;
-				rebaseRelocation.size = m_addressSize;
-				rebaseRelocation.pcRelative = false;
-				rebaseRelocation.external = false;
-				header.rebaseRelocations.push_back(rebaseRelocation);
+				addRebase(1, 0);
 				address += readLEB128(table, tableSize, i) + m_addressSize;
 				break;
 			case RebaseOpcodeDoRebaseUlebTimesSkippingUleb:
 				count = readLEB128(table, tableSize, i);
 				skip = readLEB128(table, tableSize, i);
-				for (uint64_t j = 0; j < count; ++j)
-				{
-					m_logger->LogDebug("Rebasing address %llx", address);
-					if (address < segmentStartAddress || address >= segmentEndAddress)
-					{
-						m_logger->LogError("Rebase address out of segment bounds");
-						throw ReadException();
-					}
-					memset(&rebaseRelocation, 0, sizeof(rebaseRelocation));
-					rebaseRelocation.nativeType = BINARYNINJA_MANUAL_RELOCATION;
-					rebaseRelocation.address = address;
-					rebaseRelocation.size = m_addressSize;
-					rebaseRelocation.pcRelative = false;
-					rebaseRelocation.external = false;
-					header.rebaseRelocations.push_back(rebaseRelocation);
-					address += skip + m_addressSize;
-				}
+				addRebase(count, skip + m_addressSize);
 				break;
 			default:
 				m_logger->LogError("Unknown rebase opcode %d", opcode);
@@ -2697,6 +2641,95 @@ void MachoView::ParseRebaseTable(BinaryReader& reader, MachOHeader& header, uint
 	{
 		m_logger->LogError("Error while parsing Rebase Table");
 	}
+
+	m_logger->LogInfo("Parsing the rebase table took %.3f seconds. Found %" PRIuPTR " rebases.", SecondsSince(startTime),
+		header.rebaseRelocations.size() - startCount);
+}
+
+
+void MachoView::ApplyRebaseRelocations(BinaryReader& virtualReader, MachOHeader& header)
+{
+	auto& relocations = header.rebaseRelocations;
+	if (relocations.empty())
+		return;
+
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+	// Read each segment holding rebased pointers once, then pull the pointers out of those reads in parallel.
+	// Rebase tables are usually sorted, so the segment found for the previous rebase is checked first.
+	std::vector<size_t> relocationSegments(relocations.size(), header.segments.size());
+	std::vector<bool> segmentUsed(header.segments.size());
+	size_t lastSegment = 0;
+	for (size_t i = 0; i < relocations.size(); i++)
+	{
+		uint64_t address = relocations[i].address;
+		for (size_t j = 0; j < header.segments.size(); j++)
+		{
+			size_t segment = (lastSegment + j) % header.segments.size();
+			const auto& seg = header.segments[segment];
+			if (address >= seg.vmaddr && address < seg.vmaddr + seg.vmsize)
+			{
+				relocationSegments[i] = segment;
+				segmentUsed[segment] = true;
+				lastSegment = segment;
+				break;
+			}
+		}
+	}
+
+	std::vector<DataBuffer> segmentBuffers(header.segments.size());
+	std::vector<const uint8_t*> segmentData(header.segments.size());
+	std::vector<size_t> segmentLengths(header.segments.size());
+	for (size_t i = 0; i < header.segments.size(); i++)
+	{
+		if (!segmentUsed[i])
+			continue;
+		const auto& seg = header.segments[i];
+		segmentBuffers[i] = ReadBuffer(seg.vmaddr, std::min(seg.vmsize, seg.filesize));
+		segmentData[i] = (const uint8_t*)segmentBuffers[i].GetData();
+		segmentLengths[i] = segmentBuffers[i].GetLength();
+	}
+
+	constexpr size_t RebasesPerChunk = 4096;
+	std::vector<uint64_t> targets(relocations.size());
+	std::vector<uint8_t> targetRead(relocations.size());
+	ParallelForEach((relocations.size() + RebasesPerChunk - 1) / RebasesPerChunk, [&](size_t chunk) {
+		size_t end = std::min(relocations.size(), (chunk + 1) * RebasesPerChunk);
+		for (size_t i = chunk * RebasesPerChunk; i < end; i++)
+		{
+			size_t segment = relocationSegments[i];
+			if (segment >= header.segments.size())
+				continue;
+			uint64_t offset = relocations[i].address - header.segments[segment].vmaddr;
+			if (offset + m_addressSize > segmentLengths[segment])
+				continue;
+			targets[i] = readPointer(segmentData[segment] + offset, m_addressSize, m_endian);
+			targetRead[i] = 1;
+		}
+	});
+	double readTime = SecondsSince(startTime);
+
+	for (size_t i = 0; i < relocations.size(); i++)
+	{
+		auto& relocation = relocations[i];
+		uint64_t relocationLocation = relocation.address;
+		uint64_t target = targets[i];
+		if (!targetRead[i])
+		{
+			// Outside of any segment's file data; let the reader decide what is there
+			virtualReader.Seek(relocationLocation);
+			target = virtualReader.ReadPointer();
+		}
+		uint64_t slidTarget = target + m_imageBaseAdjustment;
+		relocation.address = slidTarget;
+		DefineRelocation(m_arch, relocation, slidTarget, relocationLocation);
+		if (m_objcProcessor)
+			m_objcProcessor->AddRelocatedPointer(relocationLocation, slidTarget);
+	}
+
+	double totalTime = SecondsSince(startTime);
+	m_logger->LogInfo("Applying rebases took %.3f seconds (reading pointers: %.3f, applying: %.3f). Applied %" PRIuPTR
+		" rebases.", totalTime, readTime, totalTime - readTime, relocations.size());
 }
 
 
@@ -2925,15 +2958,31 @@ void MachoView::ParseSymbolTable(BinaryReader& reader, MachOHeader& header, cons
 			}
 		}
 
-		nlist_64 sym;
-		memset(&sym, 0, sizeof(sym));
-		for (size_t i = 0; i < symtab.nsyms; i++)
+		// Clamp to what's actually in the file so a truncated table still yields the symbols that are present
+		size_t entrySize = (m_addressSize == 4) ? 12 : 16;
+		uint64_t tableStart = m_universalImageOffset + symtab.symoff;
+		uint64_t fileEnd = GetParentView()->GetEnd();
+		size_t nsyms = tableStart < fileEnd ? std::min<uint64_t>(symtab.nsyms, (fileEnd - tableStart) / entrySize) : 0;
+
+		vector<nlist_64> syms;
+		if (m_addressSize == 4)
 		{
-			sym.n_strx = reader.Read32();
-			sym.n_type = reader.Read8();
-			sym.n_sect = reader.Read8();
-			sym.n_desc = reader.Read16();
-			sym.n_value = (m_addressSize == 4) ? reader.Read32() : reader.Read64();
+			struct nlist32 { uint32_t n_strx; uint8_t n_type; uint8_t n_sect; uint16_t n_desc; uint32_t n_value; };
+			auto syms32 = reader.ReadArray<nlist32>(nsyms, &nlist32::n_strx, &nlist32::n_type,
+				&nlist32::n_sect, &nlist32::n_desc, &nlist32::n_value);
+			syms.reserve(syms32.size());
+			for (auto& sym32 : syms32)
+				syms.push_back({sym32.n_strx, sym32.n_type, sym32.n_sect, sym32.n_desc, sym32.n_value});
+		}
+		else
+		{
+			syms = reader.ReadArray<nlist_64>(nsyms, &nlist_64::n_strx, &nlist_64::n_type, &nlist_64::n_sect,
+				&nlist_64::n_desc, &nlist_64::n_value);
+		}
+
+		for (size_t i = 0; i < syms.size(); i++)
+		{
+			nlist_64& sym = syms[i];
 			if (sym.n_value)
 				sym.n_value += m_imageBaseAdjustment;
 			if (sym.n_strx >= symtab.strsize || ((sym.n_type & N_TYPE) == N_INDR))
@@ -3084,7 +3133,27 @@ void MachoView::ParseChainedFixups(MachOHeader& header, linkedit_data_command ch
 	bool processBinds = true;
 
 	BinaryReader parentReader(GetParentView());
-	BinaryReader mappedReader(this);
+
+	struct ChainedFixup
+	{
+		uint64_t address;
+		uint64_t value;  // Target for rebases, import ordinal for binds
+		bool bind;
+	};
+
+	struct ChainedFixupChunk
+	{
+		std::vector<ChainedFixup> fixups;
+		bool failed = false;  // Ran off the segment's data, ending the chain walk
+	};
+
+	constexpr size_t ChainedFixupPagesPerChunk = 16;
+
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	double decodeTime = 0;
+	double applyTime = 0;
+	size_t rebaseCount = 0;
+	size_t bindCount = 0;
 
 	try {
 		dyld_chained_fixups_header fixupsHeader {};
@@ -3275,29 +3344,39 @@ void MachoView::ParseChainedFixups(MachOHeader& header, linkedit_data_command ch
 				}
 			}
 
-			int i = -1;
-			for (auto pageStarts : pageStartOffsets)
-			{
-				i++;
-				uint64_t pageAddress = m_universalImageOffset + starts.segment_offset + (i * starts.page_size);
-				for (uint16_t start : pageStarts)
+			// Read the whole segment once and decode its chains a few pages per task. Defining symbols and
+			// relocations happens afterwards, in page order, on this thread.
+			std::chrono::steady_clock::time_point decodeStart = std::chrono::steady_clock::now();
+			uint64_t segmentStart = GetStart() + starts.segment_offset;
+			size_t pointerSize = (format == Generic32FixupFormat || format == Firmware32FixupFormat) ? 4 : 8;
+			// A chain may end on a pointer sitting right at the end of its page
+			DataBuffer segmentBuffer = ReadBuffer(segmentStart, pageStartOffsets.size() * starts.page_size + pointerSize);
+			const uint8_t* segmentData = (const uint8_t*)segmentBuffer.GetData();
+			size_t segmentLength = segmentBuffer.GetLength();
+
+			auto decodePage = [&](size_t page, ChainedFixupChunk& result) {
+				uint64_t pageOffset = page * starts.page_size;
+				for (uint16_t start : pageStartOffsets[page])
 				{
 					if (start == DYLD_CHAINED_PTR_START_NONE)
 						continue;
 
-					uint64_t chainEntryAddress = pageAddress + start;
+					uint64_t chainEntryOffset = pageOffset + start;
 
 					bool fixupsDone = false;
 
 					while (!fixupsDone)
 					{
+						if (chainEntryOffset + pointerSize > segmentLength)
+							return false;
+
 						ChainedFixupPointer pointer;
-						parentReader.Seek(chainEntryAddress);
-						mappedReader.Seek(chainEntryAddress - m_universalImageOffset + GetStart());
-						if (format == Generic32FixupFormat || format == Firmware32FixupFormat)
-							pointer.raw32 = (uint32_t)(uintptr_t)mappedReader.Read32();
+						pointer.raw64 = 0;
+						if (pointerSize == 4)
+							pointer.raw32 = (uint32_t)readPointer(segmentData + chainEntryOffset, 4, m_endian);
 						else
-							pointer.raw64 = (uintptr_t)mappedReader.Read64();
+							pointer.raw64 = readPointer(segmentData + chainEntryOffset, 8, m_endian);
+						uint64_t address = segmentStart + chainEntryOffset;
 
 						bool bind = false;
 						uint64_t nextEntryStrideCount;
@@ -3322,10 +3401,6 @@ void MachoView::ParseChainedFixups(MachOHeader& header, linkedit_data_command ch
 							break;
 						}
 
-						m_logger->LogTrace("Chained Fixups: @ 0x%llx ( 0x%llx ) - %d 0x%llx", chainEntryAddress,
-							GetStart() + (chainEntryAddress - m_universalImageOffset),
-							bind, nextEntryStrideCount);
-
 						if (bind && processBinds)
 						{
 							uint64_t ordinal;
@@ -3351,14 +3426,12 @@ void MachoView::ParseChainedFixups(MachOHeader& header, linkedit_data_command ch
 								ordinal = pointer.generic32.bind.ordinal;
 								break;
 							default:
-								m_logger->LogWarn("Chained Fixups: Unknown Bind Pointer Format at %llx",
-									GetStart() + (chainEntryAddress - m_universalImageOffset));
+								m_logger->LogWarn("Chained Fixups: Unknown Bind Pointer Format at %llx", address);
 
-								chainEntryAddress += (nextEntryStrideCount * strideSize);
-								if (chainEntryAddress > pageAddress + starts.page_size)
+								chainEntryOffset += (nextEntryStrideCount * strideSize);
+								if (chainEntryOffset > pageOffset + starts.page_size)
 								{
-									m_logger->LogDebug("Chained Fixups: Pointer at %llx left page",
-										GetStart() + ((chainEntryAddress - (nextEntryStrideCount * strideSize))) - m_universalImageOffset);
+									m_logger->LogDebug("Chained Fixups: Pointer at %llx left page", address);
 									fixupsDone = true;
 								}
 								if (nextEntryStrideCount == 0)
@@ -3367,33 +3440,7 @@ void MachoView::ParseChainedFixups(MachOHeader& header, linkedit_data_command ch
 								continue;
 							}
 
-							if (ordinal < importTable.size())
-							{
-								import_entry entry = importTable.at(ordinal);
-								uint64_t targetAddress = GetStart() + (chainEntryAddress - m_universalImageOffset);
-
-								if (!entry.name.empty())
-								{
-									reloc.address = targetAddress;
-									DefineMachoSymbol(ImportAddressSymbol, entry.name,
-										targetAddress,
-										entry.weak ? WeakBinding : GlobalBinding, true);
-
-									BNRelocationInfo externReloc;
-									memset(&externReloc, 0, sizeof(externReloc));
-									externReloc.nativeType = BINARYNINJA_MANUAL_RELOCATION;
-									externReloc.address = targetAddress;
-									externReloc.size = m_addressSize;
-									externReloc.pcRelative = false;
-									externReloc.external = true;
-									header.externalRelocations.emplace_back(externReloc, entry.name);
-								}
-								else
-								{
-									m_logger->LogWarn("Chained Fixups: Import Table entry %llx has no symbol; "
-										"Unable to bind item at %llx", ordinal, targetAddress);
-								}
-							}
+							result.fixups.push_back({address, ordinal, true});
 						}
 						else if (!bind)
 						{
@@ -3434,23 +3481,16 @@ void MachoView::ParseChainedFixups(MachOHeader& header, linkedit_data_command ch
 								break;
 							}
 
-							reloc.address = GetStart() + (chainEntryAddress - m_universalImageOffset);
-							DefineRelocation(m_arch, reloc, entryOffset, reloc.address);
-
-							if (m_objcProcessor)
-							{
-								m_objcProcessor->AddRelocatedPointer(reloc.address, entryOffset);
-							}
+							result.fixups.push_back({address, entryOffset, false});
 						}
 
-						chainEntryAddress += (nextEntryStrideCount * strideSize);
+						chainEntryOffset += (nextEntryStrideCount * strideSize);
 
-						if (chainEntryAddress > pageAddress + starts.page_size)
+						if (chainEntryOffset > pageOffset + starts.page_size)
 						{
 							// Something is seriously wrong here. likely malformed binary, or our parsing failed elsewhere.
 							// This will log the pointer in mapped memory.
-							m_logger->LogError("Chained Fixups: Pointer at %llx left page",
-								GetStart() + ((chainEntryAddress - (nextEntryStrideCount * strideSize))) - m_universalImageOffset);
+							m_logger->LogError("Chained Fixups: Pointer at %llx left page", address);
 							fixupsDone = true;
 						}
 
@@ -3458,13 +3498,86 @@ void MachoView::ParseChainedFixups(MachOHeader& header, linkedit_data_command ch
 							fixupsDone = true;
 					}
 				}
+				return true;
+			};
+
+			std::vector<ChainedFixupChunk> chunks((pageStartOffsets.size() + ChainedFixupPagesPerChunk - 1) / ChainedFixupPagesPerChunk);
+			ParallelForEach(chunks.size(), [&](size_t chunk) {
+				size_t end = std::min(pageStartOffsets.size(), (chunk + 1) * ChainedFixupPagesPerChunk);
+				for (size_t page = chunk * ChainedFixupPagesPerChunk; page < end; page++)
+				{
+					if (!decodePage(page, chunks[chunk]))
+					{
+						chunks[chunk].failed = true;
+						break;
+					}
+				}
+			});
+			decodeTime += SecondsSince(decodeStart);
+
+			std::chrono::steady_clock::time_point applyStart = std::chrono::steady_clock::now();
+			for (auto& chunk : chunks)
+			{
+				for (auto& fixup : chunk.fixups)
+				{
+					if (!fixup.bind)
+					{
+						reloc.address = fixup.address;
+						DefineRelocation(m_arch, reloc, fixup.value, reloc.address);
+
+						if (m_objcProcessor)
+						{
+							m_objcProcessor->AddRelocatedPointer(reloc.address, fixup.value);
+						}
+						rebaseCount++;
+						continue;
+					}
+
+					if (fixup.value >= importTable.size())
+						continue;
+
+					const import_entry& entry = importTable[fixup.value];
+					if (!entry.name.empty())
+					{
+						DefineMachoSymbol(ImportAddressSymbol, entry.name, fixup.address,
+							entry.weak ? WeakBinding : GlobalBinding, true);
+
+						BNRelocationInfo externReloc;
+						memset(&externReloc, 0, sizeof(externReloc));
+						externReloc.nativeType = BINARYNINJA_MANUAL_RELOCATION;
+						externReloc.address = fixup.address;
+						externReloc.size = m_addressSize;
+						externReloc.pcRelative = false;
+						externReloc.external = true;
+						header.externalRelocations.emplace_back(externReloc, entry.name);
+						bindCount++;
+					}
+					else
+					{
+						m_logger->LogWarn("Chained Fixups: Import Table entry %llx has no symbol; "
+							"Unable to bind item at %llx", fixup.value, fixup.address);
+					}
+				}
+
+				// Stop where a serial walk would have stopped
+				if (chunk.failed)
+				{
+					applyTime += SecondsSince(applyStart);
+					throw ReadException();
+				}
 			}
+			applyTime += SecondsSince(applyStart);
 		}
 	}
 	catch (ReadException&)
 	{
 		m_logger->LogError("Chained Fixup parsing failed");
 	}
+
+	double totalTime = SecondsSince(startTime);
+	m_logger->LogInfo("Chained fixups took %.3f seconds (reading tables: %.3f, decoding chains: %.3f, applying: %.3f). "
+		"Applied %" PRIuPTR " rebases and %" PRIuPTR " binds.", totalTime, totalTime - decodeTime - applyTime, decodeTime,
+		applyTime, rebaseCount, bindCount);
 }
 
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <exception>
 #include <vector>
 #include <string.h>
@@ -1249,6 +1250,100 @@ namespace BinaryNinja
 	};
 #endif
 
+	// One export read out of an export trie
+	struct ExportTrieEntry
+	{
+		std::string name;
+		uint64_t offset;  // From the start of the image
+		uint64_t flags;
+	};
+
+	/*! Reads every export of the export trie in `data`, other than reexports, in a single pass
+
+		The trie is walked with an explicit stack, and names are built in one buffer that is trimmed back to the
+		parent's prefix before each edge is appended, so neither deep nor wide tries recurse or copy prefixes.
+		Exports are appended to `entries` in the order a depth-first walk of the trie finds them. Malformed tries
+		throw ReadException, leaving the exports found up to that point in `entries`.
+	*/
+	inline void ReadExportTrie(const uint8_t* data, size_t size, std::vector<ExportTrieEntry>& entries)
+	{
+		struct Edge
+		{
+			size_t node;
+			size_t prefixLength;  // Length of the parent's name
+			size_t textOffset;    // Where the edge's text starts in the trie
+			size_t textLength;
+		};
+
+		auto readULEB128 = [&](size_t& cursor) {
+			uint64_t result = 0;
+			int bit = 0;
+			uint8_t byte;
+			do
+			{
+				if (cursor >= size || bit > 63)
+					throw ReadException();
+				byte = data[cursor++];
+				result |= (uint64_t)(byte & 0x7f) << bit;
+				bit += 7;
+			} while (byte & 0x80);
+			return result;
+		};
+
+		if (size == 0)
+			return;
+
+		std::string name;
+		std::vector<Edge> stack {{0, 0, 0, 0}};
+		std::vector<bool> visited(size);
+		while (!stack.empty())
+		{
+			Edge edge = stack.back();
+			stack.pop_back();
+			name.resize(edge.prefixLength);
+			name.append((const char*)data + edge.textOffset, edge.textLength);
+
+			// Each node has a single parent, so a node reached twice means the trie loops back on itself
+			size_t cursor = edge.node;
+			if (cursor >= size || visited[cursor])
+				throw ReadException();
+			visited[cursor] = true;
+
+			uint64_t terminalSize = readULEB128(cursor);
+			if (terminalSize > size - cursor)
+				throw ReadException();
+			size_t childOffset = cursor + terminalSize;
+			if (terminalSize != 0)
+			{
+				uint64_t flags = readULEB128(cursor);
+				if (!(flags & EXPORT_SYMBOL_FLAGS_REEXPORT))
+					entries.push_back({name, readULEB128(cursor), flags});
+			}
+
+			cursor = childOffset;
+			if (cursor >= size)
+				throw ReadException();
+			uint8_t childCount = data[cursor++];
+
+			// Children are pushed in reverse so they come off the stack in the order the trie lists them
+			size_t firstChild = stack.size();
+			for (uint8_t i = 0; i < childCount; i++)
+			{
+				const void* end = (cursor < size) ? memchr(data + cursor, 0, size - cursor) : nullptr;
+				if (!end)
+					throw ReadException();
+				size_t textOffset = cursor;
+				size_t textLength = (const uint8_t*)end - (data + cursor);
+				cursor += textLength + 1;
+				uint64_t next = readULEB128(cursor);
+				if (next == 0)
+					throw ReadException();
+				stack.push_back({(size_t)next, name.size(), textOffset, textLength});
+			}
+			std::reverse(stack.begin() + firstChild, stack.end());
+		}
+	}
+
 	struct MachOHeader {
 		bool isMainHeader = false;
 
@@ -1350,6 +1445,8 @@ namespace BinaryNinja
 		bool m_simplifyTemplates;
 
 		SymbolQueue* m_symbolQueue = nullptr;
+		DemangleCache m_demangleCache;  // Only kept while Init runs
+		std::vector<std::string> m_queuedSymbolNames;  // Raw names of the symbols waiting in m_symbolQueue
 		Ref<Logger> m_logger;
 
 		std::vector<segment_command_64> m_allSegments; //only three types of sections __TEXT, __DATA, __IMPORT
@@ -1367,10 +1464,9 @@ namespace BinaryNinja
 		bool ParseRelocationEntry(const relocation_info& info, uint64_t start, BNRelocationInfo& result);
 
 		void ParseExportTrie(BinaryReader& reader, linkedit_data_command exportTrie);
-		void ReadExportNode(uint64_t viewStart, DataBuffer& buffer, const std::string& currentText,
-			size_t cursor, uint32_t endGuard);
 
 		void ParseRebaseTable(BinaryReader& reader, MachOHeader& header, uint32_t tableOffset, uint32_t tableSize);
+		void ApplyRebaseRelocations(BinaryReader& virtualReader, MachOHeader& header);
 		void ParseDynamicTable(BinaryReader& reader, MachOHeader& header, BNSymbolType type, uint32_t tableOffset, uint32_t tableSize,
 			BNSymbolBinding binding);
 		bool GetSectionPermissions(MachOHeader& header, uint64_t address, uint32_t &flags);
@@ -435,14 +435,9 @@ bool PEView::Init()
 
 		// Read PE header
 		reader.Seek(peOfs);
-		header.magic = reader.Read32();
-		header.machine = reader.Read16();
-		header.sectionCount = reader.Read16();
-		header.timestamp = reader.Read32();
-		header.coffSymbolTable = reader.Read32();
-		header.coffSymbolCount = reader.Read32();
-		header.optionalHeaderSize = reader.Read16();
-		header.characteristics = reader.Read16();
+		header = reader.ReadStruct<PEHeader>(&PEHeader::magic, &PEHeader::machine, &PEHeader::sectionCount,
+			&PEHeader::timestamp, &PEHeader::coffSymbolTable, &PEHeader::coffSymbolCount,
+			&PEHeader::optionalHeaderSize, &PEHeader::characteristics);
 		m_logger->LogDebug(
 			"PEHeader:\n"
 			"\tmagic:              0x%08x\n"
@@ -718,13 +713,8 @@ bool PEView::Init()
 		}
 
 		// Read data directories
-		for (uint32_t i = 0; i < opt.dataDirCount; i++)
-		{
-			PEDataDirectory dir;
-			dir.virtualAddress = reader.Read32();
-			dir.size = reader.Read32();
-			m_dataDirs.push_back(dir);
-		}
+		m_dataDirs = reader.ReadArray<PEDataDirectory>(
+			opt.dataDirCount, &PEDataDirectory::virtualAddress, &PEDataDirectory::size);
 
 		// Add extra segment to hold header so that it can be viewed.  This must be first so
 		// that real sections take priority.
@@ -781,25 +771,20 @@ bool PEView::Init()
 					}
 				}
 			}
+			section = reader.ReadStruct<PESection>(&PESection::virtualSize, &PESection::virtualAddress,
+				&PESection::sizeOfRawData, &PESection::pointerToRawData, &PESection::pointerToRelocs,
+				&PESection::pointerToLineNumbers, &PESection::relocCount, &PESection::lineNumberCount,
+				&PESection::characteristics);
 			section.name = resolvedName;
 			if (section.name == ".reloc")
 				m_relocatable = true;
 
-			section.virtualSize = reader.Read32();
-			section.virtualAddress = reader.Read32();
-			section.sizeOfRawData = reader.Read32();
-			section.pointerToRawData = reader.Read32();
 			if (fileAlignmentValid && (section.pointerToRawData & (resolvedFileAlignment - 1)))
 			{
 				m_logger->LogWarn("PE section[%u] violates file alignment: pointerToRawData: 0x%x. Aligning to 0x%x.", i,
 					section.pointerToRawData, resolvedFileAlignment);
 				section.pointerToRawData &= ~(resolvedFileAlignment - 1);
 			}
-			section.pointerToRelocs = reader.Read32();
-			section.pointerToLineNumbers = reader.Read32();
-			section.relocCount = reader.Read16();
-			section.lineNumberCount = reader.Read16();
-			section.characteristics = reader.Read32();
 
 			if (section.virtualSize == 0)
 			{
@@ -1429,12 +1414,10 @@ bool PEView::Init()
 			{
 				// Read in next directory entry
 				reader.Seek(RVAToFileOffset(dir.virtualAddress + (numImportEntries * 20)));
-				PEImportDirectoryEntry importDirEntry;
-				importDirEntry.lookup = reader.Read32();
-				importDirEntry.timestamp = reader.Read32();
-				importDirEntry.forwardChain = reader.Read32();
-				importDirEntry.nameAddress = reader.Read32();
-				importDirEntry.iat = reader.Read32();
+				PEImportDirectoryEntry importDirEntry = reader.ReadStruct<PEImportDirectoryEntry>(
+					&PEImportDirectoryEntry::lookup, &PEImportDirectoryEntry::timestamp,
+					&PEImportDirectoryEntry::forwardChain, &PEImportDirectoryEntry::nameAddress,
+					&PEImportDirectoryEntry::iat);
 
 				// Windows PE loader ignores the dir.size; instead, it looks for the first
 				// Import_Directory_Table that has a null nameAddress to stop the iteration
@@ -1616,132 +1599,16 @@ bool PEView::Init()
 		m_logger->LogWarn("Failed to parse import directory: %s\n", e.what());
 	}
 
-	try
-	{
-		if ((m_dataDirs.size() > IMAGE_DIRECTORY_ENTRY_EXCEPTION) && m_dataDirs[IMAGE_DIRECTORY_ENTRY_EXCEPTION].size)
-		{
-			// Create Exception Directory Table Entry Type
-			size_t entrySize;
-			size_t numExceptionEntries;
-			StructureBuilder exceptionEntryBuilder;
-			switch (header.machine)
-			{
-				case IMAGE_FILE_MACHINE_AMD64:
-				case IMAGE_FILE_MACHINE_IA64:
-				{
-					entrySize = 12;
-					exceptionEntryBuilder.AddMember(Type::IntegerType(4, false), "beginAddress");
-					exceptionEntryBuilder.AddMember(Type::IntegerType(4, false), "endAddress");
-					exceptionEntryBuilder.AddMember(Type::IntegerType(4, false), "unwindInformation");
-					break;
-				}
-				case IMAGE_FILE_MACHINE_MIPSFPU:
-				case IMAGE_FILE_MACHINE_R4000:
-				case IMAGE_FILE_MACHINE_WCEMIPSV2:
-				{
-					entrySize = 20;
-					exceptionEntryBuilder.AddMember(Type::IntegerType(4, false), "beginAddress");
-					exceptionEntryBuilder.AddMember(Type::IntegerType(4, false), "endAddress");
-					exceptionEntryBuilder.AddMember(Type::IntegerType(4, false), "exceptionHandler");
-					exceptionEntryBuilder.AddMember(Type::IntegerType(4, false), "handlerData");
-					exceptionEntryBuilder.AddMember(Type::IntegerType(4, false), "prologEndAddress");
-					break;
-				}
-				default:
-				{
-					entrySize = 8;
-					exceptionEntryBuilder.AddMember(Type::IntegerType(4, false), "beginAddress");
-					exceptionEntryBuilder.AddMember(Type::IntegerType(4, false), "otherInformation");
-					break;
-				}
-			}
+	bool processExceptionTable = true;
+	if (settings && settings->Contains("loader.pe.processExceptionTable"))
+		processExceptionTable = settings->Get<bool>("loader.pe.processExceptionTable", this);
 
-			if (m_dataDirs[IMAGE_DIRECTORY_ENTRY_EXCEPTION].size % entrySize)
-				throw PEFormatException("invalid table size");
-			numExceptionEntries = m_dataDirs[IMAGE_DIRECTORY_ENTRY_EXCEPTION].size / entrySize;
-
-			// This DataVariable can end up creating a large array and rendering this in LinearView currently has performance implications
-			// So instead we just create separate structures not in an array
-			Ref<Structure> exceptionEntryStruct = exceptionEntryBuilder.Finalize();
-			Ref<Type> exceptionEntryType = Type::StructureType(exceptionEntryStruct);
-			QualifiedName exceptionEntryName = string("Exception_Directory_Entry");
-			string exceptionEntryTypeId = Type::GenerateAutoTypeId("pe", exceptionEntryName);
-			QualifiedName exceptionEntryTypeName = DefineType(exceptionEntryTypeId, exceptionEntryName, exceptionEntryType);
-			for (size_t i = 0; i < numExceptionEntries; i++)
-			{
-				DefineDataVariable(m_imageBase + m_dataDirs[IMAGE_DIRECTORY_ENTRY_EXCEPTION].virtualAddress + (entrySize * i), Type::NamedType(this, exceptionEntryTypeName));
-				DefineAutoSymbol(new Symbol(DataSymbol, "__exception_directory_entries(" + string(std::to_string(i)) + ")", m_imageBase + m_dataDirs[IMAGE_DIRECTORY_ENTRY_EXCEPTION].virtualAddress + (entrySize * i), NoBinding));
-			}
-
-			// parse exception table and add functions
-			bool processExceptionTable = true;
-			if (settings && settings->Contains("loader.pe.processExceptionTable"))
-				processExceptionTable = settings->Get<bool>("loader.pe.processExceptionTable", this);
-			if (processExceptionTable)
-			{
-				StructureBuilder unwindInfoStructBuilder;
-				unwindInfoStructBuilder.AddMember(Type::IntegerType(1, false), "VersionAndFlag");
-				unwindInfoStructBuilder.AddMember(Type::IntegerType(1, false), "SizeOfProlog");
-				unwindInfoStructBuilder.AddMember(Type::IntegerType(1, false), "CountOfUnwindCodes");
-				unwindInfoStructBuilder.AddMember(Type::IntegerType(1, false), "FrameRegisterAndFrameRegisterOffset");
-
-				Ref<Structure> unwindInfoStruct = unwindInfoStructBuilder.Finalize();
-				Ref<Type> unwindInfoStructType = Type::StructureType(unwindInfoStruct);
-				QualifiedName unwindInfoName = string("UNWIND_INFO");
-				string unwindInfoTypeId = Type::GenerateAutoTypeId("pe", unwindInfoName);
-				QualifiedName unwindInfo = DefineType(unwindInfoTypeId, unwindInfoName, unwindInfoStructType);
-
-				BinaryReader unwindReader(GetParentView(), LittleEndian);
-				for (size_t i = 0; i < numExceptionEntries; i++)
-				{
-					reader.Seek(RVAToFileOffset(m_dataDirs[IMAGE_DIRECTORY_ENTRY_EXCEPTION].virtualAddress + (i * entrySize)));
-					uint32_t beginAddress = reader.Read32();
-					switch (header.machine)
-					{
-						case IMAGE_FILE_MACHINE_AMD64:
-						case IMAGE_FILE_MACHINE_IA64:
-						{
-							reader.SeekRelative(4);  // EndAddress
-							uint32_t unwindRva = reader.Read32();
-							DefineDataVariable(m_imageBase + unwindRva, Type::NamedType(this, unwindInfo));
-							unwindReader.Seek(RVAToFileOffset(unwindRva));
-							uint32_t unwindInformation = unwindReader.Read32();
-							uint8_t unwindCodeCount = (unwindInformation >> 16) & 0xff;
-							if (unwindCodeCount > 0)
-								DefineDataVariable(m_imageBase + unwindRva + 4, Type::ArrayType(Type::IntegerType(2, false), unwindCodeCount));
-
-							auto current = m_imageBase + unwindRva + 4 + (unwindCodeCount * 2);
-							if (current % 4 != 0)
-								current += 4 - (current % 4); // Align to DWORD
-
-							if (unwindInformation & (UNW_FLAG_CHAININFO << 3))
-							{
-								DefineDataVariable(current, Type::NamedType(this, exceptionEntryTypeName));
-								continue;
-							}
-							else if ((unwindInformation & (UNW_FLAG_UHANDLER << 3)) || (unwindInformation & (UNW_FLAG_EHANDLER << 3)))
-							{
-								DefineDataVariable(current, Type::IntegerType(4, false));
-								// unwindReader.Seek(RVAToFileOffset(unwindRva + 8 + (unwindCodeCount * 2)));
-								// uint32_t count = unwindReader.Read32();
-								// DefineDataVariable(current + 4, Type::ArrayType(Type::IntegerType(4, false), 3));
-							}
-							break;
-						}
-						default:
-							break;
-					}
-					uint64_t exceptionEntry = m_imageBase + beginAddress;
-					Ref<Platform> targetPlatform = platform->GetAssociatedPlatformByAddress(exceptionEntry);
-					AddFunctionForAnalysis(targetPlatform, exceptionEntry);
-				}
-			}
-		}
-	}
-	catch (std::exception& e)
-	{
-		m_logger->LogWarn("Failed to parse exception directory: %s\n", e.what());
-	}
+	// The exception and resource directories can be very large, so they may be loaded after the view is up
+	bool backgroundDirectories = false;
+	if (settings && settings->Contains("loader.pe.backgroundDirectoryProcessing"))
+		backgroundDirectories = settings->Get<bool>("loader.pe.backgroundDirectoryProcessing", this);
+	if (!backgroundDirectories)
+		ProcessExceptionDirectory(header.machine, platform, processExceptionTable);
 
 	try
 	{
@@ -1998,15 +1865,12 @@ bool PEView::Init()
 			{
 				// Read in next delay directory entry
 				reader.Seek(RVAToFileOffset(dir.virtualAddress + (numImportDelayEntries * 32)));
-				DelayImportDescriptorEntry entry;
-				entry.attributes = reader.Read32();
-				entry.name = reader.Read32();
-				entry.moduleHandle = reader.Read32();
-				entry.delayImportAddressTable = reader.Read32();
-				entry.delayImportNameTable = reader.Read32();
-				entry.boundDelayImportTable = reader.Read32();
-				entry.unloadDelayImportTable = reader.Read32();
-				entry.timestamp = reader.Read32();
+				DelayImportDescriptorEntry entry = reader.ReadStruct<DelayImportDescriptorEntry>(
+					&DelayImportDescriptorEntry::attributes, &DelayImportDescriptorEntry::name,
+					&DelayImportDescriptorEntry::moduleHandle, &DelayImportDescriptorEntry::delayImportAddressTable,
+					&DelayImportDescriptorEntry::delayImportNameTable,
+					&DelayImportDescriptorEntry::boundDelayImportTable,
+					&DelayImportDescriptorEntry::unloadDelayImportTable, &DelayImportDescriptorEntry::timestamp);
 
 				if (entry.name == 0)
 				{
@@ -2428,19 +2292,12 @@ bool PEView::Init()
 	{
 		if ((m_dataDirs.size() > IMAGE_DIRECTORY_ENTRY_EXPORT) && (m_dataDirs[IMAGE_DIRECTORY_ENTRY_EXPORT].size >= 40))
 		{
-			PEExportDirectory dir;
 			reader.Seek(RVAToFileOffset(m_dataDirs[IMAGE_DIRECTORY_ENTRY_EXPORT].virtualAddress));
-			dir.characteristics = reader.Read32();
-			dir.timestamp = reader.Read32();
-			dir.majorVersion = reader.Read16();
-			dir.minorVersion = reader.Read16();
-			dir.dllNameAddress = reader.Read32();
-			dir.base = reader.Read32();
-			dir.functionCount = reader.Read32();
-			dir.nameCount = reader.Read32();
-			dir.addressOfFunctions = reader.Read32();
-			dir.addressOfNames = reader.Read32();
-			dir.addressOfNameOrdinals = reader.Read32();
+			PEExportDirectory dir = reader.ReadStruct<PEExportDirectory>(&PEExportDirectory::characteristics,
+				&PEExportDirectory::timestamp, &PEExportDirectory::majorVersion, &PEExportDirectory::minorVersion,
+				&PEExportDirectory::dllNameAddress, &PEExportDirectory::base, &PEExportDirectory::functionCount,
+				&PEExportDirectory::nameCount, &PEExportDirectory::addressOfFunctions,
+				&PEExportDirectory::addressOfNames, &PEExportDirectory::addressOfNameOrdinals);
 
 			// Create Export Directory Table Type
 			StructureBuilder exportDirBuilder;
@@ -2476,11 +2333,8 @@ bool PEView::Init()
 			DefineDataVariable(m_imageBase + dir.addressOfFunctions, Type::ArrayType(Type::IntegerType(4, false), dir.functionCount));
 			DefineAutoSymbol(new Symbol(DataSymbol, tableName, m_imageBase + dir.addressOfFunctions, NoBinding));
 
-			vector<uint32_t> funcs;
 			reader.Seek(RVAToFileOffset(dir.addressOfFunctions));
-			funcs.reserve(dir.functionCount);
-			for (uint32_t i = 0; i < dir.functionCount; i++)
-				funcs.push_back(reader.Read32());
+			vector<uint32_t> funcs = reader.ReadArray<uint32_t>(dir.functionCount);
 
 			vector<uint32_t> nameAddrs;
 			if (dir.addressOfNames != 0)
@@ -2489,10 +2343,8 @@ bool PEView::Init()
 				DefineDataVariable(m_imageBase + dir.addressOfNames, Type::ArrayType(Type::IntegerType(4, false), dir.nameCount));
 				DefineAutoSymbol(new Symbol(DataSymbol, tableName, m_imageBase + dir.addressOfNames, NoBinding));
 
-				nameAddrs.reserve(dir.nameCount);
 				reader.Seek(RVAToFileOffset(dir.addressOfNames));
-				for (uint32_t i = 0; i < dir.nameCount; i++)
-					nameAddrs.push_back(reader.Read32());
+				nameAddrs = reader.ReadArray<uint32_t>(dir.nameCount);
 			}
 
 			vector<uint16_t> nameOrdinals;
@@ -2502,10 +2354,8 @@ bool PEView::Init()
 				DefineDataVariable(m_imageBase + dir.addressOfNameOrdinals, Type::ArrayType(Type::IntegerType(2, false), dir.nameCount));
 				DefineAutoSymbol(new Symbol(DataSymbol, tableName, m_imageBase + dir.addressOfNameOrdinals, NoBinding));
 
-				nameOrdinals.reserve(dir.nameCount);
 				reader.Seek(RVAToFileOffset(dir.addressOfNameOrdinals));
-				for (uint32_t i = 0; i < dir.nameCount; i++)
-					nameOrdinals.push_back(reader.Read16());
+				nameOrdinals = reader.ReadArray<uint16_t>(dir.nameCount);
 			}
 
 			map<uint16_t, string> namesByOrdinal;
@@ -2644,6 +2494,245 @@ bool PEView::Init()
 			DefineRelocation(m_arch, reloc, symbol, reloc.address);
 	}
 
+	if (!backgroundDirectories)
+		ProcessResourceDirectory();
+
+	Ref<Settings> programSettings = Settings::Instance();
+	if (programSettings->Contains("core.function.analyzeConditionalNoReturns") &&
+		opt.subsystem != IMAGE_SUBSYSTEM_NATIVE && (
+			GetSymbolByRawName("TerminateProcess", GetExternalNameSpace()) ||
+			GetSymbolByRawName("_TerminateProcess@8", GetExternalNameSpace())))
+	{
+		// TerminateProcess is imported and this is a user mode file
+		programSettings->Set("core.function.analyzeConditionalNoReturns", true);
+	}
+
+	// Add a symbol for the entry point
+	if (m_entryPoint)
+		DefineAutoSymbol(new Symbol(FunctionSymbol, "_start", m_imageBase + m_entryPoint));
+	std::chrono::steady_clock::time_point endTime = std::chrono::steady_clock::now();
+	double t = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count() / 1000.0;
+	m_logger->LogInfo("PE parsing took %.3f seconds\n", t);
+
+	if (backgroundDirectories)
+	{
+		// The reference keeps the view alive until the directories are loaded. Function starts found here are only
+		// queued, so a caller that already waited on analysis may not have them yet.
+		Ref<PEView> view = this;
+		uint16_t machine = header.machine;
+		WorkerEnqueue([view, machine, platform, processExceptionTable]() {
+			std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+			Ref<BackgroundTask> task = new BackgroundTask("Loading PE directories", true);
+			view->ProcessExceptionDirectory(machine, platform, processExceptionTable, task);
+			if (!task->IsCancelled())
+				view->ProcessResourceDirectory(task);
+			task->Finish();
+			std::chrono::steady_clock::time_point endTime = std::chrono::steady_clock::now();
+			double t = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count() / 1000.0;
+			view->m_logger->LogInfo("PE directory loading took %.3f seconds\n", t);
+		}, "PE Directory Loading");
+	}
+
+	return true;
+}
+
+
+void PEView::ProcessExceptionDirectory(uint16_t machine, Ref<Platform> platform, bool processExceptionTable,
+	BackgroundTask* task)
+{
+	bool bulkModifying = false;
+	try
+	{
+		if ((m_dataDirs.size() <= IMAGE_DIRECTORY_ENTRY_EXCEPTION) || !m_dataDirs[IMAGE_DIRECTORY_ENTRY_EXCEPTION].size)
+			return;
+
+		// Create Exception Directory Table Entry Type
+		size_t entrySize;
+		size_t numExceptionEntries;
+		StructureBuilder exceptionEntryBuilder;
+		switch (machine)
+		{
+			case IMAGE_FILE_MACHINE_AMD64:
+			case IMAGE_FILE_MACHINE_IA64:
+			{
+				entrySize = 12;
+				exceptionEntryBuilder.AddMember(Type::IntegerType(4, false), "beginAddress");
+				exceptionEntryBuilder.AddMember(Type::IntegerType(4, false), "endAddress");
+				exceptionEntryBuilder.AddMember(Type::IntegerType(4, false), "unwindInformation");
+				break;
+			}
+			case IMAGE_FILE_MACHINE_MIPSFPU:
+			case IMAGE_FILE_MACHINE_R4000:
+			case IMAGE_FILE_MACHINE_WCEMIPSV2:
+			{
+				entrySize = 20;
+				exceptionEntryBuilder.AddMember(Type::IntegerType(4, false), "beginAddress");
+				exceptionEntryBuilder.AddMember(Type::IntegerType(4, false), "endAddress");
+				exceptionEntryBuilder.AddMember(Type::IntegerType(4, false), "exceptionHandler");
+				exceptionEntryBuilder.AddMember(Type::IntegerType(4, false), "handlerData");
+				exceptionEntryBuilder.AddMember(Type::IntegerType(4, false), "prologEndAddress");
+				break;
+			}
+			default:
+			{
+				entrySize = 8;
+				exceptionEntryBuilder.AddMember(Type::IntegerType(4, false), "beginAddress");
+				exceptionEntryBuilder.AddMember(Type::IntegerType(4, false), "otherInformation");
+				break;
+			}
+		}
+
+		if (m_dataDirs[IMAGE_DIRECTORY_ENTRY_EXCEPTION].size % entrySize)
+			throw PEFormatException("invalid table size");
+		numExceptionEntries = m_dataDirs[IMAGE_DIRECTORY_ENTRY_EXCEPTION].size / entrySize;
+		uint64_t exceptionDirStart = m_imageBase + m_dataDirs[IMAGE_DIRECTORY_ENTRY_EXCEPTION].virtualAddress;
+
+		// This DataVariable can end up creating a large array and rendering this in LinearView currently has performance implications
+		// So instead we just create separate structures not in an array
+		Ref<Structure> exceptionEntryStruct = exceptionEntryBuilder.Finalize();
+		Ref<Type> exceptionEntryType = Type::StructureType(exceptionEntryStruct);
+		QualifiedName exceptionEntryName = string("Exception_Directory_Entry");
+		string exceptionEntryTypeId = Type::GenerateAutoTypeId("pe", exceptionEntryName);
+		QualifiedName exceptionEntryTypeName = DefineType(exceptionEntryTypeId, exceptionEntryName, exceptionEntryType);
+
+		// parse exception table and add functions
+		QualifiedName unwindInfo;
+		vector<uint32_t> exceptionTable;
+		size_t numReadableEntries = 0;
+		if (processExceptionTable)
+		{
+			StructureBuilder unwindInfoStructBuilder;
+			unwindInfoStructBuilder.AddMember(Type::IntegerType(1, false), "VersionAndFlag");
+			unwindInfoStructBuilder.AddMember(Type::IntegerType(1, false), "SizeOfProlog");
+			unwindInfoStructBuilder.AddMember(Type::IntegerType(1, false), "CountOfUnwindCodes");
+			unwindInfoStructBuilder.AddMember(Type::IntegerType(1, false), "FrameRegisterAndFrameRegisterOffset");
+
+			Ref<Structure> unwindInfoStruct = unwindInfoStructBuilder.Finalize();
+			Ref<Type> unwindInfoStructType = Type::StructureType(unwindInfoStruct);
+			QualifiedName unwindInfoName = string("UNWIND_INFO");
+			string unwindInfoTypeId = Type::GenerateAutoTypeId("pe", unwindInfoName);
+			unwindInfo = DefineType(unwindInfoTypeId, unwindInfoName, unwindInfoStructType);
+
+			// Every entry is made of 32 bit fields, so read the whole table at once
+			BinaryReader reader(GetParentView(), LittleEndian);
+			try
+			{
+				reader.Seek(RVAToFileOffset(m_dataDirs[IMAGE_DIRECTORY_ENTRY_EXCEPTION].virtualAddress));
+				exceptionTable = reader.ReadArray<uint32_t>(numExceptionEntries * (entrySize / 4));
+				numReadableEntries = numExceptionEntries;
+			}
+			catch (ReadException&)
+			{
+				// Part of the table can't be read, keep the entries before the first one that can't
+				exceptionTable.clear();
+				try
+				{
+					for (; numReadableEntries < numExceptionEntries; numReadableEntries++)
+					{
+						reader.Seek(RVAToFileOffset(
+							m_dataDirs[IMAGE_DIRECTORY_ENTRY_EXCEPTION].virtualAddress + (numReadableEntries * entrySize)));
+						for (size_t j = 0; j < entrySize / 4; j++)
+							exceptionTable.push_back(reader.Read32());
+					}
+				}
+				catch (ReadException&)
+				{
+					exceptionTable.resize(numReadableEntries * (entrySize / 4));
+				}
+			}
+		}
+
+		// When loading in the background the entries are defined a chunk at a time, and the function starts of each
+		// chunk are queued for analysis right away instead of after the whole table. The loader never starts analysis
+		// itself; the next analysis update picks them up.
+		size_t entriesPerChunk = task ? 0x1000 : numExceptionEntries;
+		BinaryReader unwindReader(GetParentView(), LittleEndian);
+		for (size_t chunkStart = 0; chunkStart < numExceptionEntries; chunkStart += entriesPerChunk)
+		{
+			size_t chunkEnd = std::min(numExceptionEntries, chunkStart + entriesPerChunk);
+			if (task)
+			{
+				if (task->IsCancelled())
+					return;
+				task->SetProgressText(fmt::format("Loading PE exception directory ({}/{})", chunkStart, numExceptionEntries));
+				BeginBulkModifySymbols();
+				bulkModifying = true;
+			}
+
+			for (size_t i = chunkStart; i < chunkEnd; i++)
+			{
+				DefineDataVariable(exceptionDirStart + (entrySize * i), Type::NamedType(this, exceptionEntryTypeName));
+				DefineAutoSymbol(new Symbol(DataSymbol, "__exception_directory_entries(" + string(std::to_string(i)) + ")", exceptionDirStart + (entrySize * i), NoBinding));
+			}
+
+			for (size_t i = chunkStart; processExceptionTable && (i < std::min(chunkEnd, numReadableEntries)); i++)
+			{
+				const uint32_t* exceptionEntryFields = &exceptionTable[i * (entrySize / 4)];
+				uint32_t beginAddress = exceptionEntryFields[0];
+				switch (machine)
+				{
+					case IMAGE_FILE_MACHINE_AMD64:
+					case IMAGE_FILE_MACHINE_IA64:
+					{
+						// exceptionEntryFields[1] is EndAddress
+						uint32_t unwindRva = exceptionEntryFields[2];
+						DefineDataVariable(m_imageBase + unwindRva, Type::NamedType(this, unwindInfo));
+						unwindReader.Seek(RVAToFileOffset(unwindRva));
+						uint32_t unwindInformation = unwindReader.Read32();
+						uint8_t unwindCodeCount = (unwindInformation >> 16) & 0xff;
+						if (unwindCodeCount > 0)
+							DefineDataVariable(m_imageBase + unwindRva + 4, Type::ArrayType(Type::IntegerType(2, false), unwindCodeCount));
+
+						auto current = m_imageBase + unwindRva + 4 + (unwindCodeCount * 2);
+						if (current % 4 != 0)
+							current += 4 - (current % 4); // Align to DWORD
+
+						if (unwindInformation & (UNW_FLAG_CHAININFO << 3))
+						{
+							DefineDataVariable(current, Type::NamedType(this, exceptionEntryTypeName));
+							continue;
+						}
+						else if ((unwindInformation & (UNW_FLAG_UHANDLER << 3)) || (unwindInformation & (UNW_FLAG_EHANDLER << 3)))
+						{
+							DefineDataVariable(current, Type::IntegerType(4, false));
+							// unwindReader.Seek(RVAToFileOffset(unwindRva + 8 + (unwindCodeCount * 2)));
+							// uint32_t count = unwindReader.Read32();
+							// DefineDataVariable(current + 4, Type::ArrayType(Type::IntegerType(4, false), 3));
+						}
+						break;
+					}
+					default:
+						break;
+				}
+				uint64_t exceptionEntry = m_imageBase + beginAddress;
+				Ref<Platform> targetPlatform = platform->GetAssociatedPlatformByAddress(exceptionEntry);
+				AddFunctionForAnalysis(targetPlatform, exceptionEntry);
+			}
+
+			if (task)
+			{
+				bulkModifying = false;
+				EndBulkModifySymbols();
+			}
+		}
+
+		// Report the unreadable entry the same way as a failure while parsing the table
+		if (processExceptionTable && (numReadableEntries < numExceptionEntries))
+			throw ReadException();
+	}
+	catch (std::exception& e)
+	{
+		if (bulkModifying)
+			EndBulkModifySymbols();
+		m_logger->LogWarn("Failed to parse exception directory: %s\n", e.what());
+	}
+}
+
+
+void PEView::ProcessResourceDirectory(BackgroundTask* task)
+{
+	BinaryReader reader(GetParentView(), LittleEndian);
+	bool bulkModifying = false;
 	try
 	{
 		//TODO: properly name tables, entries, data entries
@@ -2698,20 +2787,24 @@ bool PEView::Init()
 
 			std::list<uint64_t> tableAddrsToParse = {dir.virtualAddress};
 
+			if (task)
+			{
+				task->SetProgressText("Loading PE resource directory");
+				BeginBulkModifySymbols();
+				bulkModifying = true;
+			}
+
 			uint32_t resourceDirectoryTableNum = 0;
-			while (!tableAddrsToParse.empty())
+			while (!tableAddrsToParse.empty() && !(task && task->IsCancelled()))
 			{
 				uint64_t tableAddr = tableAddrsToParse.front();
 				tableAddrsToParse.pop_front();
 				// Read in next directory entry
 				reader.Seek(RVAToFileOffset(tableAddr));
-				PEResourceDirectoryTable importDirTable;
-				importDirTable.characteristics = reader.Read32();
-				importDirTable.timeDateStamp = reader.Read32();
-				importDirTable.majorVersion = reader.Read16();
-				importDirTable.minorVersion = reader.Read16();
-				importDirTable.numNameEntries = reader.Read16();
-				importDirTable.numIdEntries = reader.Read16();
+				PEResourceDirectoryTable importDirTable = reader.ReadStruct<PEResourceDirectoryTable>(
+					&PEResourceDirectoryTable::characteristics, &PEResourceDirectoryTable::timeDateStamp,
+					&PEResourceDirectoryTable::majorVersion, &PEResourceDirectoryTable::minorVersion,
+					&PEResourceDirectoryTable::numNameEntries, &PEResourceDirectoryTable::numIdEntries);
 
 				DefineDataVariable(m_imageBase + tableAddr, Type::NamedType(this, resourceDirTableTypeName));
 				DefineAutoSymbol(new Symbol(DataSymbol, fmt::format("__resource_directory_table_{}", resourceDirectoryTableNum), m_imageBase + tableAddr, NoBinding));
@@ -2730,12 +2823,10 @@ bool PEView::Init()
 
 				if (numTableEntries > 0)
 				{
-					for (size_t entryNum = 0; entryNum < numTableEntries; entryNum++)
+					auto tableEntries = reader.ReadArray<PEResourceDirectoryEntry>(
+						numTableEntries, &PEResourceDirectoryEntry::id, &PEResourceDirectoryEntry::offset);
+					for (const auto& importDirEntry : tableEntries)
 					{
-						PEResourceDirectoryEntry importDirEntry;
-						importDirEntry.id = reader.Read32();
-						importDirEntry.offset = reader.Read32();
-
 						if (importDirEntry.id & 0x80000000)
 						{
 							// Name entry
@@ -2774,11 +2865,9 @@ bool PEView::Init()
 
 					size_t entryOffset = dataEntryOffsets[dataEntryNum];
 					entryReader.Seek(RVAToFileOffset(dir.virtualAddress + entryOffset));
-					PEResourceDataEntry dataEntry;
-					dataEntry.dataRva = entryReader.Read32();
-					dataEntry.dataSize = entryReader.Read32();
-					dataEntry.dataCodePage = entryReader.Read32();
-					dataEntry.reserved = entryReader.Read32();
+					PEResourceDataEntry dataEntry = entryReader.ReadStruct<PEResourceDataEntry>(
+						&PEResourceDataEntry::dataRva, &PEResourceDataEntry::dataSize,
+						&PEResourceDataEntry::dataCodePage, &PEResourceDataEntry::reserved);
 
 					if (dataEntry.reserved != 0)
 					{
@@ -2797,31 +2886,20 @@ bool PEView::Init()
 
 				resourceDirectoryTableNum++;
 			}
+
+			if (bulkModifying)
+			{
+				bulkModifying = false;
+				EndBulkModifySymbols();
+			}
 		}
 	}
 	catch (std::exception& e)
 	{
+		if (bulkModifying)
+			EndBulkModifySymbols();
 		m_logger->LogWarn("Failed to parse resource directory: %s\n", e.what());
 	}
-
-	Ref<Settings> programSettings = Settings::Instance();
-	if (programSettings->Contains("core.function.analyzeConditionalNoReturns") &&
-		opt.subsystem != IMAGE_SUBSYSTEM_NATIVE && (
-			GetSymbolByRawName("TerminateProcess", GetExternalNameSpace()) ||
-			GetSymbolByRawName("_TerminateProcess@8", GetExternalNameSpace())))
-	{
-		// TerminateProcess is imported and this is a user mode file
-		programSettings->Set("core.function.analyzeConditionalNoReturns", true);
-	}
-
-	// Add a symbol for the entry point
-	if (m_entryPoint)
-		DefineAutoSymbol(new Symbol(FunctionSymbol, "_start", m_imageBase + m_entryPoint));
-	std::chrono::steady_clock::time_point endTime = std::chrono::steady_clock::now();
-	double t = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count() / 1000.0;
-	m_logger->LogInfo("PE parsing took %.3f seconds\n", t);
-
-	return true;
 }
 
 
@@ -3120,6 +3198,14 @@ Ref<Settings> PEViewType::GetLoadSettingsForData(BinaryView* data)
 			"description" : "Add function starts sourced from the Exception Handling table (.pdata) to the core for analysis."
 			})");
 
+	settings->RegisterSetting("loader.pe.backgroundDirectoryProcessing",
+			R"({
+			"title" : "Load PE Directories in the Background",
+			"type" : "boolean",
+			"default" : false,
+			"description" : "Load the exception (.pdata) and resource directories in a background task after the view is opened. Function starts from the exception table are queued for analysis as they are loaded, so headless callers waiting on analysis right after loading may see an incomplete function list."
+			})");
+
 	settings->RegisterSetting("loader.pe.processSehTable",
 			R"({
 			"title" : "Process PE Structured Exception Handling Table",
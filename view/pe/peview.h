@@ -473,6 +473,9 @@ namespace BinaryNinja
 		uint64_t Read64(uint64_t rva);
 		void AddPESymbol(BNSymbolType type, const std::string& dll, const std::string& name, uint64_t addr,
 			BNSymbolBinding binding = NoBinding, uint64_t ordinal = 0, std::vector<Ref<TypeLibrary>> lib = {});
+		void ProcessExceptionDirectory(uint16_t machine, Ref<Platform> platform, bool processExceptionTable,
+			BackgroundTask* task = nullptr);
+		void ProcessResourceDirectory(BackgroundTask* task = nullptr);
 
 	protected:
 		virtual uint64_t PerformGetEntryPoint() const override;
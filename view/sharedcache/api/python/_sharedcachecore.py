@@ -54,6 +54,9 @@ BNDSCBackingCacheHandle = ctypes.POINTER(BNDSCBackingCache)
 class BNDSCBackingCacheMapping(ctypes.Structure):
 	pass
 BNDSCBackingCacheMappingHandle = ctypes.POINTER(BNDSCBackingCacheMapping)
+class BNDSCFileAccessorCacheStats(ctypes.Structure):
+	pass
+BNDSCFileAccessorCacheStatsHandle = ctypes.POINTER(BNDSCFileAccessorCacheStats)
 class BNDSCImage(ctypes.Structure):
 	@property
 	def name(self):
@@ -119,6 +122,12 @@ BNDSCBackingCacheMapping._fields_ = [
 		("size", ctypes.c_ulonglong),
 		("fileOffset", ctypes.c_ulonglong),
 	]
+BNDSCFileAccessorCacheStats._fields_ = [
+		("hits", ctypes.c_ulonglong),
+		("misses", ctypes.c_ulonglong),
+		("evictions", ctypes.c_ulonglong),
+		("remaps", ctypes.c_ulonglong),
+	]
 BNDSCImage._fields_ = [
 		("_name", ctypes.c_char_p),
 		("headerAddress", ctypes.c_ulonglong),
@@ -309,6 +318,21 @@ def BNDSCViewGetBackingCaches(
 	return result
 
 
+# -------------------------------------------------------
+# _BNDSCViewGetFileAccessorCacheStats
+
+_BNDSCViewGetFileAccessorCacheStats = core.BNDSCViewGetFileAccessorCacheStats
+_BNDSCViewGetFileAccessorCacheStats.restype = BNDSCFileAccessorCacheStats
+_BNDSCViewGetFileAccessorCacheStats.argtypes = [
+	]
+
+
+# noinspection PyPep8Naming
+def BNDSCViewGetFileAccessorCacheStats(
+		) -> BNDSCFileAccessorCacheStats:
+	return _BNDSCViewGetFileAccessorCacheStats()
+
+
 # -------------------------------------------------------
 # _BNDSCViewGetImageHeaderForAddress
 
@@ -558,6 +582,27 @@ def BNDSCViewLoadImageWithInstallName(
 	return _BNDSCViewLoadImageWithInstallName(cache, cstr(name))
 
 
+# -------------------------------------------------------
+# _BNDSCViewLoadImagesWithInstallNames
+
+_BNDSCViewLoadImagesWithInstallNames = core.BNDSCViewLoadImagesWithInstallNames
+_BNDSCViewLoadImagesWithInstallNames.restype = ctypes.c_bool
+_BNDSCViewLoadImagesWithInstallNames.argtypes = [
+		ctypes.POINTER(BNSharedCache),
+		ctypes.POINTER(ctypes.c_char_p),
+		ctypes.c_ulonglong,
+	]
+
+
+# noinspection PyPep8Naming
+def BNDSCViewLoadImagesWithInstallNames(
+		cache: ctypes.POINTER(BNSharedCache), 
+		names: ctypes.POINTER(ctypes.c_char_p), 
+		count: int
+		) -> bool:
+	return _BNDSCViewLoadImagesWithInstallNames(cache, names, count)
+
+
 # -------------------------------------------------------
 # _BNDSCViewLoadSectionAtAddress
 
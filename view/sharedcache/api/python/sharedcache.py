@@ -111,6 +111,10 @@ class SharedCache:
 	def load_image_with_install_name(self, installName):
 		return sccore.BNDSCViewLoadImageWithInstallName(self.handle, installName)
 
+	def load_images_with_install_names(self, installNames):
+		names = (ctypes.c_char_p * len(installNames))(*[name.encode('utf-8') for name in installNames])
+		return sccore.BNDSCViewLoadImagesWithInstallNames(self.handle, names, len(installNames))
+
 	def load_section_at_address(self, addr):
 		return sccore.BNDSCViewLoadSectionAtAddress(self.handle, addr)
 
@@ -26,6 +26,15 @@ namespace SharedCacheAPI {
 		return BNDSCViewLoadImageWithInstallName(m_object, str);
 	}
 
+	bool SharedCache::LoadImagesWithInstallNames(const std::vector<std::string>& installNames)
+	{
+		std::vector<char*> names;
+		names.reserve(installNames.size());
+		for (const auto& installName : installNames)
+			names.push_back((char*)installName.c_str());
+		return BNDSCViewLoadImagesWithInstallNames(m_object, names.data(), names.size());
+	}
+
 	bool SharedCache::LoadSectionAtAddress(uint64_t addr)
 	{
 		return BNDSCViewLoadSectionAtAddress(m_object, addr);
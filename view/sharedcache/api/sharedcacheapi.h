@@ -661,6 +661,7 @@ namespace SharedCacheAPI {
 		static uint64_t FastGetBackingCacheCount(Ref<BinaryView> view);
 
 		bool LoadImageWithInstallName(std::string installName);
+		bool LoadImagesWithInstallNames(const std::vector<std::string>& installNames);
 		bool LoadSectionAtAddress(uint64_t addr);
 		bool LoadImageContainingAddress(uint64_t addr);
 		std::vector<std::string> GetAvailableImages();
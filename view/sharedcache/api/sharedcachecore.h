@@ -107,6 +107,13 @@ extern "C"
 		uint64_t mmapRefs;
 	} BNDSCMemoryUsageInfo;
 
+	typedef struct BNDSCFileAccessorCacheStats {
+		uint64_t hits;
+		uint64_t misses;
+		uint64_t evictions;
+		uint64_t remaps;
+	} BNDSCFileAccessorCacheStats;
+
 	typedef struct BNDSCSymbolRep {
 		uint64_t address;
 		char* name;
@@ -121,6 +128,7 @@ extern "C"
 	SHAREDCACHE_FFI_API char** BNDSCViewGetInstallNames(BNSharedCache* cache, size_t* count);
 
 	SHAREDCACHE_FFI_API bool BNDSCViewLoadImageWithInstallName(BNSharedCache* cache, char* name);
+	SHAREDCACHE_FFI_API bool BNDSCViewLoadImagesWithInstallNames(BNSharedCache* cache, char** names, size_t count);
 	SHAREDCACHE_FFI_API bool BNDSCViewLoadSectionAtAddress(BNSharedCache* cache, uint64_t name);
 	SHAREDCACHE_FFI_API bool BNDSCViewLoadImageContainingAddress(BNSharedCache* cache, uint64_t address);
 
@@ -149,6 +157,7 @@ extern "C"
 	SHAREDCACHE_FFI_API char* BNDSCViewGetImageHeaderForName(BNSharedCache* cache, char* name);
 
 	[[maybe_unused]] SHAREDCACHE_FFI_API BNDSCMemoryUsageInfo BNDSCViewGetMemoryUsageInfo();
+	[[maybe_unused]] SHAREDCACHE_FFI_API BNDSCFileAccessorCacheStats BNDSCViewGetFileAccessorCacheStats();
 
 #ifdef __cplusplus
 }
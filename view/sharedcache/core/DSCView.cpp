@@ -82,7 +82,10 @@ DSCView::DSCView(const std::string& typeName, BinaryView* data, bool parseOnly)
 DSCView::~DSCView()
 {
 	if (!m_parseOnly)
+	{
 		MMappedFileAccessor::CloseAll(GetFile()->GetSessionId());
+		SharedCacheCore::SharedCache::ForgetSlideInfo(GetFile()->GetSessionId());
+	}
 }
 
 enum DSCPlatform {
@@ -622,11 +625,21 @@ bool DSCView::Init()
 	DefineType(filesetEntryCommandTypeId, filesetEntryCommandName, filesetEntryCommandType);
 
 	std::vector<SharedCacheCore::MemoryRegion> regionsMappedIntoMemory;
-	if (auto meta = GetParentView()->GetParentView()->QueryMetadata(SharedCacheCore::SharedCacheMetadataTag))
+	std::unordered_map<uint64_t, std::string> imageStartToInstallName;
+	std::unordered_map<uint64_t, std::vector<std::pair<uint64_t, std::pair<BNSymbolType, std::string>>>> exportInfos;
+	bool hasPersistedState = false;
+	std::unordered_map<std::string, uint64_t> imageStarts;
+	if (SharedCacheCore::SharedCache::ReadPersistedViewState(
+			GetParentView()->GetParentView(), regionsMappedIntoMemory, imageStarts, exportInfos))
+	{
+		for (const auto& [name, addr] : imageStarts)
+			imageStartToInstallName[addr] = name;
+		hasPersistedState = true;
+	}
+	else if (auto meta = GetParentView()->GetParentView()->QueryMetadata(SharedCacheCore::SharedCacheMetadataTag))
 	{
+		// Databases saved before the binary state was introduced
 		std::string data = GetParentView()->GetParentView()->GetStringMetadata(SharedCacheCore::SharedCacheMetadataTag);
-		std::stringstream ss;
-		ss.str(data);
 		rapidjson::Document result(rapidjson::kObjectType);
 
 		result.Parse(data.c_str());
@@ -652,7 +665,6 @@ bool DSCView::Init()
 			regionsMappedIntoMemory.push_back(region);
 		}
 
-		std::unordered_map<uint64_t, std::string> imageStartToInstallName;
 		// key "m_imageStarts"
 		for (auto& imgV : result["m_imageStarts"].GetArray())
 		{
@@ -661,8 +673,6 @@ bool DSCView::Init()
 			imageStartToInstallName[addr] = name;
 		}
 
-		std::vector<std::pair<uint64_t, std::vector<std::pair<uint64_t, std::pair<BNSymbolType, std::string>>>>> exportInfos;
-
 		for (const auto& obj1 : result["exportInfos"].GetArray())
 		{
 			std::vector<std::pair<uint64_t, std::pair<BNSymbolType, std::string>>> innerVec;
@@ -672,8 +682,13 @@ bool DSCView::Init()
 				innerVec.push_back({ obj2["key"].GetUint64(), innerPair });
 			}
 
-			exportInfos.push_back({obj1["key"].GetUint64(), innerVec});
+			exportInfos[obj1["key"].GetUint64()] = std::move(innerVec);
 		}
+		hasPersistedState = true;
+	}
+
+	if (hasPersistedState)
+	{
 		// We need to re-map data located in the Raw (parent parent) viewtype to the DSCRaw (parent) viewtype.
 		for (auto region : regionsMappedIntoMemory)
 		{
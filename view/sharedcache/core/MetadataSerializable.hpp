@@ -30,25 +30,261 @@
  *
  * Other ser/deser formats (rapidjson objects, strings) also exist. You can use these to achieve nesting, but probably
  avoid that.
+ *
+ * There is also a compact binary form (`StoreBinary()` / `LoadBinary()`), which runs the same Store/Load methods but
+ * writes fields positionally instead of building a JSON document. Because of that, Store and Load must handle the
+ * same fields in the same order. Integers and enums are always written little endian, so the state reads back the
+ * same on any host. Plain structs are written field by field through a `ForEachBinaryStateField(T&, F&&)` overload,
+ * found by argument dependent lookup, that calls F on each field in order.
  * */
 
 #include "binaryninjaapi.h"
 #include "rapidjson/document.h"
 #include "rapidjson/stringbuffer.h"
 #include "rapidjson/prettywriter.h"
+#include <type_traits>
 
 #ifndef SHAREDCACHE_METADATASERIALIZABLE_HPP
 #define SHAREDCACHE_METADATASERIALIZABLE_HPP
 
 #define MSS(name)						 store(#name, name)
 #define MSS_CAST(name, type)			 store(#name, (type) name)
-#define MSS_SUBCLASS(name)		 		 Serialize(#name, name)
+#define MSS_SUBCLASS(name)		 		 (m_binaryWriter ? m_binaryWriter->Write(name) : Serialize(#name, name))
 #define MSL(name)						 name = load(#name, name)
 #define MSL_CAST(name, storedType, type) name = (type)load(#name, (storedType) name)
-#define MSL_SUBCLASS(name)				 Deserialize(#name, name)
+#define MSL_SUBCLASS(name)				 (m_binaryReader ? m_binaryReader->Read(name) : Deserialize(#name, name))
 
 using namespace BinaryNinja;
 
+class MetadataSerializable;
+
+class BinaryStateWriter
+{
+	std::vector<uint8_t> m_data;
+
+public:
+	const std::vector<uint8_t>& GetData() const { return m_data; }
+
+	void WriteBytes(const void* data, size_t length)
+	{
+		auto bytes = (const uint8_t*)data;
+		m_data.insert(m_data.end(), bytes, bytes + length);
+	}
+
+	void WriteCount(uint64_t value)
+	{
+		// ULEB128, since most counts and lengths are tiny
+		do
+		{
+			uint8_t byte = value & 0x7f;
+			value >>= 7;
+			if (value)
+				byte |= 0x80;
+			m_data.push_back(byte);
+		} while (value);
+	}
+
+	void Write(const std::string& value)
+	{
+		WriteCount(value.size());
+		WriteBytes(value.data(), value.size());
+	}
+
+	template <typename A, typename B>
+	void Write(const std::pair<A, B>& value)
+	{
+		Write(value.first);
+		Write(value.second);
+	}
+
+	template <typename T>
+	void Write(const std::vector<T>& value)
+	{
+		WriteCount(value.size());
+		for (const auto& i : value)
+			Write(i);
+	}
+
+	template <typename K, typename V>
+	void Write(const std::map<K, V>& value)
+	{
+		WriteCount(value.size());
+		for (const auto& i : value)
+			Write(i);
+	}
+
+	template <typename K, typename V>
+	void Write(const std::unordered_map<K, V>& value)
+	{
+		WriteCount(value.size());
+		for (const auto& i : value)
+			Write(i);
+	}
+
+	template <typename T>
+	void Write(const T& value)
+	{
+		if constexpr (std::is_base_of_v<MetadataSerializable, T>)
+		{
+			const_cast<T&>(value).StoreBinary(*this);
+		}
+		else if constexpr (std::is_same_v<T, bool>)
+		{
+			m_data.push_back(value ? 1 : 0);
+		}
+		else if constexpr (std::is_enum_v<T>)
+		{
+			Write((std::underlying_type_t<T>)value);
+		}
+		else if constexpr (std::is_integral_v<T>)
+		{
+			auto bits = (std::make_unsigned_t<T>)value;
+			for (size_t i = 0; i < sizeof(T); i++)
+				m_data.push_back((uint8_t)(bits >> (i * 8)));
+		}
+		else if constexpr (std::is_array_v<T>)
+		{
+			for (const auto& i : value)
+				Write(i);
+		}
+		else
+		{
+			ForEachBinaryStateField(const_cast<T&>(value), [&](const auto& field) { Write(field); });
+		}
+	}
+};
+
+class BinaryStateReader
+{
+	const uint8_t* m_data;
+	size_t m_length;
+	size_t m_offset = 0;
+
+public:
+	BinaryStateReader(const uint8_t* data, size_t length) : m_data(data), m_length(length) {}
+
+	bool AtEnd() const { return m_offset >= m_length; }
+
+	void ReadBytes(void* dest, size_t length)
+	{
+		if (length > m_length - m_offset)
+			throw std::runtime_error("Truncated binary state");
+		memcpy(dest, m_data + m_offset, length);
+		m_offset += length;
+	}
+
+	uint64_t ReadCount()
+	{
+		uint64_t result = 0;
+		for (size_t shift = 0; shift < 64; shift += 7)
+		{
+			if (m_offset >= m_length)
+				throw std::runtime_error("Truncated binary state");
+			uint8_t byte = m_data[m_offset++];
+			result |= (uint64_t)(byte & 0x7f) << shift;
+			if (!(byte & 0x80))
+				return result;
+		}
+		throw std::runtime_error("Malformed binary state");
+	}
+
+	void Read(std::string& value)
+	{
+		auto length = ReadCount();
+		if (length > m_length - m_offset)
+			throw std::runtime_error("Truncated binary state");
+		value.assign((const char*)m_data + m_offset, length);
+		m_offset += length;
+	}
+
+	template <typename A, typename B>
+	void Read(std::pair<A, B>& value)
+	{
+		Read(value.first);
+		Read(value.second);
+	}
+
+	template <typename T>
+	void Read(std::vector<T>& value)
+	{
+		auto count = ReadCount();
+		value.clear();
+		value.reserve(std::min<uint64_t>(count, m_length - m_offset));
+		for (uint64_t i = 0; i < count; i++)
+		{
+			T item {};
+			Read(item);
+			value.push_back(std::move(item));
+		}
+	}
+
+	template <typename K, typename V>
+	void Read(std::map<K, V>& value)
+	{
+		auto count = ReadCount();
+		value.clear();
+		for (uint64_t i = 0; i < count; i++)
+		{
+			std::pair<K, V> item {};
+			Read(item);
+			value.insert(std::move(item));
+		}
+	}
+
+	template <typename K, typename V>
+	void Read(std::unordered_map<K, V>& value)
+	{
+		auto count = ReadCount();
+		value.clear();
+		value.reserve(std::min<uint64_t>(count, m_length - m_offset));
+		for (uint64_t i = 0; i < count; i++)
+		{
+			std::pair<K, V> item {};
+			Read(item);
+			value.insert(std::move(item));
+		}
+	}
+
+	template <typename T>
+	void Read(T& value)
+	{
+		if constexpr (std::is_base_of_v<MetadataSerializable, T>)
+		{
+			value.LoadBinary(*this);
+		}
+		else if constexpr (std::is_same_v<T, bool>)
+		{
+			uint8_t byte;
+			ReadBytes(&byte, 1);
+			value = byte != 0;
+		}
+		else if constexpr (std::is_enum_v<T>)
+		{
+			std::underlying_type_t<T> underlying;
+			Read(underlying);
+			value = (T)underlying;
+		}
+		else if constexpr (std::is_integral_v<T>)
+		{
+			uint8_t bytes[sizeof(T)];
+			ReadBytes(bytes, sizeof(T));
+			std::make_unsigned_t<T> bits = 0;
+			for (size_t i = 0; i < sizeof(T); i++)
+				bits |= (std::make_unsigned_t<T>)bytes[i] << (i * 8);
+			value = (T)bits;
+		}
+		else if constexpr (std::is_array_v<T>)
+		{
+			for (auto& i : value)
+				Read(i);
+		}
+		else
+		{
+			ForEachBinaryStateField(value, [&](auto& field) { Read(field); });
+		}
+	}
+};
+
 class MetadataSerializable
 {
 protected:
@@ -65,6 +301,10 @@ protected:
 	DeserContext m_activeDeserContext;
 	SerialContext m_activeContext;
 
+	// Set for the duration of StoreBinary/LoadBinary; store/load write positionally to these instead of JSON.
+	BinaryStateWriter* m_binaryWriter = nullptr;
+	BinaryStateReader* m_binaryReader = nullptr;
+
 public:
 	MetadataSerializable()
 	{
@@ -482,6 +722,11 @@ public:
 	template <typename T>
 	void store(std::string x, T y)
 	{
+		if (m_binaryWriter)
+		{
+			m_binaryWriter->Write(y);
+			return;
+		}
 		Serialize(x, y);
 	}
 
@@ -489,6 +734,11 @@ public:
 	T load(std::string x, T y)
 	{
 		T val;
+		if (m_binaryReader)
+		{
+			m_binaryReader->Read(val);
+			return val;
+		}
 		Deserialize(x, val);
 		return val;
 	}
@@ -524,6 +774,26 @@ public:
 		m_activeDeserContext.doc.CopyFrom(s, m_activeDeserContext.doc.GetAllocator());
 		Load();
 	}
+	void StoreBinary(BinaryStateWriter& writer)
+	{
+		m_binaryWriter = &writer;
+		Store();
+		m_binaryWriter = nullptr;
+	}
+	void LoadBinary(BinaryStateReader& reader)
+	{
+		m_binaryReader = &reader;
+		try
+		{
+			Load();
+		}
+		catch (...)
+		{
+			m_binaryReader = nullptr;
+			throw;
+		}
+		m_binaryReader = nullptr;
+	}
 	Ref<Metadata> AsMetadata() { return new Metadata(AsString()); }
 	bool LoadFromMetadata(const Ref<Metadata>& meta)
 	{
@@ -792,6 +792,21 @@ void DSCObjCProcessor::ReadMethodList(VMReader* reader, ClassBase& cls, std::str
 	auto methodSize = relativeOffsets ? 12 : pointerSize * 3;
 	DefineObjCSymbol(DataSymbol, m_typeNames.methodList, "method_list_" + name, start, true);
 
+	// Relative method lists contain no pointers needing relocation, so decode them straight out of the mapping.
+	MappedSpan relativeEntries;
+	if (relativeOffsets)
+	{
+		try
+		{
+			relativeEntries = reader->ReadSpan(start + sizeof(method_list_t), head.count * methodSize);
+		}
+		catch (...)
+		{
+			m_logger->LogError("Failed to read method list at 0x%llx", start);
+			return;
+		}
+	}
+
 	for (unsigned i = 0; i < head.count; i++)
 	{
 		try
@@ -806,18 +821,13 @@ void DSCObjCProcessor::ReadMethodList(VMReader* reader, ClassBase& cls, std::str
 			// --
 			if (relativeOffsets)
 			{
+				auto entryOffset = i * methodSize;
 				if (m_customRelativeMethodSelectorBase.has_value())
-				{
-					meth.name = m_customRelativeMethodSelectorBase.value() + reader->ReadS32();
-					meth.types = reader->GetOffset() + reader->ReadS32();
-					meth.imp = reader->GetOffset() + reader->ReadS32();
-				}
+					meth.name = m_customRelativeMethodSelectorBase.value() + relativeEntries.Read<int32_t>(entryOffset);
 				else
-				{
-					meth.name = reader->GetOffset() + reader->ReadS32();
-					meth.types = reader->GetOffset() + reader->ReadS32();
-					meth.imp = reader->GetOffset() + reader->ReadS32();
-				}
+					meth.name = cursor + relativeEntries.Read<int32_t>(entryOffset);
+				meth.types = cursor + 4 + relativeEntries.Read<int32_t>(entryOffset + 4);
+				meth.imp = cursor + 8 + relativeEntries.Read<int32_t>(entryOffset + 8);
 			}
 			else
 			{
@@ -828,9 +838,8 @@ void DSCObjCProcessor::ReadMethodList(VMReader* reader, ClassBase& cls, std::str
 			if (!relativeOffsets || directSelectors)
 			{
 				selAddr = meth.name;
-				method.name = reader->ReadCString(meth.name);
-				reader->Seek(meth.types);
-				method.types = reader->ReadCString(meth.types);
+				method.name = reader->ReadStringView(meth.name).str();
+				method.types = reader->ReadStringView(meth.types).str();
 				DefineObjCSymbol(DataSymbol, Type::ArrayType(Type::IntegerType(1, true), method.name.size() + 1),
 					"sel_" + method.name, meth.name, true);
 				DefineObjCSymbol(DataSymbol, Type::ArrayType(Type::IntegerType(1, true), method.types.size() + 1),
@@ -843,15 +852,13 @@ void DSCObjCProcessor::ReadMethodList(VMReader* reader, ClassBase& cls, std::str
 				reader->Seek(meth.name);
 				selRefAddr = meth.name;
 				selRef = ReadPointerAccountingForRelocations(reader);
-				reader->Seek(meth.types);
-				method.types = reader->ReadCString(meth.types);
+				method.types = reader->ReadStringView(meth.types).str();
 				selAddr = selRef;
 				if (const auto& it = m_selectorCache.find(selRef); it != m_selectorCache.end())
 					method.name = it->second;
 				else
 				{
-					reader->Seek(selRef);
-					method.name = reader->ReadCString(selRef);
+					method.name = reader->ReadStringView(selRef).str();
 					m_selectorCache[selRef] = method.name;
 				}
 				auto selType = Type::ArrayType(Type::IntegerType(1, true), method.name.size() + 1);
@@ -3,6 +3,7 @@
 //
 
 #include "binaryninjaapi.h"
+#include "parallel.h"
 
 /* ---
  * This is the primary image loader logic for Shared Caches
@@ -73,6 +74,10 @@ struct ViewStateCacheStore {
 
 	std::unordered_map<uint64_t, std::vector<std::pair<uint64_t, std::pair<BNSymbolType, std::string>>>> m_exportInfos;
 	std::unordered_map<uint64_t, std::vector<std::pair<uint64_t, std::pair<BNSymbolType, std::string>>>> m_symbolInfos;
+
+	bool m_layoutPersisted = false;
+	std::unordered_set<uint64_t> m_persistedExportInfos;
+	std::unordered_set<uint64_t> m_persistedSymbolInfos;
 };
 
 static std::recursive_mutex viewStateMutex;
@@ -116,7 +121,7 @@ static int64_t readSLEB128(DataBuffer& buffer, size_t length, size_t& offset)
 #pragma clang diagnostic pop
 
 
-static uint64_t readLEB128(DataBuffer& p, size_t end, size_t& offset)
+static uint64_t readLEB128(const uint8_t* p, size_t end, size_t& offset)
 {
 	uint64_t result = 0;
 	int bit = 0;
@@ -139,12 +144,9 @@ static uint64_t readLEB128(DataBuffer& p, size_t end, size_t& offset)
 }
 
 
-uint64_t readValidULEB128(DataBuffer& buffer, size_t& cursor)
+static uint64_t readLEB128(DataBuffer& p, size_t end, size_t& offset)
 {
-	uint64_t value = readLEB128(buffer, buffer.GetLength(), cursor);
-	if ((int64_t)value == -1)
-		throw ReadException();
-	return value;
+	return readLEB128((const uint8_t*)p.GetData(), std::min(end, p.GetLength()), offset);
 }
 
 
@@ -977,7 +979,7 @@ std::shared_ptr<VM> SharedCache::GetVMMap(bool mapPages)
 
 void SharedCache::DeserializeFromRawView()
 {
-	if (m_dscView->QueryMetadata(SharedCacheMetadataTag))
+	if (m_dscView->QueryMetadata(SharedCacheStateMetadataTag) || m_dscView->QueryMetadata(SharedCacheMetadataTag))
 	{
 		std::unique_lock<std::recursive_mutex> viewStateCacheLock(viewStateMutex);
 		if (viewStateCache.find(m_dscView->GetFile()->GetSessionId()) != viewStateCache.end())
@@ -996,16 +998,22 @@ void SharedCache::DeserializeFromRawView()
 			m_baseFilePath = c.m_baseFilePath;
 			m_exportInfos = c.m_exportInfos;
 			m_symbolInfos = c.m_symbolInfos;
+			m_layoutPersisted = c.m_layoutPersisted;
+			m_persistedExportInfos = c.m_persistedExportInfos;
+			m_persistedSymbolInfos = c.m_persistedSymbolInfos;
 			m_metadataValid = true;
 		}
-		else
+		else if (!DeserializeFromBinaryState())
 		{
-			LoadFromString(m_dscView->GetStringMetadata(SharedCacheMetadataTag));
+			// A failed binary load may have filled in part of the state before giving up
+			ClearViewState();
+			if (m_dscView->QueryMetadata(SharedCacheMetadataTag))
+				LoadFromString(m_dscView->GetStringMetadata(SharedCacheMetadataTag));
 		}
 		if (!m_metadataValid)
 		{
 			m_logger->LogError("Failed to deserialize Shared Cache metadata");
-			m_viewState = DSCViewStateUnloaded;
+			ClearViewState();
 		}
 	}
 	else
@@ -1017,6 +1025,27 @@ void SharedCache::DeserializeFromRawView()
 }
 
 
+void SharedCache::ClearViewState()
+{
+	m_metadataValid = false;
+	m_viewState = DSCViewStateUnloaded;
+	m_imageStarts.clear();
+	m_baseFilePath.clear();
+	m_headers.clear();
+	m_backingCaches.clear();
+	m_images.clear();
+	m_regionsMappedIntoMemory.clear();
+	m_stubIslandRegions.clear();
+	m_dyldDataRegions.clear();
+	m_nonImageRegions.clear();
+	m_exportInfos.clear();
+	m_symbolInfos.clear();
+	m_layoutPersisted = false;
+	m_persistedExportInfos.clear();
+	m_persistedSymbolInfos.clear();
+}
+
+
 std::string to_hex_string(uint64_t value)
 {
 	std::stringstream ss;
@@ -1025,26 +1054,73 @@ std::string to_hex_string(uint64_t value)
 }
 
 
-void SharedCache::ParseAndApplySlideInfoForFile(std::shared_ptr<MMappedFileAccessor> file)
+namespace {
+	// The pages of one mapping that have slide info chains, as file offsets to the first pointer of each chain.
+	struct SlideInfoPageStarts
+	{
+		MappingInfo mapping;
+		std::vector<uint64_t> pageStartFileOffsets;
+	};
+
+	struct SlideInfoPlan
+	{
+		uint64_t base;
+		std::vector<SlideInfoPageStarts> mappings;
+	};
+}
+
+// Parsed slide info per view session and cache file. Mappings are private copies of the file, so a file whose mapping
+// was released has to be slid again when it is remapped; keeping the parsed page starts around means that only redoes
+// the pointer chains. Dropped with the view in ForgetSlideInfo.
+static std::mutex slideInfoPlansMutex;
+static std::unordered_map<uint64_t, std::unordered_map<std::string, std::shared_ptr<SlideInfoPlan>>> slideInfoPlans;
+
+
+static std::vector<uint64_t> ReadSlideInfoPageStarts(std::shared_ptr<MMappedFileAccessor> file, const MappingInfo& mapping,
+	uint64_t pageStartsOffset, uint64_t pageStartCount, uint64_t pageSize, Ref<Logger> logger)
 {
-	if (file->SlideInfoWasApplied())
-		return;
-	std::vector<std::pair<uint64_t, uint64_t>> rewrites;
+	std::vector<uint64_t> pageStartFileOffsets;
+	MappedSpan pageStarts;
+	try
+	{
+		pageStarts = file->ReadSpan(pageStartsOffset, pageStartCount * sizeof(uint16_t));
+	}
+	catch (MappingReadException& ex)
+	{
+		logger->LogError("Failed to read slide info at 0x%llx\n", pageStartsOffset);
+		return pageStartFileOffsets;
+	}
 
-	dyld_cache_header baseHeader;
-	file->Read(&baseHeader, 0, sizeof(dyld_cache_header));
-	uint64_t base = UINT64_MAX;
-	for (const auto& backingCache : m_backingCaches)
+	pageStartFileOffsets.reserve(pageStartCount);
+	for (size_t i = 0; i < pageStartCount; i++)
 	{
-		for (const auto& mapping : backingCache.mappings)
+		uint64_t pageStart = pageStarts.Read<uint16_t>(i * sizeof(uint16_t));
+		if (mapping.slideInfoVersion == 5)
 		{
-			if (mapping.second.first < base)
-			{
-				base = mapping.second.first;
-				break;
-			}
+			if (pageStart == DYLD_CACHE_SLIDE_V5_PAGE_ATTR_NO_REBASE)
+				continue;
 		}
+		else
+		{
+			// v2 page starts are in units of 4 bytes, and are checked for the attribute bit once scaled
+			if (mapping.slideInfoVersion == 2)
+				pageStart *= 4;
+			if (pageStart & 0x4000)
+				continue;
+		}
+		pageStartFileOffsets.push_back(mapping.mappingInfo.fileOffset + (pageSize * i) + pageStart);
 	}
+	return pageStartFileOffsets;
+}
+
+
+static std::shared_ptr<SlideInfoPlan> ParseSlideInfo(std::shared_ptr<MMappedFileAccessor> file, uint64_t base, Ref<Logger> logger)
+{
+	auto plan = std::make_shared<SlideInfoPlan>();
+	plan->base = base;
+
+	dyld_cache_header baseHeader;
+	file->Read(&baseHeader, 0, sizeof(dyld_cache_header));
 
 	std::vector<std::pair<uint64_t, MappingInfo>> mappings;
 
@@ -1062,7 +1138,6 @@ void SharedCache::ParseAndApplySlideInfoForFile(std::shared_ptr<MMappedFileAcces
 		MappingInfo map;
 
 		file->Read(&map.mappingInfo, baseHeader.mappingOffset + sizeof(dyld_cache_mapping_info), sizeof(dyld_cache_mapping_info));
-		map.file = file;
 		map.slideInfoVersion = slideInfoVersion;
 		if (map.slideInfoVersion == 2)
 			file->Read(&map.slideInfoV2, slideInfoOff, sizeof(dyld_cache_slide_info_v2));
@@ -1078,7 +1153,7 @@ void SharedCache::ParseAndApplySlideInfoForFile(std::shared_ptr<MMappedFileAcces
 
 		if (targetHeader.mappingWithSlideCount == 0)
 		{
-			m_logger->LogDebug("No mappings with slide info found");
+			logger->LogDebug("No mappings with slide info found");
 		}
 
 		for (auto i = 0; i < targetHeader.mappingWithSlideCount; i++)
@@ -1088,11 +1163,10 @@ void SharedCache::ParseAndApplySlideInfoForFile(std::shared_ptr<MMappedFileAcces
 			if (mappingAndSlideInfo.slideInfoFileOffset)
 			{
 				MappingInfo map;
-				map.file = file;
 				if (mappingAndSlideInfo.size == 0)
 					continue;
 				map.slideInfoVersion = file->ReadUInt32(mappingAndSlideInfo.slideInfoFileOffset);
-				m_logger->LogDebug("Slide Info Version: %d", map.slideInfoVersion);
+				logger->LogDebug("Slide Info Version: %d", map.slideInfoVersion);
 				map.mappingInfo.address = mappingAndSlideInfo.address;
 				map.mappingInfo.size = mappingAndSlideInfo.size;
 				map.mappingInfo.fileOffset = mappingAndSlideInfo.fileOffset;
@@ -1115,215 +1189,191 @@ void SharedCache::ParseAndApplySlideInfoForFile(std::shared_ptr<MMappedFileAcces
 				}
 				else
 				{
-					m_logger->LogError("Unknown slide info version: %d", map.slideInfoVersion);
+					logger->LogError("Unknown slide info version: %d", map.slideInfoVersion);
 					continue;
 				}
 
 				uint64_t slideInfoOffset = mappingAndSlideInfo.slideInfoFileOffset;
 				mappings.emplace_back(slideInfoOffset, map);
-				m_logger->LogDebug("Filename: %s", file->Path().c_str());
-				m_logger->LogDebug("Slide Info Offset: 0x%llx", slideInfoOffset);
-				m_logger->LogDebug("Mapping Address: 0x%llx", map.mappingInfo.address);
-				m_logger->LogDebug("Slide Info v", map.slideInfoVersion);
+				logger->LogDebug("Filename: %s", file->Path().c_str());
+				logger->LogDebug("Slide Info Offset: 0x%llx", slideInfoOffset);
+				logger->LogDebug("Mapping Address: 0x%llx", map.mappingInfo.address);
+				logger->LogDebug("Slide Info v", map.slideInfoVersion);
 			}
 		}
 	}
 
-	if (mappings.empty())
-	{
-		m_logger->LogDebug("No slide info found");
-		file->SetSlideInfoWasApplied(true);
-		return;
-	}
-
 	for (const auto& [off, mapping] : mappings)
 	{
-		m_logger->LogDebug("Slide Info Version: %d", mapping.slideInfoVersion);
-		uint64_t pageStartsOffset = off;
-		uint64_t pageStartCount;
-		uint64_t pageSize;
-		std::vector<uint64_t> pageStartFileOffsets;
+		logger->LogDebug("Slide Info Version: %d", mapping.slideInfoVersion);
+		SlideInfoPageStarts pages;
+		pages.mapping = mapping;
 
 		if (mapping.slideInfoVersion == 2)
 		{
-			pageStartsOffset += mapping.slideInfoV2.page_starts_offset;
-			pageStartCount = mapping.slideInfoV2.page_starts_count;
-			pageSize = mapping.slideInfoV2.page_size;
+			pages.pageStartFileOffsets = ReadSlideInfoPageStarts(file, mapping,
+				off + mapping.slideInfoV2.page_starts_offset, mapping.slideInfoV2.page_starts_count,
+				mapping.slideInfoV2.page_size, logger);
+		}
+		else if (mapping.slideInfoVersion == 3)
+		{
+			pages.pageStartFileOffsets = ReadSlideInfoPageStarts(file, mapping,
+				off + sizeof(dyld_cache_slide_info_v3), mapping.slideInfoV3.page_starts_count,
+				mapping.slideInfoV3.page_size, logger);
+		}
+		else if (mapping.slideInfoVersion == 5)
+		{
+			logger->LogDebug("Page Start Count: %d", mapping.slideInfoV5.page_starts_count);
+			pages.pageStartFileOffsets = ReadSlideInfoPageStarts(file, mapping,
+				off + sizeof(dyld_cache_slide_info5), mapping.slideInfoV5.page_starts_count,
+				mapping.slideInfoV5.page_size, logger);
+		}
+		if (pages.pageStartFileOffsets.empty())
+		{
+			logger->LogDebug("No page start file offsets found");
+			continue;
+		}
+		plan->mappings.push_back(std::move(pages));
+	}
 
-			pageStartFileOffsets.reserve(pageStartCount);
-			size_t cursor = pageStartsOffset;
+	return plan;
+}
 
-			for (size_t i = 0; i < pageStartCount; i++)
-			{
-				try
-				{
-					uint64_t pageStart = mapping.file->ReadUShort(cursor) * 4;
-					cursor += 2;
-					if (pageStart & 0x4000)
-						continue;
-					pageStartFileOffsets.push_back(mapping.mappingInfo.fileOffset + (pageSize * i) + pageStart);
-				}
-				catch (MappingReadException& ex)
-				{
 
-				}
-			}
-		}
-		else if (mapping.slideInfoVersion == 3) {
-			// Slide Info Version 3 Logic
-			pageStartsOffset += sizeof(dyld_cache_slide_info_v3);
-			pageStartCount = mapping.slideInfoV3.page_starts_count;
-			pageSize = mapping.slideInfoV3.page_size;
+// Walk the chain of slid pointers starting at `pageStart`, rewriting each one in place in the mapping.
+// Chains never cross a page, so chains for different pages can be applied concurrently.
+static size_t ApplySlideInfoChain(uint8_t* data, size_t length, const MappingInfo& mapping, uint64_t pageStart,
+	uint64_t base, Ref<Logger> logger, std::vector<std::pair<uint64_t, uint64_t>>* rewrites = nullptr)
+{
+	uint64_t deltaMask = mapping.slideInfoV2.delta_mask;
+	uint64_t valueMask = ~deltaMask;
+	uint64_t valueAdd = mapping.slideInfoV2.value_add;
+	int deltaShift = mapping.slideInfoVersion == 2 ? count_trailing_zeros(deltaMask) - 2 : 0;
 
-			pageStartFileOffsets.reserve(pageStartCount);
-			size_t cursor = pageStartsOffset;
+	size_t rewriteCount = 0;
+	uint64_t loc = pageStart;
+	uint64_t delta = 1;
+	while (delta != 0)
+	{
+		if (loc > length || length - loc < sizeof(uint64_t))
+		{
+			logger->LogError("Failed to read slide info at 0x%llx\n", loc);
+			break;
+		}
 
-			for (size_t i = 0; i < pageStartCount; i++)
+		uint64_t rawValue;
+		memcpy(&rawValue, data + loc, sizeof(uint64_t));
+		uint64_t value;
+		if (mapping.slideInfoVersion == 2)
+		{
+			delta = (rawValue & deltaMask) >> deltaShift;
+			value = (rawValue & valueMask);
+			if (valueMask != 0)
 			{
-				try
-				{
-					uint64_t pageStart = mapping.file->ReadUShort(cursor);
-					cursor += 2;
-					if (pageStart & 0x4000)
-						continue;
-					pageStartFileOffsets.push_back(mapping.mappingInfo.fileOffset + (pageSize * i) + pageStart);
-				}
-				catch (MappingReadException& ex)
-				{
-					m_logger->LogError("Failed to read slide info at 0x%llx\n", cursor);
-				}
+				value += valueAdd;
 			}
 		}
-		else if (mapping.slideInfoVersion == 5)
+		else if (mapping.slideInfoVersion == 3)
 		{
-			pageStartsOffset += sizeof(dyld_cache_slide_info5);
-			pageStartCount = mapping.slideInfoV5.page_starts_count;
-			m_logger->LogDebug("Page Start Count: %d", pageStartCount);
-			pageSize = mapping.slideInfoV5.page_size;
-			auto cursor = pageStartsOffset;
-			for (size_t i = 0; i < pageStartCount; i++)
+			dyld_cache_slide_pointer3 slideInfo;
+			slideInfo.raw = rawValue;
+			delta = slideInfo.plain.offsetToNextPointer * 8;
+
+			if (slideInfo.auth.authenticated)
 			{
-				try
-				{
-					uint64_t pageStart = mapping.file->ReadUShort(cursor);
-					cursor += 2;
-					if (pageStart == DYLD_CACHE_SLIDE_V5_PAGE_ATTR_NO_REBASE)
-						continue;
-					pageStartFileOffsets.push_back(mapping.mappingInfo.fileOffset + (pageSize * i) + pageStart);
-				}
-				catch (MappingReadException& ex)
-				{
-					m_logger->LogError("Failed to read slide info at 0x%llx\n", cursor);
-				}
+				value = slideInfo.auth.offsetFromSharedCacheBase;
+				value += mapping.slideInfoV3.auth_value_add;
+			}
+			else
+			{
+				uint64_t value51 = slideInfo.plain.pointerValue;
+				uint64_t top8Bits = value51 & 0x0007F80000000000;
+				uint64_t bottom43Bits = value51 & 0x000007FFFFFFFFFF;
+				value = (uint64_t)top8Bits << 13 | bottom43Bits;
 			}
 		}
-		if (pageStartFileOffsets.empty())
+		else if (mapping.slideInfoVersion == 5)
 		{
-			m_logger->LogDebug("No page start file offsets found");
+			dyld_cache_slide_pointer5 slideInfo;
+			slideInfo.raw = rawValue;
+			delta = slideInfo.regular.next * 8;
+			if (slideInfo.auth.auth)
+				value = slideInfo.auth.runtimeOffset + mapping.slideInfoV5.value_add;
+			else
+				value = base + slideInfo.regular.runtimeOffset;
 		}
-		for (auto pageStart : pageStartFileOffsets)
+		else
 		{
-			if (mapping.slideInfoVersion == 2)
-			{
-				auto deltaMask = mapping.slideInfoV2.delta_mask;
-				auto valueMask = ~deltaMask;
-				auto valueAdd = mapping.slideInfoV2.value_add;
+			break;
+		}
 
-				auto deltaShift = count_trailing_zeros(deltaMask) - 2;
+		memcpy(data + loc, &value, sizeof(uint64_t));
+		if (rewrites)
+			rewrites->emplace_back(loc, value);
+		rewriteCount++;
+		loc += delta;
+	}
+	return rewriteCount;
+}
 
-				uint64_t delta = 1;
-				uint64_t loc = pageStart;
-				while (delta != 0)
-				{
-					try {
-						uint64_t rawValue = file->ReadULong(loc);
-						delta = (rawValue & deltaMask) >> deltaShift;
-						uint64_t value = (rawValue & valueMask);
-						if (valueMask != 0)
-						{
-							value += valueAdd;
-						}
-						rewrites.emplace_back(loc, value);
-					}
-					catch (MappingReadException& ex)
-					{
-						m_logger->LogError("Failed to read slide info at 0x%llx\n", loc);
-						delta = 0;
-					}
-					loc += delta;
-				}
-			}
-			else if (mapping.slideInfoVersion == 3)
-			{
-				uint64_t loc = pageStart;
-				uint64_t delta = 1;
-				while (delta != 0)
-				{
-					dyld_cache_slide_pointer3 slideInfo;
-					try
-					{
-						file->Read(&slideInfo, loc, 8);
-						delta = slideInfo.plain.offsetToNextPointer * 8;
 
-						if (slideInfo.auth.authenticated)
-						{
-							uint64_t value = slideInfo.auth.offsetFromSharedCacheBase;
-							value += mapping.slideInfoV3.auth_value_add;
-							rewrites.emplace_back(loc, value);
-						}
-						else
-						{
-							uint64_t value51 = slideInfo.plain.pointerValue;
-							uint64_t top8Bits = value51 & 0x0007F80000000000;
-							uint64_t bottom43Bits = value51 & 0x000007FFFFFFFFFF;
-							uint64_t value = (uint64_t)top8Bits << 13 | bottom43Bits;
-							rewrites.emplace_back(loc, value);
-						}
-						loc += delta;
-					}
-					catch (MappingReadException& ex)
-					{
-						m_logger->LogError("Failed to read slide info at 0x%llx\n", loc);
-						delta = 0;
-					}
-				}
-			}
-			else if (mapping.slideInfoVersion == 5)
+void SharedCache::ParseAndApplySlideInfoForFile(std::shared_ptr<MMappedFileAccessor> file)
+{
+	if (file->SlideInfoWasApplied())
+		return;
+
+	uint64_t base = UINT64_MAX;
+	for (const auto& backingCache : m_backingCaches)
+	{
+		for (const auto& mapping : backingCache.mappings)
+		{
+			if (mapping.second.first < base)
 			{
-				uint64_t loc = pageStart;
-				uint64_t delta = 1;
-				while (delta != 0)
-				{
-					dyld_cache_slide_pointer5 slideInfo;
-					try
-					{
-						file->Read(&slideInfo, loc, 8);
-						delta = slideInfo.regular.next * 8;
-						if (slideInfo.auth.auth)
-						{
-							uint64_t value = slideInfo.auth.runtimeOffset + mapping.slideInfoV5.value_add;
-							rewrites.emplace_back(loc, value);
-						}
-						else
-						{
-							uint64_t value = base + slideInfo.regular.runtimeOffset;
-							rewrites.emplace_back(loc, value);
-						}
-						loc += delta;
-					}
-					catch (MappingReadException& ex)
-					{
-						m_logger->LogError("Failed to read slide info at 0x%llx\n", loc);
-						delta = 0;
-					}
-				}
+				base = mapping.second.first;
+				break;
 			}
 		}
 	}
-	for (const auto& [loc, value] : rewrites)
+
+	uint64_t sessionID = m_dscView->GetFile()->GetSessionId();
+	std::shared_ptr<SlideInfoPlan> plan;
 	{
-		file->WritePointer(loc, value);
+		std::unique_lock<std::mutex> lock(slideInfoPlansMutex);
+		auto& plans = slideInfoPlans[sessionID];
+		if (auto it = plans.find(file->Path()); it != plans.end() && it->second->base == base)
+			plan = it->second;
+	}
+	if (!plan)
+	{
+		plan = ParseSlideInfo(file, base, m_logger);
+		std::unique_lock<std::mutex> lock(slideInfoPlansMutex);
+		slideInfoPlans[sessionID][file->Path()] = plan;
+	}
+
+	if (plan->mappings.empty())
+	{
+		m_logger->LogDebug("No slide info found");
+		file->SetSlideInfoWasApplied(true);
+		return;
+	}
+
+	// Mappings are private to us, so the slid pointers are written straight into them.
+	auto data = (uint8_t*)file->Data();
+	size_t length = file->Length();
+	std::atomic<size_t> rewriteCount = 0;
 #ifdef SLIDEINFO_DEBUG_TAGS
+	// Tagging wants every rewrite, so don't bother going wide here
+	std::vector<std::pair<uint64_t, uint64_t>> rewrites;
+	for (const auto& pages : plan->mappings)
+	{
+		for (auto pageStart : pages.pageStartFileOffsets)
+			rewriteCount += ApplySlideInfoChain(data, length, pages.mapping, pageStart, base, m_logger, &rewrites);
+	}
+
+	dyld_cache_header baseHeader;
+	file->Read(&baseHeader, 0, sizeof(dyld_cache_header));
+	for (const auto& [loc, value] : rewrites)
+	{
 		uint64_t vmAddr = 0;
 		{
 			for (uint64_t off = baseHeader.mappingOffset; off < baseHeader.mappingOffset + baseHeader.mappingCount * sizeof(dyld_cache_mapping_info); off += sizeof(dyld_cache_mapping_info))
@@ -1344,9 +1394,16 @@ void SharedCache::ParseAndApplySlideInfoForFile(std::shared_ptr<MMappedFileAcces
 			type = m_dscView->GetTagType("slideinfo");
 		}
 		m_dscView->AddAutoDataTag(vmAddr, new Tag(type, "0x" + to_hex_string(file->ReadULong(loc)) + " => 0x" + to_hex_string(value)));
-#endif
 	}
-	m_logger->LogDebug("Applied slide info for %s (0x%llx rewrites)", file->Path().c_str(), rewrites.size());
+#else
+	for (const auto& pages : plan->mappings)
+	{
+		ParallelForEach(pages.pageStartFileOffsets.size(), [&](size_t i) {
+			rewriteCount += ApplySlideInfoChain(data, length, pages.mapping, pages.pageStartFileOffsets[i], base, m_logger);
+		});
+	}
+#endif
+	m_logger->LogDebug("Applied slide info for %s (0x%llx rewrites)", file->Path().c_str(), rewriteCount.load());
 	file->SetSlideInfoWasApplied(true);
 }
 
@@ -1410,6 +1467,12 @@ SharedCache::SharedCache(BinaryNinja::Ref<BinaryNinja::BinaryView> dscView) : m_
 	}
 }
 
+void SharedCache::ForgetSlideInfo(uint64_t sessionID)
+{
+	std::unique_lock<std::mutex> lock(slideInfoPlansMutex);
+	slideInfoPlans.erase(sessionID);
+}
+
 SharedCache::~SharedCache() {
 	std::unique_lock<std::mutex> lock(viewSpecificMutexes[m_dscView->GetFile()->GetSessionId()].viewOperationsThatInfluenceMetadataMutex);
 	sharedCacheReferences--;
@@ -1713,42 +1776,19 @@ bool SharedCache::LoadSectionAtAddress(uint64_t address)
 	return true;
 }
 
-bool SharedCache::LoadImageWithInstallName(std::string installName)
+std::vector<MemoryRegion*> SharedCache::MapImageRegions(std::shared_ptr<VM> vm, CacheImage& image, Ref<Settings> settings)
 {
-	auto settings = m_dscView->GetLoadSettings(VIEW_NAME);
-
-	std::unique_lock<std::mutex> lock(viewSpecificMutexes[m_dscView->GetFile()->GetSessionId()].viewOperationsThatInfluenceMetadataMutex);
-
-	DeserializeFromRawView();
-	m_logger->LogInfo("Loading image %s", installName.c_str());
-
-	auto vm = GetVMMap();
-	CacheImage* targetImage = nullptr;
-
-	for (auto& cacheImage : m_images)
-	{
-		if (cacheImage.installName == installName)
-		{
-			targetImage = &cacheImage;
-			break;
-		}
-	}
-
-	auto header = m_headers[targetImage->headerLocation];
-
-	auto id = m_dscView->BeginUndoActions();
-	m_viewState = DSCViewStateLoadedWithImages;
-
 	auto reader = VMReader(vm);
-	reader.Seek(targetImage->headerLocation);
+	reader.Seek(image.headerLocation);
+
+	bool allowLoadingLinkedit = false;
+	if (settings && settings->Contains("loader.dsc.allowLoadingLinkeditSegments"))
+		allowLoadingLinkedit = settings->Get<bool>("loader.dsc.allowLoadingLinkeditSegments", m_dscView);
 
 	std::vector<MemoryRegion*> regionsToLoad;
 
-	for (auto& region : targetImage->regions)
+	for (auto& region : image.regions)
 	{
-		bool allowLoadingLinkedit = false;
-		if (settings && settings->Contains("loader.dsc.allowLoadingLinkeditSegments"))
-			allowLoadingLinkedit = settings->Get<bool>("loader.dsc.allowLoadingLinkeditSegments", m_dscView);
 		if ((region.prettyName.find("__LINKEDIT") != std::string::npos) && !allowLoadingLinkedit)
 			continue;
 
@@ -1779,12 +1819,12 @@ bool SharedCache::LoadImageWithInstallName(std::string installName)
 		regionsToLoad.push_back(&region);
 	}
 
-	if (regionsToLoad.empty())
-	{
-		m_logger->LogWarn("No regions to load for image %s", installName.c_str());
-		return false;
-	}
+	return regionsToLoad;
+}
 
+
+void SharedCache::AddTypeLibraryForImage(const SharedCacheMachOHeader& header)
+{
 	std::unique_lock<std::mutex> typelibLock(viewSpecificMutexes[m_dscView->GetFile()->GetSessionId()].typeLibraryLookupAndApplicationMutex);
 	auto typeLib = m_dscView->GetTypeLibrary(header.installName);
 
@@ -1796,27 +1836,14 @@ bool SharedCache::LoadImageWithInstallName(std::string installName)
 			typeLib = typeLibs[0];
 			m_dscView->AddTypeLibrary(typeLib);
 			m_logger->LogInfo("shared-cache: adding type library for '%s': %s (%s)",
-				targetImage->installName.c_str(), typeLib->GetName().c_str(), typeLib->GetGuid().c_str());
+				header.installName.c_str(), typeLib->GetName().c_str(), typeLib->GetGuid().c_str());
 		}
 	}
-	typelibLock.unlock();
-
-	SaveToDSCView();
-
-	auto h = SharedCache::LoadHeaderForAddress(vm, targetImage->headerLocation, installName);
-	if (!h.has_value())
-	{
-		return false;
-	}
-
-	std::vector<MemoryRegion*> regions;
-	for (auto& region : regionsToLoad)
-	{
-		regions.push_back(region);
-	}
+}
 
-	SharedCache::InitializeHeader(m_dscView, vm.get(), *h, regions);
 
+void SharedCache::ProcessObjCForImage(std::shared_ptr<VM> vm, const SharedCacheMachOHeader& header, Ref<Settings> settings)
+{
 	try
 	{
 		auto objc = std::make_unique<DSCObjC::DSCObjCProcessor>(m_dscView, this, false);
@@ -1828,9 +1855,9 @@ bool SharedCache::LoadImageWithInstallName(std::string installName)
 		if (settings && settings->Contains("loader.dsc.processObjC"))
 			processObjCMetadata = settings->Get<bool>("loader.dsc.processObjC", m_dscView);
 		if (processObjCMetadata)
-			objc->ProcessObjCData(vm, h->identifierPrefix);
+			objc->ProcessObjCData(vm, header.identifierPrefix);
 		if (processCFStrings)
-			objc->ProcessCFStrings(vm, h->identifierPrefix);
+			objc->ProcessCFStrings(vm, header.identifierPrefix);
 	}
 	catch (const std::exception& ex)
 	{
@@ -1840,6 +1867,58 @@ bool SharedCache::LoadImageWithInstallName(std::string installName)
 	{
 		m_logger->LogWarn("Error processing ObjC data");
 	}
+}
+
+
+bool SharedCache::LoadImageWithInstallName(std::string installName)
+{
+	auto settings = m_dscView->GetLoadSettings(VIEW_NAME);
+
+	std::unique_lock<std::mutex> lock(viewSpecificMutexes[m_dscView->GetFile()->GetSessionId()].viewOperationsThatInfluenceMetadataMutex);
+
+	DeserializeFromRawView();
+	m_logger->LogInfo("Loading image %s", installName.c_str());
+
+	auto vm = GetVMMap();
+	CacheImage* targetImage = nullptr;
+
+	for (auto& cacheImage : m_images)
+	{
+		if (cacheImage.installName == installName)
+		{
+			targetImage = &cacheImage;
+			break;
+		}
+	}
+
+	auto header = m_headers[targetImage->headerLocation];
+
+	auto id = m_dscView->BeginUndoActions();
+	m_viewState = DSCViewStateLoadedWithImages;
+
+	auto regionsToLoad = MapImageRegions(vm, *targetImage, settings);
+
+	if (regionsToLoad.empty())
+	{
+		m_logger->LogWarn("No regions to load for image %s", installName.c_str());
+		m_dscView->ForgetUndoActions(id);
+		return false;
+	}
+
+	AddTypeLibraryForImage(header);
+
+	SaveToDSCView();
+
+	auto h = SharedCache::LoadHeaderForAddress(vm, targetImage->headerLocation, installName);
+	if (!h.has_value())
+	{
+		m_dscView->ForgetUndoActions(id);
+		return false;
+	}
+
+	SharedCache::InitializeHeader(m_dscView, vm.get(), *h, regionsToLoad);
+
+	ProcessObjCForImage(vm, *h, settings);
 
 	m_dscView->AddAnalysisOption("linearsweep");
 	m_dscView->UpdateAnalysis();
@@ -1849,6 +1928,114 @@ bool SharedCache::LoadImageWithInstallName(std::string installName)
 	return true;
 }
 
+
+bool SharedCache::LoadImagesWithInstallNames(std::vector<std::string> installNames)
+{
+	auto settings = m_dscView->GetLoadSettings(VIEW_NAME);
+
+	std::unique_lock<std::mutex> lock(viewSpecificMutexes[m_dscView->GetFile()->GetSessionId()].viewOperationsThatInfluenceMetadataMutex);
+
+	DeserializeFromRawView();
+	m_logger->LogInfo("Loading %zu images", installNames.size());
+
+	auto vm = GetVMMap();
+
+	std::vector<CacheImage*> targetImages;
+	bool allImagesFound = true;
+	for (const auto& installName : installNames)
+	{
+		auto image = std::find_if(m_images.begin(), m_images.end(),
+			[&](const CacheImage& cacheImage) { return cacheImage.installName == installName; });
+		if (image == m_images.end())
+		{
+			m_logger->LogWarn("Failed to find image %s", installName.c_str());
+			allImagesFound = false;
+			continue;
+		}
+		if (std::find(targetImages.begin(), targetImages.end(), &*image) == targetImages.end())
+			targetImages.push_back(&*image);
+	}
+
+	if (targetImages.empty())
+		return false;
+
+	// Headers and export tries are parsed straight out of the cache files without touching the view,
+	// so do that for every image concurrently and only serialize the view mutations below.
+	struct PreparedImage
+	{
+		std::optional<SharedCacheMachOHeader> header;
+		std::optional<std::vector<Ref<Symbol>>> exportSymbols;
+	};
+	std::vector<PreparedImage> prepared(targetImages.size());
+	ParallelForEach(targetImages.size(), [&](size_t i) {
+		auto image = targetImages[i];
+		try
+		{
+			auto& header = prepared[i].header;
+			header = LoadHeaderForAddress(vm, image->headerLocation, image->installName);
+			if (header && header->exportTriePresent && header->linkeditPresent
+				&& vm->AddressIsMapped(header->linkeditSegment.vmaddr))
+			{
+				prepared[i].exportSymbols = ParseExportTrie(
+					vm->MappingAtAddress(header->linkeditSegment.vmaddr).first.fileAccessor->lock(), *header);
+			}
+		}
+		catch (const std::exception& ex)
+		{
+			m_logger->LogError("Failed to parse image %s: %s", image->installName.c_str(), ex.what());
+			prepared[i] = {};
+		}
+		catch (...)
+		{
+			m_logger->LogError("Failed to parse image %s", image->installName.c_str());
+			prepared[i] = {};
+		}
+	});
+
+	auto id = m_dscView->BeginUndoActions();
+	m_viewState = DSCViewStateLoadedWithImages;
+
+	size_t loadedCount = 0;
+	for (size_t i = 0; i < targetImages.size(); i++)
+	{
+		auto image = targetImages[i];
+		auto& h = prepared[i].header;
+		if (!h.has_value())
+			continue;
+
+		auto regionsToLoad = MapImageRegions(vm, *image, settings);
+		if (regionsToLoad.empty())
+		{
+			m_logger->LogWarn("No regions to load for image %s", image->installName.c_str());
+			continue;
+		}
+
+		AddTypeLibraryForImage(*h);
+
+		SharedCache::InitializeHeader(m_dscView, vm.get(), *h, regionsToLoad, std::move(prepared[i].exportSymbols));
+
+		ProcessObjCForImage(vm, *h, settings);
+
+		loadedCount++;
+	}
+
+	// Only write the view state out once for the whole batch
+	SaveToDSCView();
+
+	if (loadedCount == 0)
+	{
+		m_dscView->ForgetUndoActions(id);
+		return false;
+	}
+
+	m_dscView->AddAnalysisOption("linearsweep");
+	m_dscView->UpdateAnalysis();
+
+	m_dscView->CommitUndoActions(id);
+
+	return allImagesFound && loadedCount == targetImages.size();
+}
+
 std::optional<SharedCacheMachOHeader> SharedCache::LoadHeaderForAddress(std::shared_ptr<VM> vm, uint64_t address, std::string installName)
 {
 	SharedCacheMachOHeader header;
@@ -2257,8 +2444,8 @@ std::optional<SharedCacheMachOHeader> SharedCache::LoadHeaderForAddress(std::sha
 	return header;
 }
 
-void SharedCache::InitializeHeader(
-	Ref<BinaryView> view, VM* vm, SharedCacheMachOHeader header, std::vector<MemoryRegion*> regionsToLoad)
+void SharedCache::InitializeHeader(Ref<BinaryView> view, VM* vm, SharedCacheMachOHeader header,
+	std::vector<MemoryRegion*> regionsToLoad, std::optional<std::vector<Ref<Symbol>>> exportSymbols)
 {
 
 	Ref<Settings> settings = view->GetLoadSettings(VIEW_NAME);
@@ -2630,11 +2817,12 @@ void SharedCache::InitializeHeader(
 			symbolInfos.push_back({sym.n_value, {type, symbol}});
 		}
 		m_symbolInfos[header.textBase] = symbolInfos;
+		m_persistedSymbolInfos.erase(header.textBase);
 	}
 
 	if (header.exportTriePresent && header.linkeditPresent && vm->AddressIsMapped(header.linkeditSegment.vmaddr))
 	{
-		auto symbols = SharedCache::ParseExportTrie(vm->MappingAtAddress(header.linkeditSegment.vmaddr).first.fileAccessor->lock(), header);
+		auto symbols = exportSymbols ? std::move(*exportSymbols) : SharedCache::ParseExportTrie(vm->MappingAtAddress(header.linkeditSegment.vmaddr).first.fileAccessor->lock(), header);
 		std::vector<std::pair<uint64_t, std::pair<BNSymbolType, std::string>>> exportMapping;
 		for (const auto& symbol : symbols)
 		{
@@ -2676,6 +2864,7 @@ void SharedCache::InitializeHeader(
 				view->DefineAutoSymbol(symbol);
 		}
 		m_exportInfos[header.textBase] = exportMapping;
+		m_persistedExportInfos.erase(header.textBase);
 	}
 	view->EndBulkModifySymbols();
 
@@ -2685,96 +2874,48 @@ void SharedCache::InitializeHeader(
 	}
 }
 
-struct ExportNode
-{
-	std::string text;
-	uint64_t offset;
-	uint64_t flags;
-};
-
-
-void SharedCache::ReadExportNode(std::vector<Ref<Symbol>>& symbolList, SharedCacheMachOHeader& header, DataBuffer& buffer, uint64_t textBase,
-	const std::string& currentText, size_t cursor, uint32_t endGuard)
+std::vector<Ref<Symbol>> SharedCache::ParseExportTrie(std::shared_ptr<MMappedFileAccessor> linkeditFile, SharedCacheMachOHeader header)
 {
-
-	if (cursor > endGuard)
-		throw ReadException();
-
-	uint64_t terminalSize = readValidULEB128(buffer, cursor);
-	uint64_t childOffset = cursor + terminalSize;
-	if (terminalSize != 0) {
-		uint64_t imageOffset = 0;
-		uint64_t flags = readValidULEB128(buffer, cursor);
-		if (!(flags & EXPORT_SYMBOL_FLAGS_REEXPORT))
-		{
-			imageOffset = readValidULEB128(buffer, cursor);
-			auto symbolType = m_dscView->GetAnalysisFunctionsForAddress(textBase + imageOffset).size() ? FunctionSymbol : DataSymbol;
-			{
-				if (!currentText.empty() && textBase + imageOffset)
-				{
-					uint32_t flags;
-					BNSymbolType type;
-					for (auto s : header.sections)
-					{
-						if (s.addr < textBase + imageOffset)
-						{
-							if (s.addr + s.size > textBase + imageOffset)
-							{
-								flags = s.flags;
-							}
-						}
-					}
-					if ((flags & S_ATTR_PURE_INSTRUCTIONS) == S_ATTR_PURE_INSTRUCTIONS
-						|| (flags & S_ATTR_SOME_INSTRUCTIONS) == S_ATTR_SOME_INSTRUCTIONS)
-						type = FunctionSymbol;
-					else
-						type = DataSymbol;
-
-#if EXPORT_TRIE_DEBUG
-						// BNLogInfo("export: %s -> 0x%llx", n.text.c_str(), image.baseAddress + n.offset);
-#endif
-					auto sym = new Symbol(type, currentText, textBase + imageOffset);
-					symbolList.push_back(sym);
-				}
-			}
-		}
+	std::vector<ExportTrieEntry> exports;
+	try
+	{
+		// Parse the trie in place rather than copying it out of the mapping
+		auto buffer = linkeditFile->ReadSpan(header.exportTrie.dataoff, header.exportTrie.datasize);
+		ReadExportTrie(buffer.data(), buffer.size(), exports);
 	}
-	cursor = childOffset;
-	uint8_t childCount = buffer[cursor];
-	cursor++;
-	if (cursor > endGuard)
-		throw ReadException();
-	for (uint8_t i = 0; i < childCount; ++i)
+	catch (std::exception& e)
 	{
-		std::string childText;
-		while (buffer[cursor] != 0 & cursor <= endGuard)
-			childText.push_back(buffer[cursor++]);
-		cursor++;
-		if (cursor > endGuard)
-			throw ReadException();
-		auto next = readValidULEB128(buffer, cursor);
-		if (next == 0)
-			throw ReadException();
-		ReadExportNode(symbolList, header, buffer, textBase, currentText + childText, next, endGuard);
+		BNLogError("Failed to load Export Trie");
 	}
-}
-
 
-std::vector<Ref<Symbol>> SharedCache::ParseExportTrie(std::shared_ptr<MMappedFileAccessor> linkeditFile, SharedCacheMachOHeader header)
-{
 	std::vector<Ref<Symbol>> symbols;
-	try
+	symbols.reserve(exports.size());
+	for (auto& entry : exports)
 	{
-		auto reader = linkeditFile;
+		uint64_t addr = header.textBase + entry.offset;
+		if (entry.name.empty() || !addr)
+			continue;
 
-		std::vector<ExportNode> nodes;
+		uint32_t flags = 0;
+		for (const auto& s : header.sections)
+		{
+			if (s.addr <= addr && addr < s.addr + s.size)
+			{
+				flags = s.flags;
+				break;
+			}
+		}
+		BNSymbolType type;
+		if ((flags & S_ATTR_PURE_INSTRUCTIONS) == S_ATTR_PURE_INSTRUCTIONS
+			|| (flags & S_ATTR_SOME_INSTRUCTIONS) == S_ATTR_SOME_INSTRUCTIONS)
+			type = FunctionSymbol;
+		else
+			type = DataSymbol;
 
-		DataBuffer buffer = reader->ReadBuffer(header.exportTrie.dataoff, header.exportTrie.datasize);
-		ReadExportNode(symbols, header, buffer, header.textBase, "", 0, header.exportTrie.datasize);
-	}
-	catch (std::exception& e)
-	{
-		BNLogError("Failed to load Export Trie");
+#if EXPORT_TRIE_DEBUG
+		// BNLogInfo("export: %s -> 0x%llx", entry.name.c_str(), addr);
+#endif
+		symbols.push_back(new Symbol(type, entry.name, addr));
 	}
 	return symbols;
 }
@@ -2815,6 +2956,7 @@ std::vector<std::pair<std::string, Ref<Symbol>>> SharedCache::LoadAllSymbolsAndW
 			symbols.push_back({img.installName, sym});
 		}
 		m_exportInfos[header->textBase] = exportMapping;
+		m_persistedExportInfos.erase(header->textBase);
 	}
 
 	SaveToDSCView();
@@ -2934,6 +3076,7 @@ void SharedCache::FindSymbolAtAddrAndApplyToAddr(uint64_t symbolLocation, uint64
 		{
 			std::unique_lock<std::mutex> _lock(viewSpecificMutexes[m_dscView->GetFile()->GetSessionId()].viewOperationsThatInfluenceMetadataMutex);
 			m_exportInfos[header->textBase] = exportMapping;
+			m_persistedExportInfos.erase(header->textBase);
 		}
 		m_dscView->EndBulkModifySymbols();
 		m_dscView->ForgetUndoActions(id);
@@ -2941,13 +3084,230 @@ void SharedCache::FindSymbolAtAddrAndApplyToAddr(uint64_t symbolLocation, uint64
 }
 
 
+static void WriteBinaryStateHeader(BinaryStateWriter& writer)
+{
+	writer.Write(SharedCacheBinaryStateVersion);
+	writer.Write((uint32_t)METADATA_VERSION);
+}
+
+
+static bool ReadBinaryStateHeader(BinaryStateReader& reader)
+{
+	uint32_t binaryVersion;
+	uint32_t metadataVersion;
+	reader.Read(binaryVersion);
+	reader.Read(metadataVersion);
+	return binaryVersion == SharedCacheBinaryStateVersion && metadataVersion == METADATA_VERSION;
+}
+
+
+static std::string BinaryStateTagForImage(const std::string& prefix, uint64_t textBase)
+{
+	return prefix + to_hex_string(textBase);
+}
+
+
+static void StoreBinaryState(Ref<BinaryView> dscView, const std::string& key, const BinaryStateWriter& writer)
+{
+	Ref<Metadata> data = new Metadata(writer.GetData());
+	dscView->StoreMetadata(key, data);
+	dscView->GetParentView()->GetParentView()->StoreMetadata(key, data);
+}
+
+
+static void ApplyMappedRegions(std::vector<MemoryRegion>& regions, const std::unordered_map<uint64_t, uint64_t>& mapped)
+{
+	for (auto& region : regions)
+	{
+		if (auto it = mapped.find(region.start); it != mapped.end())
+		{
+			region.loaded = true;
+			region.rawViewOffsetIfLoaded = it->second;
+		}
+	}
+}
+
+
+bool SharedCache::DeserializeFromBinaryState()
+{
+	auto layoutData = m_dscView->QueryMetadata(SharedCacheLayoutMetadataTag);
+	auto stateData = m_dscView->QueryMetadata(SharedCacheStateMetadataTag);
+	if (!layoutData || !stateData || !layoutData->IsRaw() || !stateData->IsRaw())
+		return false;
+
+	try
+	{
+		auto layout = layoutData->GetRaw();
+		BinaryStateReader layoutReader(layout.data(), layout.size());
+		if (!ReadBinaryStateHeader(layoutReader))
+		{
+			m_logger->LogError("Shared Cache binary state version mismatch");
+			return false;
+		}
+		layoutReader.Read(m_imageStarts);
+		uint8_t cacheFormat;
+		layoutReader.Read(cacheFormat);
+		m_cacheFormat = (SharedCacheFormat)cacheFormat;
+		layoutReader.Read(m_baseFilePath);
+		layoutReader.Read(m_headers);
+		layoutReader.Read(m_backingCaches);
+		layoutReader.Read(m_images);
+		layoutReader.Read(m_stubIslandRegions);
+		layoutReader.Read(m_dyldDataRegions);
+		layoutReader.Read(m_nonImageRegions);
+
+		auto state = stateData->GetRaw();
+		BinaryStateReader stateReader(state.data(), state.size());
+		if (!ReadBinaryStateHeader(stateReader))
+		{
+			m_logger->LogError("Shared Cache binary state version mismatch");
+			return false;
+		}
+		uint8_t viewState;
+		stateReader.Read(viewState);
+		m_viewState = (DSCViewState)viewState;
+		stateReader.Read(m_regionsMappedIntoMemory);
+		std::vector<uint64_t> exportInfoBases;
+		std::vector<uint64_t> symbolInfoBases;
+		stateReader.Read(exportInfoBases);
+		stateReader.Read(symbolInfoBases);
+
+		// The layout holds regions as they were when it was first written; the mapped region list is authoritative
+		std::unordered_map<uint64_t, uint64_t> mapped;
+		for (const auto& region : m_regionsMappedIntoMemory)
+			mapped[region.start] = region.rawViewOffsetIfLoaded;
+		for (auto& image : m_images)
+			ApplyMappedRegions(image.regions, mapped);
+		ApplyMappedRegions(m_stubIslandRegions, mapped);
+		ApplyMappedRegions(m_dyldDataRegions, mapped);
+		ApplyMappedRegions(m_nonImageRegions, mapped);
+
+		m_exportInfos.clear();
+		m_persistedExportInfos.clear();
+		for (auto base : exportInfoBases)
+		{
+			auto raw = m_dscView->GetRawMetadata(BinaryStateTagForImage(SharedCacheExportsMetadataTagPrefix, base));
+			BinaryStateReader reader(raw.data(), raw.size());
+			reader.Read(m_exportInfos[base]);
+			m_persistedExportInfos.insert(base);
+		}
+		m_symbolInfos.clear();
+		m_persistedSymbolInfos.clear();
+		for (auto base : symbolInfoBases)
+		{
+			auto raw = m_dscView->GetRawMetadata(BinaryStateTagForImage(SharedCacheSymbolsMetadataTagPrefix, base));
+			BinaryStateReader reader(raw.data(), raw.size());
+			reader.Read(m_symbolInfos[base]);
+			m_persistedSymbolInfos.insert(base);
+		}
+	}
+	catch (std::exception& e)
+	{
+		m_logger->LogError("Failed to read Shared Cache binary state: %s", e.what());
+		return false;
+	}
+
+	m_layoutPersisted = true;
+	m_metadataValid = true;
+	return true;
+}
+
+
+bool SharedCache::ReadPersistedViewState(Ref<BinaryView> view, std::vector<MemoryRegion>& regionsMappedIntoMemory,
+	std::unordered_map<std::string, uint64_t>& imageStarts,
+	std::unordered_map<uint64_t, std::vector<std::pair<uint64_t, std::pair<BNSymbolType, std::string>>>>& exportInfos)
+{
+	auto layoutData = view->QueryMetadata(SharedCacheLayoutMetadataTag);
+	auto stateData = view->QueryMetadata(SharedCacheStateMetadataTag);
+	if (!layoutData || !stateData || !layoutData->IsRaw() || !stateData->IsRaw())
+		return false;
+
+	try
+	{
+		// Image starts are the first thing in the layout, so we don't need to decode the rest of it
+		auto layout = layoutData->GetRaw();
+		BinaryStateReader layoutReader(layout.data(), layout.size());
+		if (!ReadBinaryStateHeader(layoutReader))
+			return false;
+		layoutReader.Read(imageStarts);
+
+		auto state = stateData->GetRaw();
+		BinaryStateReader stateReader(state.data(), state.size());
+		if (!ReadBinaryStateHeader(stateReader))
+			return false;
+		uint8_t viewState;
+		stateReader.Read(viewState);
+		stateReader.Read(regionsMappedIntoMemory);
+		std::vector<uint64_t> exportInfoBases;
+		stateReader.Read(exportInfoBases);
+
+		for (auto base : exportInfoBases)
+		{
+			auto raw = view->GetRawMetadata(BinaryStateTagForImage(SharedCacheExportsMetadataTagPrefix, base));
+			BinaryStateReader reader(raw.data(), raw.size());
+			reader.Read(exportInfos[base]);
+		}
+	}
+	catch (std::exception& e)
+	{
+		LogError("Failed to read Shared Cache binary state: %s", e.what());
+		return false;
+	}
+	return true;
+}
+
+
 bool SharedCache::SaveToDSCView()
 {
 	if (m_dscView)
 	{
-		auto data = AsMetadata();
-		m_dscView->StoreMetadata(SharedCacheMetadataTag, data);
-		m_dscView->GetParentView()->GetParentView()->StoreMetadata(SharedCacheMetadataTag, data);
+		// The layout never changes after the initial load, so it is only written once
+		if (!m_layoutPersisted)
+		{
+			BinaryStateWriter layout;
+			WriteBinaryStateHeader(layout);
+			layout.Write(m_imageStarts);
+			layout.Write((uint8_t)m_cacheFormat);
+			layout.Write(m_baseFilePath);
+			layout.Write(m_headers);
+			layout.Write(m_backingCaches);
+			layout.Write(m_images);
+			layout.Write(m_stubIslandRegions);
+			layout.Write(m_dyldDataRegions);
+			layout.Write(m_nonImageRegions);
+			StoreBinaryState(m_dscView, SharedCacheLayoutMetadataTag, layout);
+			m_layoutPersisted = true;
+		}
+
+		// Export and symbol lists are one key per image. Replacing an image's list drops it from the persisted set,
+		// so it is rewritten here.
+		for (const auto& [base, exports] : m_exportInfos)
+		{
+			if (m_persistedExportInfos.count(base))
+				continue;
+			BinaryStateWriter writer;
+			writer.Write(exports);
+			StoreBinaryState(m_dscView, BinaryStateTagForImage(SharedCacheExportsMetadataTagPrefix, base), writer);
+			m_persistedExportInfos.insert(base);
+		}
+		for (const auto& [base, symbols] : m_symbolInfos)
+		{
+			if (m_persistedSymbolInfos.count(base))
+				continue;
+			BinaryStateWriter writer;
+			writer.Write(symbols);
+			StoreBinaryState(m_dscView, BinaryStateTagForImage(SharedCacheSymbolsMetadataTagPrefix, base), writer);
+			m_persistedSymbolInfos.insert(base);
+		}
+
+		BinaryStateWriter state;
+		WriteBinaryStateHeader(state);
+		state.Write((uint8_t)m_viewState);
+		state.Write(m_regionsMappedIntoMemory);
+		state.Write(std::vector<uint64_t>(m_persistedExportInfos.begin(), m_persistedExportInfos.end()));
+		state.Write(std::vector<uint64_t>(m_persistedSymbolInfos.begin(), m_persistedSymbolInfos.end()));
+		StoreBinaryState(m_dscView, SharedCacheStateMetadataTag, state);
+
 		std::unique_lock<std::recursive_mutex> viewStateCacheLock(viewStateMutex);
 		ViewStateCacheStore c;
 		c.m_imageStarts = m_imageStarts;
@@ -2963,6 +3323,9 @@ bool SharedCache::SaveToDSCView()
 		c.m_baseFilePath = m_baseFilePath;
 		c.m_exportInfos = m_exportInfos;
 		c.m_symbolInfos = m_symbolInfos;
+		c.m_layoutPersisted = m_layoutPersisted;
+		c.m_persistedExportInfos = m_persistedExportInfos;
+		c.m_persistedSymbolInfos = m_persistedSymbolInfos;
 		viewStateCache[m_dscView->GetFile()->GetSessionId()] = c;
 
 		m_metadataValid = true;
@@ -3022,6 +3385,19 @@ extern "C"
 		return false;
 	}
 
+	bool BNDSCViewLoadImagesWithInstallNames(BNSharedCache* cache, char** names, size_t count)
+	{
+		std::vector<std::string> imageNames;
+		imageNames.reserve(count);
+		for (size_t i = 0; i < count; i++)
+			imageNames.emplace_back(names[i]);
+
+		if (cache->object)
+			return cache->object->LoadImagesWithInstallNames(imageNames);
+
+		return false;
+	}
+
 	bool BNDSCViewLoadSectionAtAddress(BNSharedCache* cache, uint64_t addr)
 	{
 		if (cache->object)
@@ -3285,6 +3661,17 @@ extern "C"
 		return info;
 	}
 
+	BNDSCFileAccessorCacheStats BNDSCViewGetFileAccessorCacheStats()
+	{
+		BNDSCFileAccessorCacheStats stats;
+		auto accessorStats = MMappedFileAccessor::GetCacheStats();
+		stats.hits = accessorStats.hits;
+		stats.misses = accessorStats.misses;
+		stats.evictions = accessorStats.evictions;
+		stats.remaps = accessorStats.remaps;
+		return stats;
+	}
+
 	BNDSCViewLoadProgress BNDSCViewGetLoadProgress(uint64_t sessionID)
 	{
 		progressMutex.lock();
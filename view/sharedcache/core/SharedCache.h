@@ -8,12 +8,152 @@
 #include "view/macho/machoview.h"
 #include "MetadataSerializable.hpp"
 #include "../api/sharedcachecore.h"
+#include <unordered_set>
 
 #ifndef SHAREDCACHE_SHAREDCACHE_H
 #define SHAREDCACHE_SHAREDCACHE_H
 
 DECLARE_SHAREDCACHE_API_OBJECT(BNSharedCache, SharedCache);
 
+// Fields of the Mach-O structures kept in the binary view state, in declaration order. These live next to the
+// structures so BinaryStateWriter/BinaryStateReader find them by argument dependent lookup.
+namespace BinaryNinja {
+	template <typename F>
+	void ForEachBinaryStateField(mach_header_64& v, F&& f)
+	{
+		f(v.magic);
+		f(v.cputype);
+		f(v.cpusubtype);
+		f(v.filetype);
+		f(v.ncmds);
+		f(v.sizeofcmds);
+		f(v.flags);
+		f(v.reserved);
+	}
+
+	template <typename F>
+	void ForEachBinaryStateField(symtab_command& v, F&& f)
+	{
+		f(v.cmd);
+		f(v.cmdsize);
+		f(v.symoff);
+		f(v.nsyms);
+		f(v.stroff);
+		f(v.strsize);
+	}
+
+	template <typename F>
+	void ForEachBinaryStateField(dysymtab_command& v, F&& f)
+	{
+		f(v.cmd);
+		f(v.cmdsize);
+		f(v.ilocalsym);
+		f(v.nlocalsym);
+		f(v.iextdefsym);
+		f(v.nextdefsym);
+		f(v.iundefsym);
+		f(v.nundefsym);
+		f(v.tocoff);
+		f(v.ntoc);
+		f(v.modtaboff);
+		f(v.nmodtab);
+		f(v.extrefsymoff);
+		f(v.nextrefsyms);
+		f(v.indirectsymoff);
+		f(v.nindirectsyms);
+		f(v.extreloff);
+		f(v.nextrel);
+		f(v.locreloff);
+		f(v.nlocrel);
+	}
+
+	template <typename F>
+	void ForEachBinaryStateField(dyld_info_command& v, F&& f)
+	{
+		f(v.cmd);
+		f(v.cmdsize);
+		f(v.rebase_off);
+		f(v.rebase_size);
+		f(v.bind_off);
+		f(v.bind_size);
+		f(v.weak_bind_off);
+		f(v.weak_bind_size);
+		f(v.lazy_bind_off);
+		f(v.lazy_bind_size);
+		f(v.export_off);
+		f(v.export_size);
+	}
+
+	template <typename F>
+	void ForEachBinaryStateField(linkedit_data_command& v, F&& f)
+	{
+		f(v.cmd);
+		f(v.cmdsize);
+		f(v.dataoff);
+		f(v.datasize);
+	}
+
+	template <typename F>
+	void ForEachBinaryStateField(function_starts_command& v, F&& f)
+	{
+		f(v.cmd);
+		f(v.cmdsize);
+		f(v.funcoff);
+		f(v.funcsize);
+	}
+
+	template <typename F>
+	void ForEachBinaryStateField(segment_command_64& v, F&& f)
+	{
+		f(v.cmd);
+		f(v.cmdsize);
+		f(v.segname);
+		f(v.vmaddr);
+		f(v.vmsize);
+		f(v.fileoff);
+		f(v.filesize);
+		f(v.maxprot);
+		f(v.initprot);
+		f(v.nsects);
+		f(v.flags);
+	}
+
+	template <typename F>
+	void ForEachBinaryStateField(section_64& v, F&& f)
+	{
+		f(v.sectname);
+		f(v.segname);
+		f(v.addr);
+		f(v.size);
+		f(v.offset);
+		f(v.align);
+		f(v.reloff);
+		f(v.nreloc);
+		f(v.flags);
+		f(v.reserved1);
+		f(v.reserved2);
+		f(v.reserved3);
+	}
+
+	template <typename F>
+	void ForEachBinaryStateField(build_version_command& v, F&& f)
+	{
+		f(v.cmd);
+		f(v.cmdsize);
+		f(v.platform);
+		f(v.minos);
+		f(v.sdk);
+		f(v.ntools);
+	}
+
+	template <typename F>
+	void ForEachBinaryStateField(build_tool_version& v, F&& f)
+	{
+		f(v.tool);
+		f(v.version);
+	}
+}  // namespace BinaryNinja
+
 namespace SharedCacheCore {
 
 	enum DSCViewState
@@ -24,7 +164,17 @@ namespace SharedCacheCore {
 	};
 
 
+	// Legacy JSON form of the view state. Only read now, as a fallback for databases saved before the binary form.
 	const std::string SharedCacheMetadataTag = "SHAREDCACHE-SharedCacheData";
+	// Binary form of the view state, split so that loading an image only rewrites what changed:
+	// the layout (headers, images, backing caches) is written once after the initial load, the state
+	// (view state, mapped regions) on every save, and per-image export/symbol lists whenever they change.
+	const std::string SharedCacheLayoutMetadataTag = "SHAREDCACHE-SharedCacheLayout";
+	const std::string SharedCacheStateMetadataTag = "SHAREDCACHE-SharedCacheState";
+	const std::string SharedCacheExportsMetadataTagPrefix = "SHAREDCACHE-SharedCacheExports-";
+	const std::string SharedCacheSymbolsMetadataTagPrefix = "SHAREDCACHE-SharedCacheSymbols-";
+	// Bump when the binary encoding changes in a way the reader can't handle.
+	constexpr uint32_t SharedCacheBinaryStateVersion = 1;
 
 	struct MemoryRegion : public MetadataSerializable
 	{
@@ -67,6 +217,11 @@ namespace SharedCacheCore {
 		{
 			MSS(installName);
 			MSS(headerLocation);
+			if (m_binaryWriter)
+			{
+				m_binaryWriter->Write(regions);
+				return;
+			}
 			rapidjson::Value key("regions", m_activeContext.allocator);
 			rapidjson::Value bArr(rapidjson::kArrayType);
 			for (auto& region : regions)
@@ -80,6 +235,11 @@ namespace SharedCacheCore {
 		{
 			MSL(installName);
 			MSL(headerLocation);
+			if (m_binaryReader)
+			{
+				m_binaryReader->Read(regions);
+				return;
+			}
 			auto bArr = m_activeDeserContext.doc["regions"].GetArray();
 			regions.clear();
 			for (auto& region : bArr)
@@ -884,7 +1044,9 @@ namespace SharedCacheCore {
 			MSL(dyldInfoPresent);
 			MSL(exportTriePresent);
 			MSL(chainedFixupsPresent);
-			// MSL(routinesPresent);
+			// Older JSON metadata was saved without this
+			if (m_binaryReader || m_activeDeserContext.doc.HasMember("routinesPresent"))
+				MSL(routinesPresent);
 			MSL(functionStartsPresent);
 			MSL(relocatable);
 		}
@@ -893,7 +1055,6 @@ namespace SharedCacheCore {
 
 	struct MappingInfo
 	{
-		std::shared_ptr<MMappedFileAccessor> file;
 		dyld_cache_mapping_info mappingInfo;
 		uint32_t slideInfoVersion;
 		dyld_cache_slide_info_v2 slideInfoV2;
@@ -1141,6 +1302,11 @@ namespace SharedCacheCore {
 
 		/* VIEWSTATE END -- NOTHING PAST THIS IS SERIALIZED */
 
+		// What of the above has already been written out in binary form, so saves only write what is new or changed.
+		bool m_layoutPersisted = false;
+		std::unordered_set<uint64_t> m_persistedExportInfos;
+		std::unordered_set<uint64_t> m_persistedSymbolInfos;
+
 		/* API VIEW START */
 		BinaryNinja::Ref<BinaryNinja::BinaryView> m_dscView;
 		/* API VIEW END */
@@ -1148,6 +1314,11 @@ namespace SharedCacheCore {
 	private:
 		void PerformInitialLoad();
 		void DeserializeFromRawView();
+		bool DeserializeFromBinaryState();
+		void ClearViewState();
+		std::vector<MemoryRegion*> MapImageRegions(std::shared_ptr<VM> vm, CacheImage& image, Ref<Settings> settings);
+		void AddTypeLibraryForImage(const SharedCacheMachOHeader& header);
+		void ProcessObjCForImage(std::shared_ptr<VM> vm, const SharedCacheMachOHeader& header, Ref<Settings> settings);
 
 	public:
 		std::shared_ptr<VM> GetVMMap(bool mapPages = true);
@@ -1157,9 +1328,17 @@ namespace SharedCacheCore {
 		bool SaveToDSCView();
 
 		void ParseAndApplySlideInfoForFile(std::shared_ptr<MMappedFileAccessor> file);
+		static void ForgetSlideInfo(uint64_t sessionID);
 		std::optional<uint64_t> GetImageStart(std::string installName);
 		std::optional<SharedCacheMachOHeader> HeaderForAddress(uint64_t);
 		bool LoadImageWithInstallName(std::string installName);
+		/**
+		 * Load several images at once. Headers and export tries are parsed concurrently, then the view
+		 * is updated image by image and the view state is saved once at the end.
+		 *
+		 * \return true if every requested image was loaded
+		 */
+		bool LoadImagesWithInstallNames(std::vector<std::string> installNames);
 		bool LoadSectionAtAddress(uint64_t address);
 		bool LoadImageContainingAddress(uint64_t address);
 		std::string NameForAddress(uint64_t address);
@@ -1168,6 +1347,16 @@ namespace SharedCacheCore {
 
 		std::vector<MemoryRegion> GetMappedRegions() const;
 
+		/**
+		 * Read the mapped regions, image starts and export lists from the binary view state stored on `view`.
+		 *
+		 * Used by DSCView to restore a view from a database without a SharedCache object.
+		 * \return false if `view` has no (readable) binary state
+		 */
+		static bool ReadPersistedViewState(Ref<BinaryView> view, std::vector<MemoryRegion>& regionsMappedIntoMemory,
+			std::unordered_map<std::string, uint64_t>& imageStarts,
+			std::unordered_map<uint64_t, std::vector<std::pair<uint64_t, std::pair<BNSymbolType, std::string>>>>& exportInfos);
+
 		std::vector<std::pair<std::string, Ref<Symbol>>> LoadAllSymbolsAndWait();
 
 		std::unordered_map<std::string, uint64_t> AllImageStarts() const { return m_imageStarts; }
@@ -1190,10 +1379,8 @@ namespace SharedCacheCore {
 
 		std::optional<SharedCacheMachOHeader> LoadHeaderForAddress(
 			std::shared_ptr<VM> vm, uint64_t address, std::string installName);
-		void InitializeHeader(
-			Ref<BinaryView> view, VM* vm, SharedCacheMachOHeader header, std::vector<MemoryRegion*> regionsToLoad);
-		void ReadExportNode(std::vector<Ref<Symbol>>& symbolList, SharedCacheMachOHeader& header, DataBuffer& buffer, uint64_t textBase,
-			const std::string& currentText, size_t cursor, uint32_t endGuard);
+		void InitializeHeader(Ref<BinaryView> view, VM* vm, SharedCacheMachOHeader header,
+			std::vector<MemoryRegion*> regionsToLoad, std::optional<std::vector<Ref<Symbol>>> exportSymbols = std::nullopt);
 		std::vector<Ref<Symbol>> ParseExportTrie(
 			std::shared_ptr<MMappedFileAccessor> linkeditFile, SharedCacheMachOHeader header);
 	};
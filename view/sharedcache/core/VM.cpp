@@ -19,13 +19,19 @@
 			- As soon as that lock is released, that file pointer MAY be freed if another thread wants to open a new one, and we are at our limit.
 			- Calling .lock() again on this same theoretical object will then wait for another file pointer to be freeable.
 
+		The SelfAllocatingWeakPtr for each path lives in a map split into stripes by path hash, so concurrent lookups of
+		different files don't contend on one lock. We hold a reference to every open mapping on behalf of the session that
+		opened it; when we run out of file pointers the least recently accessed of those is dropped first.
+
 	VM Implementation:
 
 
  	Since the caches we're operating on are by nature page aligned, we are able to use nice optimizations under the hood to translate
  	"VM Addresses" to their actual in-memory counterparts.
 
- 	We do this with a page table, which is a map of page -> file offset.
+ 	We do this with a sorted list of mapped ranges (address range -> file + file offset), one per cache mapping.
+	Lookups are a binary search, and VMReader remembers the range it last resolved so that sequential reads within a
+	mapping are just pointer arithmetic on the memory mapped file, only re-resolving when crossing a range boundary.
 
  	We also implement a "VMReader" here, which is a drop-in replacement for BinaryReader that operates on the VM.
  		see "ObjC.cpp" for where this is used.
@@ -37,6 +43,12 @@
 #include <utility>
 #include <memory>
 #include <cstring>
+#include <cinttypes>
+#include <optional>
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <unordered_set>
 #include <stdio.h>
 #include <filesystem>
 #include <binaryninjaapi.h>
@@ -50,15 +62,58 @@
 	#include <sys/resource.h>
 #endif
 
-void VMShutdown()
+std::atomic<uint64_t> mmapCount = 0;
+
+static uint64_t maxFPLimit;
+static counting_semaphore fileAccessorSemaphore(0);
+
+static constexpr size_t FileAccessorStripeCount = 16;
+
+struct FileAccessorStripe
 {
-	std::unique_lock<std::mutex> lock2(fileAccessorsMutex);
-	std::unique_lock<std::mutex> lock(fileAccessorDequeMutex);
+	std::mutex mutex;
+	std::unordered_map<std::string, std::shared_ptr<SelfAllocatingWeakPtr<MMappedFileAccessor>>> accessors;
+};
+static FileAccessorStripe fileAccessorStripes[FileAccessorStripeCount];
 
+static FileAccessorStripe& FileAccessorStripeForPath(const std::string& path)
+{
+	return fileAccessorStripes[std::hash<std::string> {}(path) % FileAccessorStripeCount];
+}
+
+// References we keep alive for each session so mappings outlive individual reads. These are what gets evicted.
+struct HeldFileAccessor
+{
+	uint64_t sessionID;
+	std::shared_ptr<MMappedFileAccessor> accessor;
+};
+static std::mutex heldFileAccessorsMutex;
+static std::vector<HeldFileAccessor> heldFileAccessors;
+static std::set<uint64_t> blockedSessionIDs;
+static std::unordered_set<std::string> previouslyMappedPaths;
+
+static std::atomic<uint64_t> fileAccessClock = 0;
+static std::atomic<uint64_t> fileAccessorHits = 0;
+static std::atomic<uint64_t> fileAccessorMisses = 0;
+static std::atomic<uint64_t> fileAccessorEvictions = 0;
+static std::atomic<uint64_t> fileAccessorRemaps = 0;
+
+
+void VMShutdown()
+{
+	std::vector<HeldFileAccessor> held;
+	{
+		std::unique_lock<std::mutex> lock(heldFileAccessorsMutex);
+		held.swap(heldFileAccessors);
+	}
 	// This will trigger the deallocation logic for these.
 	// It is background threaded to avoid a deadlock on exit.
-	fileAccessorReferenceHolder.clear();
-	fileAccessors.clear();
+	held.clear();
+	for (auto& stripe : fileAccessorStripes)
+	{
+		std::unique_lock<std::mutex> lock(stripe.mutex);
+		stripe.accessors.clear();
+	}
 }
 
 
@@ -203,64 +258,124 @@ void MMAP::Unmap()
 }
 
 
+// Get a slot in the file pointer budget. When the budget is used up, the least recently used held mapping that isn't
+// in use elsewhere is dropped and its slot is handed over directly, since mappings are only released later on a worker
+// thread. Returns false if every held mapping is still in use, in which case we go over budget rather than block.
+static bool AcquireFileSlot()
+{
+	if (fileAccessorSemaphore.try_acquire())
+		return true;
+
+	// Hold on to evicted mappings until we're out of the lock, the destructor doesn't run here anyway.
+	std::vector<std::shared_ptr<MMappedFileAccessor>> evicted;
+	std::unique_lock<std::mutex> lock(heldFileAccessorsMutex);
+	while (true)
+	{
+		// Evicting a mapping that's in use wouldn't free its file pointer, so those are left alone.
+		auto lru = heldFileAccessors.end();
+		for (auto it = heldFileAccessors.begin(); it != heldFileAccessors.end(); ++it)
+		{
+			if (it->accessor.use_count() > 1)
+				continue;
+			if (lru == heldFileAccessors.end() || it->accessor->LastAccess() < lru->accessor->LastAccess())
+				lru = it;
+		}
+		if (lru == heldFileAccessors.end())
+			return false;
+
+		evicted.push_back(std::move(lru->accessor));
+		*lru = std::move(heldFileAccessors.back());
+		heldFileAccessors.pop_back();
+		fileAccessorEvictions++;
+		if (evicted.back()->TakeFileSlot())
+			return true;
+		// That mapping was itself over budget, so it had no slot to hand over. One may have been released meanwhile.
+		if (fileAccessorSemaphore.try_acquire())
+			return true;
+	}
+}
+
+
 std::shared_ptr<SelfAllocatingWeakPtr<MMappedFileAccessor>> MMappedFileAccessor::Open(BinaryNinja::Ref<BinaryNinja::BinaryView> dscView, const uint64_t sessionID, const std::string &path, std::function<void(std::shared_ptr<MMappedFileAccessor>)> postAllocationRoutine)
 {
-	std::scoped_lock<std::mutex> lock(fileAccessorsMutex);
-	if (fileAccessors.count(path) == 0)
-	{
-		auto fileAcccessor = std::shared_ptr<SelfAllocatingWeakPtr<MMappedFileAccessor>>(new SelfAllocatingWeakPtr<MMappedFileAccessor>(
-			// Allocator logic for the SelfAllocatingWeakPtr
-			[path=path, sessionID=sessionID, dscView](){
-				std::unique_lock<std::mutex> _lock(fileAccessorDequeMutex);
-
-				// Iterate through held references and start removing them until we can get a file pointer
-				// FIXME: This could clear all currently used file pointers and still not get one. FIX!
-				// 		We should probably use a condition variable here to wait for a file pointer to be released!!!
-				for (auto& [_, fileAccessorDeque] : fileAccessorReferenceHolder)
-				{
-					if (fileAccessorSemaphore.try_acquire())
-						break;
-					fileAccessorDeque.pop_front();
-				}
-
-				mmapCount++;
-				_lock.unlock();
-				auto accessor = std::shared_ptr<MMappedFileAccessor>(new MMappedFileAccessor(ResolveFilePath(dscView, path)), [](MMappedFileAccessor* accessor){
-					// worker thread or we can deadlock on exit here.
-					BinaryNinja::WorkerEnqueue([accessor](){
+	auto& stripe = FileAccessorStripeForPath(path);
+	std::scoped_lock<std::mutex> lock(stripe.mutex);
+	if (auto it = stripe.accessors.find(path); it != stripe.accessors.end())
+	{
+		fileAccessorHits++;
+		return it->second;
+	}
+
+	fileAccessorMisses++;
+	auto fileAcccessor = std::shared_ptr<SelfAllocatingWeakPtr<MMappedFileAccessor>>(new SelfAllocatingWeakPtr<MMappedFileAccessor>(
+		// Allocator logic for the SelfAllocatingWeakPtr
+		[path=path, sessionID=sessionID, dscView](){
+			bool holdsFileSlot = AcquireFileSlot();
+
+			mmapCount++;
+			auto accessor = std::shared_ptr<MMappedFileAccessor>(new MMappedFileAccessor(ResolveFilePath(dscView, path)), [](MMappedFileAccessor* accessor){
+				// worker thread or we can deadlock on exit here.
+				BinaryNinja::WorkerEnqueue([accessor](){
+					if (accessor->m_holdsFileSlot)
 						fileAccessorSemaphore.release();
-						mmapCount--;
-						if (fileAccessors.count(accessor->m_path))
-						{
-							std::scoped_lock<std::mutex> lock(fileAccessorsMutex);
-							fileAccessors.erase(accessor->m_path);
-						}
-						delete accessor;
-					}, "MMappedFileAccessor Destructor");
-				});
-				_lock.lock();
-				// If some background thread has managed to try and open a file when the BV was already closed,
-				// 		we can still give them the file they want so they dont crash, but as soon as they let go it's gone.
-				if (!blockedSessionIDs.count(sessionID))
-					fileAccessorReferenceHolder[sessionID].push_back(accessor);
-				return accessor;
-			},
-			[postAllocationRoutine=postAllocationRoutine](std::shared_ptr<MMappedFileAccessor> accessor){
-				if (postAllocationRoutine)
-					postAllocationRoutine(accessor);
-			}));
-		fileAccessors.insert_or_assign(path, fileAcccessor);
-	}
-	return fileAccessors.at(path);
+					mmapCount--;
+					{
+						auto& stripe = FileAccessorStripeForPath(accessor->m_path);
+						std::scoped_lock<std::mutex> lock(stripe.mutex);
+						stripe.accessors.erase(accessor->m_path);
+					}
+					delete accessor;
+				}, "MMappedFileAccessor Destructor");
+			});
+			accessor->m_holdsFileSlot = holdsFileSlot;
+
+			std::unique_lock<std::mutex> _lock(heldFileAccessorsMutex);
+			if (!previouslyMappedPaths.insert(path).second)
+				fileAccessorRemaps++;
+			// If some background thread has managed to try and open a file when the BV was already closed,
+			// 		we can still give them the file they want so they dont crash, but as soon as they let go it's gone.
+			if (!blockedSessionIDs.count(sessionID))
+				heldFileAccessors.push_back({sessionID, accessor});
+			return accessor;
+		},
+		[postAllocationRoutine=postAllocationRoutine](std::shared_ptr<MMappedFileAccessor> accessor){
+			if (postAllocationRoutine)
+				postAllocationRoutine(accessor);
+		},
+		[](MMappedFileAccessor* accessor){
+			accessor->m_lastAccess.store(++fileAccessClock, std::memory_order_relaxed);
+		}));
+	stripe.accessors.emplace(path, fileAcccessor);
+	return fileAcccessor;
 }
 
 
 void MMappedFileAccessor::CloseAll(const uint64_t sessionID)
 {
-	blockedSessionIDs.insert(sessionID);
-	if (fileAccessorReferenceHolder.count(sessionID) == 0)
-		return;
-	fileAccessorReferenceHolder.erase(sessionID);
+	std::vector<HeldFileAccessor> released;
+	{
+		std::unique_lock<std::mutex> lock(heldFileAccessorsMutex);
+		blockedSessionIDs.insert(sessionID);
+		auto it = std::stable_partition(heldFileAccessors.begin(), heldFileAccessors.end(),
+			[sessionID](const HeldFileAccessor& held) { return held.sessionID != sessionID; });
+		std::move(it, heldFileAccessors.end(), std::back_inserter(released));
+		heldFileAccessors.erase(it, heldFileAccessors.end());
+	}
+
+	auto stats = GetCacheStats();
+	BinaryNinja::LogDebug("Shared Cache file accessors: %" PRIu64 " hits, %" PRIu64 " misses, %" PRIu64
+		" evictions, %" PRIu64 " remaps", stats.hits, stats.misses, stats.evictions, stats.remaps);
+}
+
+
+FileAccessorCacheStats MMappedFileAccessor::GetCacheStats()
+{
+	FileAccessorCacheStats stats;
+	stats.hits = fileAccessorHits.load();
+	stats.misses = fileAccessorMisses.load();
+	stats.evictions = fileAccessorEvictions.load();
+	stats.remaps = fileAccessorRemaps.load();
+	return stats;
 }
 
 
@@ -372,11 +487,6 @@ MMappedFileAccessor::~MMappedFileAccessor()
 #endif
 }
 
-void MMappedFileAccessor::WritePointer(size_t address, size_t pointer)
-{
-	((size_t*)(&((uint8_t*)m_mmap._mmap)[address]))[0] = pointer;
-}
-
 std::string MMappedFileAccessor::ReadNullTermString(size_t address)
 {
 	if (address > m_mmap.len)
@@ -463,6 +573,25 @@ BinaryNinja::DataBuffer MMappedFileAccessor::ReadBuffer(size_t address, size_t l
 	return BinaryNinja::DataBuffer(data, length);
 }
 
+MappedSpan MMappedFileAccessor::ReadSpan(size_t address, size_t length)
+{
+	if (address > m_mmap.len)
+		throw MappingReadException();
+	if (address + length > m_mmap.len)
+		throw MappingReadException();
+	return MappedSpan(shared_from_this(), &(((const uint8_t*)m_mmap._mmap)[address]), length);
+}
+
+MappedStringView MMappedFileAccessor::ReadStringView(size_t address)
+{
+	if (address > m_mmap.len)
+		return {};
+	auto start = &(((const char*)m_mmap._mmap)[address]);
+	auto terminator = (const char*)memchr(start, 0, m_mmap.len - address);
+	size_t length = terminator ? terminator - start : m_mmap.len - address;
+	return MappedStringView(shared_from_this(), std::string_view(start, length));
+}
+
 void MMappedFileAccessor::Read(void* dest, size_t address, size_t length)
 {
 	if (address > m_mmap.len)
@@ -489,61 +618,80 @@ VM::~VM()
 void VM::MapPages(BinaryNinja::Ref<BinaryNinja::BinaryView> dscView, uint64_t sessionID, size_t vm_address, size_t fileoff, size_t size, std::string filePath, std::function<void(std::shared_ptr<MMappedFileAccessor>)> postAllocationRoutine)
 {
 	// The mappings provided for shared caches will always be page aligned.
-	// We can use this to our advantage and gain considerable performance via page tables.
-	// This could probably be sped up if c++ were avoided?
-	// We want to create a map of page -> file offset
+	// We still validate that here, but rather than storing one entry per page, we store the whole mapping
+	// as a single range. A lookup is then a binary search over a few hundred ranges at most, and readers can
+	// walk a range with plain pointer arithmetic.
 
 	if (vm_address % m_pageSize != 0 || size % m_pageSize != 0)
 	{
 		throw MappingPageAlignmentException();
 	}
 
-	size_t pagesRemainingCount = size / m_pageSize;
-	for (size_t i = 0; i < size; i += m_pageSize)
+	if (size == 0)
+		return;
+
+	size_t end = vm_address + size;
+
+	// First range that ends after our start; anything from here that starts before our end overlaps.
+	auto first = std::upper_bound(m_ranges.begin(), m_ranges.end(), vm_address,
+		[](size_t address, const VMMappedRange& range) { return address < range.end; });
+	auto last = first;
+
+	std::optional<VMMappedRange> head;
+	std::optional<VMMappedRange> tail;
+	while (last != m_ranges.end() && last->start < end)
 	{
-		// Our pages will be delimited by shifting off the page size
-		// So, 0x12345000 will become 0x12345 (assuming m_pageSize is 0x1000)
-		auto page = (vm_address + (i)) >> m_pageSizeBits;
-		if (m_map.count(page) != 0)
+		if (m_safe)
 		{
-			if (m_safe)
-			{
-				BNLogWarn("Remapping page 0x%lx (i == 0x%lx) (a: 0x%zx, f: 0x%zx)", page, i, vm_address, fileoff);
-				throw MappingCollisionException();
-			}
+			BNLogWarn("Remapping range 0x%zx-0x%zx (a: 0x%zx, f: 0x%zx)", last->start, last->end, vm_address, fileoff);
+			throw MappingCollisionException();
 		}
-		m_map.insert_or_assign(page, PageMapping(filePath, MMappedFileAccessor::Open(dscView, sessionID, filePath, postAllocationRoutine), i + fileoff));
+
+		// Keep whatever parts of the existing range fall outside of the new one
+		if (last->start < vm_address)
+			head.emplace(last->start, vm_address, last->mapping);
+		if (last->end > end)
+		{
+			PageMapping tailMapping = last->mapping;
+			tailMapping.fileOffset += end - last->start;
+			tail.emplace(end, last->end, tailMapping);
+		}
+		++last;
 	}
+
+	auto it = m_ranges.erase(first, last);
+	if (tail)
+		it = m_ranges.insert(it, std::move(*tail));
+	it = m_ranges.insert(it, VMMappedRange(vm_address, end,
+		PageMapping(filePath, MMappedFileAccessor::Open(dscView, sessionID, filePath, postAllocationRoutine), fileoff)));
+	if (head)
+		m_ranges.insert(it, std::move(*head));
 }
 
-std::pair<PageMapping, size_t> VM::MappingAtAddress(size_t address)
+const VMMappedRange& VM::RangeAtAddress(size_t address) const
 {
-	// Get the page (e.g. 0x12345678 will become 0x12345 on 0x1000 aligned caches)
-	auto page = address >> m_pageSizeBits;
-	if (auto f = m_map.find(page); f != m_map.end())
-	{
-		// The PageMapping object returned contains the page, and more importantly, the file pointer (there can be
-		// multiple in newer caches) This is relevant for reading out the data in the rest of this file. The second item
-		// in this pair is created by taking the fileOffset (which will be a page but with the trailing bits (e.g.
-		// 0x12345000)
-		//      and will add the "extra" bits lopped off when determining the page. (e.g. 0x12345678 -> 0x678)
-		return {f->second, f->second.fileOffset + (address & (m_pageSize - 1))};
-	}
+	auto it = std::upper_bound(m_ranges.begin(), m_ranges.end(), address,
+		[](size_t address, const VMMappedRange& range) { return address < range.end; });
+	if (it == m_ranges.end() || it->start > address)
+		throw MappingReadException();
+	return *it;
+}
 
-	throw MappingReadException();
+std::pair<PageMapping, size_t> VM::MappingAtAddress(size_t address)
+{
+	// The PageMapping object returned contains the file pointer (there can be multiple in newer caches).
+	// This is relevant for reading out the data in the rest of this file.
+	// The second item in this pair is the file offset that `address` translates to.
+	auto& range = RangeAtAddress(address);
+	return {range.mapping, range.mapping.fileOffset + (address - range.start)};
 }
 
 
 bool VM::AddressIsMapped(uint64_t address)
 {
-	try
-	{
-		MappingAtAddress(address);
-		return true;
-	}
-	catch (...)
-	{}
-	return false;
+	auto it = std::upper_bound(m_ranges.begin(), m_ranges.end(), address,
+		[](uint64_t address, const VMMappedRange& range) { return address < range.end; });
+	return it != m_ranges.end() && it->start <= address;
 }
 
 
@@ -602,74 +750,116 @@ int64_t VMReader::ReadSLEB128(size_t limit)
 
 std::string VM::ReadNullTermString(size_t address)
 {
-	auto mapping = MappingAtAddress(address);
-	return mapping.first.fileAccessor->lock()->ReadNullTermString(mapping.second);
+	auto& range = RangeAtAddress(address);
+	return range.mapping.fileAccessor->lock()->ReadNullTermString(range.mapping.fileOffset + (address - range.start));
 }
 
 uint8_t VM::ReadUChar(size_t address)
 {
-	auto mapping = MappingAtAddress(address);
-	return mapping.first.fileAccessor->lock()->ReadUChar(mapping.second);
+	auto& range = RangeAtAddress(address);
+	return range.mapping.fileAccessor->lock()->ReadUChar(range.mapping.fileOffset + (address - range.start));
 }
 
 int8_t VM::ReadChar(size_t address)
 {
-	auto mapping = MappingAtAddress(address);
-	return mapping.first.fileAccessor->lock()->ReadChar(mapping.second);
+	auto& range = RangeAtAddress(address);
+	return range.mapping.fileAccessor->lock()->ReadChar(range.mapping.fileOffset + (address - range.start));
 }
 
 uint16_t VM::ReadUShort(size_t address)
 {
-	auto mapping = MappingAtAddress(address);
-	return mapping.first.fileAccessor->lock()->ReadUShort(mapping.second);
+	auto& range = RangeAtAddress(address);
+	return range.mapping.fileAccessor->lock()->ReadUShort(range.mapping.fileOffset + (address - range.start));
 }
 
 int16_t VM::ReadShort(size_t address)
 {
-	auto mapping = MappingAtAddress(address);
-	return mapping.first.fileAccessor->lock()->ReadShort(mapping.second);
+	auto& range = RangeAtAddress(address);
+	return range.mapping.fileAccessor->lock()->ReadShort(range.mapping.fileOffset + (address - range.start));
 }
 
 uint32_t VM::ReadUInt32(size_t address)
 {
-	auto mapping = MappingAtAddress(address);
-	return mapping.first.fileAccessor->lock()->ReadUInt32(mapping.second);
+	auto& range = RangeAtAddress(address);
+	return range.mapping.fileAccessor->lock()->ReadUInt32(range.mapping.fileOffset + (address - range.start));
 }
 
 int32_t VM::ReadInt32(size_t address)
 {
-	auto mapping = MappingAtAddress(address);
-	return mapping.first.fileAccessor->lock()->ReadInt32(mapping.second);
+	auto& range = RangeAtAddress(address);
+	return range.mapping.fileAccessor->lock()->ReadInt32(range.mapping.fileOffset + (address - range.start));
 }
 
 uint64_t VM::ReadULong(size_t address)
 {
-	auto mapping = MappingAtAddress(address);
-	return mapping.first.fileAccessor->lock()->ReadULong(mapping.second);
+	auto& range = RangeAtAddress(address);
+	return range.mapping.fileAccessor->lock()->ReadULong(range.mapping.fileOffset + (address - range.start));
 }
 
 int64_t VM::ReadLong(size_t address)
 {
-	auto mapping = MappingAtAddress(address);
-	return mapping.first.fileAccessor->lock()->ReadLong(mapping.second);
+	auto& range = RangeAtAddress(address);
+	return range.mapping.fileAccessor->lock()->ReadLong(range.mapping.fileOffset + (address - range.start));
 }
 
 BinaryNinja::DataBuffer VM::ReadBuffer(size_t addr, size_t length)
 {
-	auto mapping = MappingAtAddress(addr);
-	return mapping.first.fileAccessor->lock()->ReadBuffer(mapping.second, length);
+	auto& range = RangeAtAddress(addr);
+	return range.mapping.fileAccessor->lock()->ReadBuffer(range.mapping.fileOffset + (addr - range.start), length);
 }
 
 
 void VM::Read(void* dest, size_t addr, size_t length)
 {
-	auto mapping = MappingAtAddress(addr);
-	mapping.first.fileAccessor->lock()->Read(dest, mapping.second, length);
+	auto& range = RangeAtAddress(addr);
+	range.mapping.fileAccessor->lock()->Read(dest, range.mapping.fileOffset + (addr - range.start), length);
 }
 
 VMReader::VMReader(std::shared_ptr<VM> vm, size_t addressSize) : m_vm(vm), m_cursor(0), m_addressSize(addressSize) {}
 
 
+const uint8_t* VMReader::Resolve(size_t address, size_t length)
+{
+	if (!m_cachedBase || address < m_cachedStart || address + length > m_cachedEnd)
+	{
+		auto& range = m_vm->RangeAtAddress(address);
+		m_cachedAccessor = range.mapping.fileAccessor->lock();
+		size_t fileLength = m_cachedAccessor->Length();
+		if (range.mapping.fileOffset >= fileLength)
+		{
+			m_cachedBase = nullptr;
+			return nullptr;
+		}
+		m_cachedBase = (const uint8_t*)m_cachedAccessor->Data() + range.mapping.fileOffset;
+		m_cachedStart = range.start;
+		// Don't let a range claim bytes past the end of its backing file.
+		m_cachedEnd = std::min(range.end, range.start + (fileLength - range.mapping.fileOffset));
+		if (address + length > m_cachedEnd)
+			return nullptr;
+	}
+	return m_cachedBase + (address - m_cachedStart);
+}
+
+
+template <typename T>
+T VMReader::ReadAt(size_t address)
+{
+	T result;
+	if (auto data = Resolve(address, sizeof(T)))
+	{
+		memcpy(&result, data, sizeof(T));
+	}
+	else
+	{
+		// Straddles the end of a range; let the accessor handle (or reject) it
+		auto mapping = m_vm->MappingAtAddress(address);
+		mapping.first.fileAccessor->lock()->Read(&result, mapping.second, sizeof(T));
+	}
+	m_cursor = address + sizeof(T);
+	return result;
+}
+
+
 void VMReader::Seek(size_t address)
 {
 	m_cursor = address;
@@ -682,64 +872,47 @@ void VMReader::SeekRelative(size_t offset)
 
 std::string VMReader::ReadCString(size_t address)
 {
-	auto mapping = m_vm->MappingAtAddress(address);
-	return mapping.first.fileAccessor->lock()->ReadNullTermString(mapping.second);
+	return ReadStringView(address).str();
 }
 
 uint8_t VMReader::ReadUChar(size_t address)
 {
-	auto mapping = m_vm->MappingAtAddress(address);
-	m_cursor = address + 1;
-	return mapping.first.fileAccessor->lock()->ReadUChar(mapping.second);
+	return ReadAt<uint8_t>(address);
 }
 
 int8_t VMReader::ReadChar(size_t address)
 {
-	auto mapping = m_vm->MappingAtAddress(address);
-	m_cursor = address + 1;
-	return mapping.first.fileAccessor->lock()->ReadChar(mapping.second);
+	return ReadAt<int8_t>(address);
 }
 
 uint16_t VMReader::ReadUShort(size_t address)
 {
-	auto mapping = m_vm->MappingAtAddress(address);
-	m_cursor = address + 2;
-	return mapping.first.fileAccessor->lock()->ReadUShort(mapping.second);
+	return ReadAt<uint16_t>(address);
 }
 
 int16_t VMReader::ReadShort(size_t address)
 {
-	auto mapping = m_vm->MappingAtAddress(address);
-	m_cursor = address + 2;
-	return mapping.first.fileAccessor->lock()->ReadShort(mapping.second);
+	return ReadAt<int16_t>(address);
 }
 
 uint32_t VMReader::ReadUInt32(size_t address)
 {
-	auto mapping = m_vm->MappingAtAddress(address);
-	m_cursor = address + 4;
-	return mapping.first.fileAccessor->lock()->ReadUInt32(mapping.second);
+	return ReadAt<uint32_t>(address);
 }
 
 int32_t VMReader::ReadInt32(size_t address)
 {
-	auto mapping = m_vm->MappingAtAddress(address);
-	m_cursor = address + 4;
-	return mapping.first.fileAccessor->lock()->ReadInt32(mapping.second);
+	return ReadAt<int32_t>(address);
 }
 
 uint64_t VMReader::ReadULong(size_t address)
 {
-	auto mapping = m_vm->MappingAtAddress(address);
-	m_cursor = address + 8;
-	return mapping.first.fileAccessor->lock()->ReadULong(mapping.second);
+	return ReadAt<uint64_t>(address);
 }
 
 int64_t VMReader::ReadLong(size_t address)
 {
-	auto mapping = m_vm->MappingAtAddress(address);
-	m_cursor = address + 8;
-	return mapping.first.fileAccessor->lock()->ReadLong(mapping.second);
+	return ReadAt<int64_t>(address);
 }
 
 
@@ -767,27 +940,58 @@ size_t VMReader::ReadPointer()
 
 BinaryNinja::DataBuffer VMReader::ReadBuffer(size_t length)
 {
-	auto mapping = m_vm->MappingAtAddress(m_cursor);
-	m_cursor += length;
-	return mapping.first.fileAccessor->lock()->ReadBuffer(mapping.second, length);
+	return ReadBuffer(m_cursor, length);
 }
 
 BinaryNinja::DataBuffer VMReader::ReadBuffer(size_t addr, size_t length)
 {
+	if (auto data = Resolve(addr, length))
+	{
+		m_cursor = addr + length;
+		return BinaryNinja::DataBuffer(data, length);
+	}
 	auto mapping = m_vm->MappingAtAddress(addr);
 	m_cursor = addr + length;
 	return mapping.first.fileAccessor->lock()->ReadBuffer(mapping.second, length);
 }
 
+MappedSpan VMReader::ReadSpan(size_t addr, size_t length)
+{
+	if (auto data = Resolve(addr, length))
+	{
+		m_cursor = addr + length;
+		return MappedSpan(m_cachedAccessor, data, length);
+	}
+	auto mapping = m_vm->MappingAtAddress(addr);
+	m_cursor = addr + length;
+	return mapping.first.fileAccessor->lock()->ReadSpan(mapping.second, length);
+}
+
+MappedStringView VMReader::ReadStringView(size_t address)
+{
+	if (auto data = Resolve(address, 1))
+	{
+		auto terminator = (const uint8_t*)memchr(data, 0, m_cachedEnd - address);
+		if (terminator)
+			return MappedStringView(m_cachedAccessor, std::string_view((const char*)data, terminator - data));
+	}
+	auto mapping = m_vm->MappingAtAddress(address);
+	return mapping.first.fileAccessor->lock()->ReadStringView(mapping.second);
+}
+
 void VMReader::Read(void* dest, size_t length)
 {
-	auto mapping = m_vm->MappingAtAddress(m_cursor);
-	m_cursor += length;
-	mapping.first.fileAccessor->lock()->Read(dest, mapping.second, length);
+	Read(dest, m_cursor, length);
 }
 
 void VMReader::Read(void* dest, size_t addr, size_t length)
 {
+	if (auto data = Resolve(addr, length))
+	{
+		memcpy(dest, data, length);
+		m_cursor = addr + length;
+		return;
+	}
 	auto mapping = m_vm->MappingAtAddress(addr);
 	m_cursor = addr + length;
 	mapping.first.fileAccessor->lock()->Read(dest, mapping.second, length);
@@ -796,56 +1000,40 @@ void VMReader::Read(void* dest, size_t addr, size_t length)
 
 uint8_t VMReader::Read8()
 {
-	auto mapping = m_vm->MappingAtAddress(m_cursor);
-	m_cursor += 1;
-	return mapping.first.fileAccessor->lock()->ReadUChar(mapping.second);
+	return ReadAt<uint8_t>(m_cursor);
 }
 
 int8_t VMReader::ReadS8()
 {
-	auto mapping = m_vm->MappingAtAddress(m_cursor);
-	m_cursor += 1;
-	return mapping.first.fileAccessor->lock()->ReadChar(mapping.second);
+	return ReadAt<int8_t>(m_cursor);
 }
 
 uint16_t VMReader::Read16()
 {
-	auto mapping = m_vm->MappingAtAddress(m_cursor);
-	m_cursor += 2;
-	return mapping.first.fileAccessor->lock()->ReadUShort(mapping.second);
+	return ReadAt<uint16_t>(m_cursor);
 }
 
 int16_t VMReader::ReadS16()
 {
-	auto mapping = m_vm->MappingAtAddress(m_cursor);
-	m_cursor += 2;
-	return mapping.first.fileAccessor->lock()->ReadShort(mapping.second);
+	return ReadAt<int16_t>(m_cursor);
 }
 
 uint32_t VMReader::Read32()
 {
-	auto mapping = m_vm->MappingAtAddress(m_cursor);
-	m_cursor += 4;
-	return mapping.first.fileAccessor->lock()->ReadUInt32(mapping.second);
+	return ReadAt<uint32_t>(m_cursor);
 }
 
 int32_t VMReader::ReadS32()
 {
-	auto mapping = m_vm->MappingAtAddress(m_cursor);
-	m_cursor += 4;
-	return mapping.first.fileAccessor->lock()->ReadInt32(mapping.second);
+	return ReadAt<int32_t>(m_cursor);
 }
 
 uint64_t VMReader::Read64()
 {
-	auto mapping = m_vm->MappingAtAddress(m_cursor);
-	m_cursor += 8;
-	return mapping.first.fileAccessor->lock()->ReadULong(mapping.second);
+	return ReadAt<uint64_t>(m_cursor);
 }
 
 int64_t VMReader::ReadS64()
 {
-	auto mapping = m_vm->MappingAtAddress(m_cursor);
-	m_cursor += 8;
-	return mapping.first.fileAccessor->lock()->ReadLong(mapping.second);
+	return ReadAt<int64_t>(m_cursor);
 }
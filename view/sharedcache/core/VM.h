@@ -5,7 +5,10 @@
 #ifndef SHAREDCACHE_VM_H
 #define SHAREDCACHE_VM_H
 #include <binaryninjaapi.h>
+#include <atomic>
 #include <condition_variable>
+#include <cstring>
+#include <string_view>
 
 void VMShutdown();
 
@@ -18,7 +21,11 @@ public:
 	void release(int update = 1) {
 		std::unique_lock<std::mutex> lock(mutex_);
 		count_ += update;
-		cv_.notify_all();
+		// Only wake as many waiters as there are new slots
+		if (update == 1)
+			cv_.notify_one();
+		else
+			cv_.notify_all();
 	}
 
 	void acquire() {
@@ -52,27 +59,35 @@ private:
 template <typename T>
 class SelfAllocatingWeakPtr {
 public:
-	SelfAllocatingWeakPtr(std::function<std::shared_ptr<T>()> allocator, std::function<void(std::shared_ptr<T>)> postAlloc)
-		: allocator(allocator), postAlloc(postAlloc) {}
+	SelfAllocatingWeakPtr(std::function<std::shared_ptr<T>()> allocator, std::function<void(std::shared_ptr<T>)> postAlloc,
+		std::function<void(T*)> onAccess = nullptr)
+		: allocator(allocator), postAlloc(postAlloc), onAccess(onAccess) {}
 
 	std::shared_ptr<T> lock() {
+		// Serialize (re)allocation so concurrent readers never map the same file twice
+		std::unique_lock<std::mutex> lock(allocationMutex);
 		std::shared_ptr<T> sharedPtr = weakPtr.lock();
 		if (!sharedPtr) {
 			sharedPtr = allocator();
 			postAlloc(sharedPtr);
 			weakPtr = sharedPtr;
 		}
+		if (onAccess)
+			onAccess(sharedPtr.get());
 		return sharedPtr;
 	}
 
 	std::shared_ptr<T> lock_no_allocate() {
+		std::unique_lock<std::mutex> lock(allocationMutex);
 		return weakPtr.lock();
 	}
 
 private:
+	std::mutex allocationMutex;
 	std::weak_ptr<T> weakPtr;                       // Weak reference to the object
 	std::function<std::shared_ptr<T>()> allocator;  // Function to recreate the object
 	std::function<void(std::shared_ptr<T>)> postAlloc;  // Function to call after the object is allocated
+	std::function<void(T*)> onAccess;               // Function to call every time the object is handed out
 };
 
 
@@ -86,6 +101,57 @@ class MissingFileException : public std::exception
 
 class MMappedFileAccessor;
 
+/**
+ * A read-only view of bytes inside a memory mapped file.
+ *
+ * The view holds a reference to the accessor it was read from, so the mapping stays valid for as long as the view does.
+ */
+class MappedSpan {
+	std::shared_ptr<MMappedFileAccessor> m_owner;
+	const uint8_t* m_data = nullptr;
+	size_t m_length = 0;
+
+public:
+	MappedSpan() = default;
+	MappedSpan(std::shared_ptr<MMappedFileAccessor> owner, const uint8_t* data, size_t length)
+		: m_owner(std::move(owner)), m_data(data), m_length(length) {}
+
+	const uint8_t* data() const { return m_data; }
+	size_t size() const { return m_length; }
+	bool empty() const { return m_length == 0; }
+	uint8_t operator[](size_t offset) const { return m_data[offset]; }
+
+	template <typename T>
+	T Read(size_t offset) const
+	{
+		if (offset + sizeof(T) > m_length)
+			throw std::out_of_range("MappedSpan read out of bounds");
+		T result;
+		memcpy(&result, m_data + offset, sizeof(T));
+		return result;
+	}
+};
+
+/**
+ * A null terminated string inside a memory mapped file, viewed in place.
+ *
+ * Like MappedSpan, this keeps the backing mapping alive. The view does not include the terminator.
+ */
+class MappedStringView {
+	std::shared_ptr<MMappedFileAccessor> m_owner;
+	std::string_view m_view;
+
+public:
+	MappedStringView() = default;
+	MappedStringView(std::shared_ptr<MMappedFileAccessor> owner, std::string_view view)
+		: m_owner(std::move(owner)), m_view(view) {}
+
+	std::string_view view() const { return m_view; }
+	std::string str() const { return std::string(m_view); }
+	size_t size() const { return m_view.size(); }
+	bool empty() const { return m_view.empty(); }
+};
+
 class MMAP {
 	friend MMappedFileAccessor;
 
@@ -104,20 +170,26 @@ class MMAP {
     void Unmap();
 };
 
-static uint64_t maxFPLimit;
-static std::mutex fileAccessorDequeMutex;
-static std::unordered_map<uint64_t, std::deque<std::shared_ptr<MMappedFileAccessor>>> fileAccessorReferenceHolder;
-static std::set<uint64_t> blockedSessionIDs;
-static std::mutex fileAccessorsMutex;
-static std::unordered_map<std::string, std::shared_ptr<SelfAllocatingWeakPtr<MMappedFileAccessor>>> fileAccessors;
-static counting_semaphore fileAccessorSemaphore(0);
+extern std::atomic<uint64_t> mmapCount;
 
-static std::atomic<uint64_t> mmapCount = 0;
+/**
+ * Counters for the file accessor cache, see MMappedFileAccessor::GetCacheStats
+ */
+struct FileAccessorCacheStats {
+	uint64_t hits;       // Open() found an existing accessor for the path
+	uint64_t misses;     // Open() had to create a new accessor
+	uint64_t evictions;  // mappings released early to stay under the file pointer limit
+	uint64_t remaps;     // files mapped again after their previous mapping was released
+};
 
-class MMappedFileAccessor {
+class MMappedFileAccessor : public std::enable_shared_from_this<MMappedFileAccessor> {
     std::string m_path;
     MMAP m_mmap;
 	bool m_slideInfoWasApplied = false;
+	// Whether this mapping took a slot from the file pointer budget, and so has to give it back
+	std::atomic<bool> m_holdsFileSlot = false;
+	// Access clock value at the last time this was handed out, for LRU eviction
+	std::atomic<uint64_t> m_lastAccess = 0;
 
 public:
 	MMappedFileAccessor(const std::string &path);
@@ -129,30 +201,26 @@ public:
 
 	static void InitialVMSetup();
 
+	static FileAccessorCacheStats GetCacheStats();
+
     std::string Path() const { return m_path; };
 
     size_t Length() const { return m_mmap.len; };
 
+	/**
+	 * The mapping is a private copy-on-write mapping of the file. Writing to it is only done to apply slide info, which
+	 * happens once per mapping before it is handed out, and should probably not be used for anything else.
+	 */
     void *Data() const { return m_mmap._mmap; };
 
 	bool SlideInfoWasApplied() const { return m_slideInfoWasApplied; }
 
 	void SetSlideInfoWasApplied(bool slideInfoWasApplied) { m_slideInfoWasApplied = slideInfoWasApplied; }
 
-	/**
-	 * Writes to files are implemented for performance reasons and should be treated with utmost care
-	 *
-	 * They _MAY_ disappear as _soon_ as you release the lock on the this file.
-	 * They may also NOT disappear for the lifetime of the application.
-	 *
-	 * The former is more likely to occur when concurrent DSC processing is happening. The latter is the typical scenario.
-	 *
-	 * This is used explicitly for slide information in a locked scope and _NOTHING_ else. It should probably not be used for anything else.
-	 *
-	 * \param address
-	 * \param pointer
-	 */
-	void WritePointer(size_t address, size_t pointer);
+	uint64_t LastAccess() const { return m_lastAccess.load(std::memory_order_relaxed); }
+
+	// Hands this mapping's file pointer budget slot over to the caller, returns false if it didn't hold one
+	bool TakeFileSlot() { return m_holdsFileSlot.exchange(false); }
 
     std::string ReadNullTermString(size_t address);
 
@@ -174,6 +242,18 @@ public:
 
     BinaryNinja::DataBuffer ReadBuffer(size_t addr, size_t length);
 
+	/**
+	 * Get a view of `length` bytes at `addr` without copying them out of the mapping.
+	 *
+	 * Only valid on accessors owned by a shared_ptr (i.e. those handed out by Open).
+	 */
+	MappedSpan ReadSpan(size_t addr, size_t length);
+
+	/**
+	 * Get a view of the null terminated string at `address` without copying it out of the mapping.
+	 */
+	MappedStringView ReadStringView(size_t address);
+
     void Read(void *dest, size_t addr, size_t length);
 };
 
@@ -187,6 +267,20 @@ struct PageMapping {
 };
 
 
+/**
+ * A contiguous run of VM address space backed by a single file.
+ *
+ * `mapping.fileOffset` is the file offset corresponding to `start`.
+ */
+struct VMMappedRange {
+	size_t start;
+	size_t end;
+	PageMapping mapping;
+	VMMappedRange(size_t start, size_t end, PageMapping mapping)
+		: start(start), end(end), mapping(std::move(mapping)) {}
+};
+
+
 class VMException : public std::exception {
     virtual const char *what() const throw() {
         return "Generic VM Exception";
@@ -215,7 +309,8 @@ class VMReader;
 
 
 class VM {
-    std::map<size_t, PageMapping> m_map;
+    // Sorted by start address, never overlapping.
+    std::vector<VMMappedRange> m_ranges;
     size_t m_pageSize;
     size_t m_pageSizeBits;
     bool m_safe;
@@ -234,6 +329,13 @@ public:
 
     std::pair<PageMapping, size_t> MappingAtAddress(size_t address);
 
+    /**
+     * Find the mapped range containing `address`.
+     *
+     * \throws MappingReadException if the address is not mapped
+     */
+    const VMMappedRange& RangeAtAddress(size_t address) const;
+
     std::string ReadNullTermString(size_t address);
 
     uint8_t ReadUChar(size_t address);
@@ -265,6 +367,18 @@ class VMReader {
 
 	BNEndianness m_endianness = LittleEndian;
 
+	// The range the last read resolved to, so sequential reads within a mapping are a pointer bump.
+	// Holding the accessor keeps the file mapped for as long as this reader is looking at it.
+	std::shared_ptr<MMappedFileAccessor> m_cachedAccessor;
+	const uint8_t* m_cachedBase = nullptr;
+	size_t m_cachedStart = 0;
+	size_t m_cachedEnd = 0;
+
+	const uint8_t* Resolve(size_t address, size_t length);
+
+	template <typename T>
+	T ReadAt(size_t address);
+
 public:
     VMReader(std::shared_ptr<VM> vm, size_t addressSize = 8);
 
@@ -324,6 +438,10 @@ public:
 
     BinaryNinja::DataBuffer ReadBuffer(size_t addr, size_t length);
 
+    MappedSpan ReadSpan(size_t addr, size_t length);
+
+    MappedStringView ReadStringView(size_t address);
+
     void Read(void *dest, size_t length);
 
     void Read(void *dest, size_t addr, size_t length);
@@ -1,7 +1,9 @@
 #include "binaryninjaapi.h"
 #include "json/json.h"
 #include "rapidjsonwrapper.h"
+#include <charconv>
 #include <string>
+#include <string_view>
 #include <variant>
 
 using namespace BinaryNinja;
@@ -13,7 +15,6 @@ AnalysisContext::AnalysisContext(BNAnalysisContext* analysisContext) :
 {
 	// LogError("API-Side AnalysisContext Constructed!");
 	m_object = analysisContext;
-	m_builder["indentation"] = "";
 }
 
 
@@ -110,6 +111,71 @@ bool AnalysisContext::Inform(const string& request)
 }
 
 
+static void AppendInformString(string& request, string_view value)
+{
+	static const char hexDigits[] = "0123456789abcdef";
+	request += '"';
+	for (char c : value)
+	{
+		switch (c)
+		{
+		case '"':
+			request += "\\\"";
+			break;
+		case '\\':
+			request += "\\\\";
+			break;
+		case '\n':
+			request += "\\n";
+			break;
+		case '\r':
+			request += "\\r";
+			break;
+		case '\t':
+			request += "\\t";
+			break;
+		default:
+			if ((unsigned char)c < 0x20)
+			{
+				request += "\\u00";
+				request += hexDigits[(c >> 4) & 0xf];
+				request += hexDigits[c & 0xf];
+			}
+			else
+			{
+				request += c;
+			}
+			break;
+		}
+	}
+	request += '"';
+}
+
+
+bool AnalysisContext::Inform(const InformArgument* args, size_t count)
+{
+	// Same encoding as the Json::Value based requests, without the intermediate document
+	thread_local string request;
+	request.clear();
+	request += '[';
+	for (size_t i = 0; i < count; i++)
+	{
+		if (i != 0)
+			request += ',';
+		visit(overload {[&](string_view value) { AppendInformString(request, value); },
+		          [&](uint64_t value) {
+			          char buf[24];
+			          auto result = to_chars(buf, buf + sizeof(buf), value);
+			          request.append(buf, result.ptr);
+		          },
+		          [&](const Ref<Architecture>& arch) { AppendInformString(request, arch->GetName()); }},
+		    args[i]);
+	}
+	request += ']';
+	return BNAnalysisContextInform(m_object, request.c_str());
+}
+
+
 WorkflowMachine::WorkflowMachine(Ref<BinaryView> view): m_view(view)
 {
 